@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+#include <bit_vector.hpp>
+#include <vector.hpp>
+
+namespace {
+    template<typename Bits>
+    auto random_bits(long long size, unsigned seed) {
+        std::mt19937 generator(seed);
+        Bits bits;
+        bits.reserve(static_cast<types::size_t>(size));
+        for (long long i = 0; i < size; i++) {
+            bits.push_back(generator() % 2 == 0);
+        }
+        return bits;
+    }
+
+    auto count(const ds::BitVector &bits) {
+        return bits.count();
+    }
+
+    auto count(const ds::Vector<bool> &bits) {
+        return std::count(bits.begin(), bits.end(), true);
+    }
+
+    template<typename Bits>
+    void BM_Count(benchmark::State &state) {
+        const auto bits = random_bits<Bits>(state.range(0), 1);
+        for (auto _: state) {
+            benchmark::DoNotOptimize(count(bits));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_And(benchmark::State &state) {
+        auto lhs = random_bits<ds::BitVector>(state.range(0), 1);
+        const auto rhs = random_bits<ds::BitVector>(state.range(0), 2);
+        for (auto _: state) {
+            lhs &= rhs;
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_AndBool(benchmark::State &state) {
+        auto lhs = random_bits<ds::Vector<bool>>(state.range(0), 1);
+        const auto rhs = random_bits<ds::Vector<bool>>(state.range(0), 2);
+        for (auto _: state) {
+            for (types::size_t i = 0; i < lhs.size(); i++) {
+                lhs[i] = lhs[i] and rhs[i];
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Random positions, so that every query misses the cache on large vectors
+    void BM_Rank(benchmark::State &state) {
+        const auto bits = random_bits<ds::BitVector>(state.range(0), 1);
+        const ds::RankSelect rank_select(bits);
+        std::mt19937_64 generator(2);
+        for (auto _: state) {
+            benchmark::DoNotOptimize(rank_select.rank(generator() % bits.size()));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_Select(benchmark::State &state) {
+        const auto bits = random_bits<ds::BitVector>(state.range(0), 1);
+        const ds::RankSelect rank_select(bits);
+        std::mt19937_64 generator(2);
+        for (auto _: state) {
+            benchmark::DoNotOptimize(rank_select.select(generator() % rank_select.ones()));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+} // namespace
+
+BENCHMARK(BM_Count<ds::BitVector>)->RangeMultiplier(64)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_Count<ds::Vector<bool>>)->RangeMultiplier(64)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_And)->RangeMultiplier(64)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_AndBool)->RangeMultiplier(64)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_Rank)->RangeMultiplier(64)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_Select)->RangeMultiplier(64)->Range(1 << 12, 1 << 24);
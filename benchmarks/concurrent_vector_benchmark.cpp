@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+
+#include <concurrent_vector.hpp>
+#include <vector.hpp>
+
+namespace {
+    constexpr int MAX_THREADS = 32;
+
+    ds::ConcurrentVector<int> concurrent_vector; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    ds::Vector<int> locked_vector;               // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    std::mutex locked_vector_mutex;              // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    void BM_ConcurrentVectorPushBack(benchmark::State &state) {
+        if (state.thread_index() == 0) {
+            concurrent_vector.clear();
+        }
+
+        int value = 0;
+        for (auto _: state) {
+            concurrent_vector.push_back(value++);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_MutexVectorPushBack(benchmark::State &state) {
+        if (state.thread_index() == 0) {
+            locked_vector.clear();
+        }
+
+        int value = 0;
+        for (auto _: state) {
+            const std::lock_guard lock(locked_vector_mutex);
+            locked_vector.push_back(value++);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+} // namespace
+
+BENCHMARK(BM_ConcurrentVectorPushBack)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(BM_MutexVectorPushBack)->ThreadRange(1, MAX_THREADS)->UseRealTime();
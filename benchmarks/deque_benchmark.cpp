@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+
+#include <deque>
+
+#include <deque.hpp>
+
+namespace {
+    template<typename Deque>
+    void BM_SlidingWindow(benchmark::State &state) {
+        const auto window = state.range(0);
+        Deque events;
+        for (long long i = 0; i < window; i++) {
+            events.push_back(i);
+        }
+
+        long long next = window;
+        for (auto _: state) {
+            events.pop_front();
+            events.push_back(next++);
+            benchmark::DoNotOptimize(events.back());
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    template<typename Deque>
+    void BM_PushFront(benchmark::State &state) {
+        for (auto _: state) {
+            Deque events;
+            for (long long i = 0; i < state.range(0); i++) {
+                events.push_front(i);
+            }
+            benchmark::DoNotOptimize(events.front());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+} // namespace
+
+BENCHMARK(BM_SlidingWindow<ds::Deque<long long>>)->RangeMultiplier(100)->Range(100, 1'000'000);
+BENCHMARK(BM_SlidingWindow<std::deque<long long>>)->RangeMultiplier(100)->Range(100, 1'000'000);
+BENCHMARK(BM_PushFront<ds::Deque<long long>>)->RangeMultiplier(100)->Range(100, 1'000'000);
+BENCHMARK(BM_PushFront<std::deque<long long>>)->RangeMultiplier(100)->Range(100, 1'000'000);
@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <unordered_map>
+
+#include <flat_hash_map.hpp>
+#include <vector.hpp>
+
+namespace {
+    auto random_keys(long long count, unsigned seed) {
+        std::mt19937_64 generator(seed);
+        ds::Vector<unsigned long long> keys;
+        keys.reserve(static_cast<types::size_t>(count));
+        for (long long i = 0; i < count; i++) {
+            keys.push_back(generator());
+        }
+        return keys;
+    }
+
+    template<typename Map>
+    void BM_Insert(benchmark::State &state) {
+        const auto keys = random_keys(state.range(0), 1);
+        for (auto _: state) {
+            Map map;
+            for (const auto key: keys) {
+                map[key] = key;
+            }
+            benchmark::DoNotOptimize(map.size());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Half of the lookups hit, half miss
+    template<typename Map>
+    void BM_Lookup(benchmark::State &state) {
+        const auto keys = random_keys(state.range(0), 1);
+        const auto misses = random_keys(state.range(0), 2);
+        Map map;
+        map.reserve(keys.size());
+        for (const auto key: keys) {
+            map[key] = key;
+        }
+
+        types::size_t index = 0;
+        for (auto _: state) {
+            benchmark::DoNotOptimize(map.find(keys[index]));
+            benchmark::DoNotOptimize(map.find(misses[index]));
+            index = index + 1 == keys.size() ? 0 : index + 1;
+        }
+        state.SetItemsProcessed(state.iterations() * 2);
+    }
+} // namespace
+
+BENCHMARK(BM_Insert<ds::FlatHashMap<unsigned long long, unsigned long long>>)->RangeMultiplier(100)->Range(1'000, 10'000'000);
+BENCHMARK(BM_Insert<std::unordered_map<unsigned long long, unsigned long long>>)->RangeMultiplier(100)->Range(1'000, 10'000'000);
+BENCHMARK(BM_Lookup<ds::FlatHashMap<unsigned long long, unsigned long long>>)->RangeMultiplier(100)->Range(1'000, 10'000'000);
+BENCHMARK(BM_Lookup<std::unordered_map<unsigned long long, unsigned long long>>)->RangeMultiplier(100)->Range(1'000, 10'000'000);
@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <random>
+#include <type_traits>
+
+#include <flat_map.hpp>
+#include <vector.hpp>
+
+namespace {
+    using Key = unsigned;
+
+    auto random_keys(long long count, unsigned seed) {
+        std::mt19937 generator(seed);
+        ds::Vector<Key> keys;
+        keys.reserve(static_cast<types::size_t>(count));
+        for (long long i = 0; i < count; i++) {
+            keys.push_back(generator());
+        }
+        return keys;
+    }
+
+    template<typename Map>
+    auto build(const ds::Vector<Key> &keys) {
+        if constexpr (std::is_same_v<Map, std::map<Key, Key>>) {
+            Map map;
+            for (const auto key: keys) {
+                map.emplace(key, key);
+            }
+            return map;
+        } else {
+            return Map(keys, keys);
+        }
+    }
+
+    // Lookups in a random order, so that only the top of the search structure stays in cache
+    template<typename Map>
+    void BM_Lookup(benchmark::State &state) {
+        const auto keys = random_keys(state.range(0), 1);
+        const auto probes = random_keys(state.range(0), 2);
+        const auto map = build<Map>(keys);
+
+        types::size_t index = 0;
+        for (auto _: state) {
+            benchmark::DoNotOptimize(map.find(keys[index]));
+            benchmark::DoNotOptimize(map.find(probes[index]));
+            index = index + 1 == keys.size() ? 0 : index + 1;
+        }
+        state.SetItemsProcessed(state.iterations() * 2);
+    }
+
+    template<typename Map>
+    void BM_Build(benchmark::State &state) {
+        const auto keys = random_keys(state.range(0), 1);
+        for (auto _: state) {
+            benchmark::DoNotOptimize(build<Map>(keys).size());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+} // namespace
+
+using SortedMap = ds::FlatMap<Key, Key>;
+using EytzingerMap = ds::FlatMap<Key, Key, std::less<Key>, ds::SearchLayout::eytzinger>;
+
+BENCHMARK(BM_Build<SortedMap>)->RangeMultiplier(100)->Range(1'000, 10'000'000);
+BENCHMARK(BM_Build<std::map<Key, Key>>)->RangeMultiplier(100)->Range(1'000, 10'000'000);
+BENCHMARK(BM_Lookup<SortedMap>)->RangeMultiplier(100)->Range(1'000, 10'000'000);
+BENCHMARK(BM_Lookup<EytzingerMap>)->RangeMultiplier(100)->Range(1'000, 10'000'000);
+BENCHMARK(BM_Lookup<std::map<Key, Key>>)->RangeMultiplier(100)->Range(1'000, 10'000'000);
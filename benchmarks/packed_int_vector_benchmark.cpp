@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+#include <packed_int_vector.hpp>
+#include <vector.hpp>
+
+namespace {
+    constexpr long long VALUES = 1 << 24;
+    // Decoded a chunk at a time, as a scan would, so that the output stays in cache
+    constexpr types::size_t CHUNK = 1 << 12;
+
+    template<typename Packed>
+    auto random_packed(Packed packed) {
+        std::mt19937 generator(1);
+        for (long long i = 0; i < VALUES; i++) {
+            packed.push_back(static_cast<std::uint32_t>(generator()) & packed.max_value());
+        }
+        return packed;
+    }
+
+    template<typename Packed>
+    void scan(benchmark::State &state, const Packed &packed) {
+        ds::Vector<std::uint32_t> out;
+        out.resize_for_overwrite(CHUNK);
+        for (auto _: state) {
+            for (types::size_t first = 0; first < packed.size(); first += CHUNK) {
+                packed.decode(std::span(out.data(), CHUNK), first);
+                benchmark::DoNotOptimize(out.data());
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * VALUES);
+        state.SetBytesProcessed(state.iterations() * static_cast<long long>(packed.words().size_bytes()));
+    }
+
+    void BM_DecodeDynamicWidth(benchmark::State &state) {
+        scan(state, random_packed(ds::PackedIntVector<std::uint32_t>(static_cast<unsigned>(state.range(0)))));
+    }
+
+    void BM_DecodeStaticWidth11(benchmark::State &state) {
+        scan(state, random_packed(ds::PackedIntVector<std::uint32_t, 11>()));
+    }
+
+    void BM_ElementAccess(benchmark::State &state) {
+        const auto packed = random_packed(ds::PackedIntVector<std::uint32_t>(static_cast<unsigned>(state.range(0))));
+        for (auto _: state) {
+            std::uint32_t sum = 0;
+            for (types::size_t i = 0; i < packed.size(); i++) {
+                sum += packed[i];
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * VALUES);
+    }
+
+    // Baseline: the same scan over unpacked values
+    void BM_CopyUnpacked(benchmark::State &state) {
+        ds::Vector<std::uint32_t> values(VALUES, 1);
+        ds::Vector<std::uint32_t> out;
+        out.resize_for_overwrite(CHUNK);
+        for (auto _: state) {
+            for (types::size_t first = 0; first < values.size(); first += CHUNK) {
+                std::memcpy(out.data(), values.data() + first, CHUNK * sizeof(std::uint32_t)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                benchmark::DoNotOptimize(out.data());
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * VALUES);
+        state.SetBytesProcessed(state.iterations() * VALUES * static_cast<long long>(sizeof(std::uint32_t)));
+    }
+} // namespace
+
+BENCHMARK(BM_DecodeDynamicWidth)->Arg(5)->Arg(11)->Arg(17);
+BENCHMARK(BM_DecodeStaticWidth11);
+BENCHMARK(BM_ElementAccess)->Arg(5)->Arg(11)->Arg(17);
+BENCHMARK(BM_CopyUnpacked);
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+
+#include <parallel.hpp>
+#include <vector.hpp>
+
+namespace {
+    void BM_SequentialFill(benchmark::State &state) {
+        const auto size = state.range(0);
+        for (auto _: state) {
+            ds::Vector<int> v;
+            v.resize_for_overwrite(size);
+            std::fill(v.begin(), v.end(), 1);
+            benchmark::DoNotOptimize(v.data());
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    // Pages are first touched by the workers that fill them
+    void BM_ParallelFill(benchmark::State &state) {
+        const auto size = state.range(0);
+        for (auto _: state) {
+            ds::Vector<int> v;
+            v.resize_for_overwrite(size);
+            ds::parallel_fill(v, 1);
+            benchmark::DoNotOptimize(v.data());
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    void BM_SequentialReduce(benchmark::State &state) {
+        const ds::Vector<long long> v(state.range(0), 1);
+        for (auto _: state) {
+            benchmark::DoNotOptimize(std::accumulate(v.cbegin(), v.cend(), 0LL));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_ParallelReduce(benchmark::State &state) {
+        const ds::Vector<long long> v(state.range(0), 1);
+        for (auto _: state) {
+            benchmark::DoNotOptimize(ds::parallel_reduce(v, 0LL));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_SequentialSort(benchmark::State &state) {
+        ds::Vector<int> v(state.range(0));
+        for (auto _: state) {
+            state.PauseTiming();
+            std::iota(v.begin(), v.end(), 0);
+            std::reverse(v.begin(), v.end());
+            state.ResumeTiming();
+            std::sort(v.begin(), v.end());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_ParallelSort(benchmark::State &state) {
+        ds::Vector<int> v(state.range(0));
+        for (auto _: state) {
+            state.PauseTiming();
+            std::iota(v.begin(), v.end(), 0);
+            std::reverse(v.begin(), v.end());
+            state.ResumeTiming();
+            ds::parallel_sort(v);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+} // namespace
+
+BENCHMARK(BM_SequentialFill)->RangeMultiplier(100)->Range(10'000, 100'000'000)->UseRealTime();
+BENCHMARK(BM_ParallelFill)->RangeMultiplier(100)->Range(10'000, 100'000'000)->UseRealTime();
+BENCHMARK(BM_SequentialReduce)->RangeMultiplier(100)->Range(10'000, 100'000'000)->UseRealTime();
+BENCHMARK(BM_ParallelReduce)->RangeMultiplier(100)->Range(10'000, 100'000'000)->UseRealTime();
+BENCHMARK(BM_SequentialSort)->RangeMultiplier(100)->Range(10'000, 10'000'000)->UseRealTime();
+BENCHMARK(BM_ParallelSort)->RangeMultiplier(100)->Range(10'000, 10'000'000)->UseRealTime();
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+
+#include <persistent_vector.hpp>
+#include <vector.hpp>
+
+namespace {
+    auto iota_vector(long long size) {
+        ds::Vector<int> values(static_cast<types::size_t>(size));
+        std::iota(values.begin(), values.end(), 0);
+        return values;
+    }
+
+    // What a reader pays for a consistent view of the data
+    template<typename Container>
+    void BM_Snapshot(benchmark::State &state) {
+        const Container values(iota_vector(state.range(0)));
+        for (auto _: state) {
+            Container snapshot(values);
+            benchmark::DoNotOptimize(snapshot);
+        }
+    }
+
+    void BM_PushBackVersions(benchmark::State &state) {
+        for (auto _: state) {
+            ds::PersistentVector<int> v;
+            for (int i = 0; i < state.range(0); i++) {
+                v = v.push_back(i);
+            }
+            benchmark::DoNotOptimize(v);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_PushBackTransient(benchmark::State &state) {
+        for (auto _: state) {
+            auto transient = ds::PersistentVector<int>().transient();
+            for (int i = 0; i < state.range(0); i++) {
+                transient.push_back(i);
+            }
+            benchmark::DoNotOptimize(std::move(transient).persistent());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_PushBackVector(benchmark::State &state) {
+        for (auto _: state) {
+            ds::Vector<int> v;
+            for (int i = 0; i < state.range(0); i++) {
+                v.push_back(i);
+            }
+            benchmark::DoNotOptimize(v);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template<typename Container>
+    void BM_Iterate(benchmark::State &state) {
+        const Container values(iota_vector(state.range(0)));
+        for (auto _: state) {
+            benchmark::DoNotOptimize(std::accumulate(values.begin(), values.end(), 0LL));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+} // namespace
+
+BENCHMARK(BM_Snapshot<ds::Vector<int>>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Snapshot<ds::PersistentVector<int>>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PushBackVersions)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PushBackTransient)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PushBackVector)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Iterate<ds::PersistentVector<int>>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
@@ -0,0 +1,147 @@
+#include <benchmark/benchmark.h>
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+
+#include <ring_buffer.hpp>
+#include <vector.hpp>
+
+namespace {
+    constexpr long long MESSAGES_PER_ITERATION = 1 << 20;
+    constexpr long long BATCH = 64;
+    constexpr types::size_t RING_CAPACITY = 4096;
+
+    // Pins the calling thread to cpu, when the machine has it
+    void pin_to_cpu(unsigned cpu) {
+        if (cpu >= std::thread::hardware_concurrency()) {
+            return;
+        }
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+
+    // Moves MESSAGES_PER_ITERATION messages from a producer thread to the benchmark thread. push(first, count)
+    // and pop(sum) return how many messages they moved.
+    template<typename Push, typename Pop>
+    void run_pipeline(benchmark::State &state, Push push, Pop pop) {
+        pin_to_cpu(0);
+        for (auto _: state) {
+            std::thread producer([&push] {
+                pin_to_cpu(1);
+                for (long long sent = 0; sent < MESSAGES_PER_ITERATION;) {
+                    const auto pushed = push(sent, std::min(BATCH, MESSAGES_PER_ITERATION - sent));
+                    if (pushed == 0) {
+                        std::this_thread::yield();
+                    }
+                    sent += pushed;
+                }
+            });
+
+            long long sum = 0;
+            for (long long received = 0; received < MESSAGES_PER_ITERATION;) {
+                const auto popped = pop(sum);
+                if (popped == 0) {
+                    // Lets the producer run when both threads share a core
+                    std::this_thread::yield();
+                }
+                received += popped;
+            }
+            producer.join();
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * MESSAGES_PER_ITERATION);
+    }
+
+    template<typename Ring>
+    void BM_RingSingle(benchmark::State &state, Ring &ring) {
+        run_pipeline(
+                state,
+                [&ring](long long first, long long) { return ring.try_push(first) ? 1LL : 0LL; },
+                [&ring](long long &sum) {
+                    const auto value = ring.try_pop();
+                    sum += value.value_or(0);
+                    return value ? 1LL : 0LL;
+                });
+    }
+
+    template<typename Ring>
+    void BM_RingBatched(benchmark::State &state, Ring &ring) {
+        run_pipeline(
+                state,
+                [&ring](long long first, long long count) {
+                    std::array<long long, BATCH> batch{};
+                    std::fill(batch.begin(), batch.end(), first);
+                    return static_cast<long long>(ring.push(std::span<const long long>(batch).first(static_cast<std::size_t>(count))));
+                },
+                [&ring](long long &sum) {
+                    std::array<long long, BATCH> batch{};
+                    const auto count = ring.pop(batch);
+                    for (std::size_t i = 0; i < count; i++) {
+                        sum += batch[i]; // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+                    }
+                    return static_cast<long long>(count);
+                });
+    }
+
+    void BM_SpscRing(benchmark::State &state) {
+        auto ring = std::make_unique<ds::SpscRing<long long, RING_CAPACITY>>();
+        BM_RingSingle(state, *ring);
+    }
+
+    void BM_SpscRingBatched(benchmark::State &state) {
+        auto ring = std::make_unique<ds::SpscRing<long long, RING_CAPACITY>>();
+        BM_RingBatched(state, *ring);
+    }
+
+    void BM_MpmcRing(benchmark::State &state) {
+        ds::MpmcRing<long long> ring(RING_CAPACITY);
+        BM_RingSingle(state, ring);
+    }
+
+    void BM_MpmcRingBatched(benchmark::State &state) {
+        ds::MpmcRing<long long> ring(RING_CAPACITY);
+        BM_RingBatched(state, ring);
+    }
+
+    // The hand-off the rings replace: batches appended to and drained from a mutex-protected Vector
+    void BM_MutexVectorBatched(benchmark::State &state) {
+        std::mutex mutex;
+        ds::Vector<long long> pending;
+        ds::Vector<long long> drained;
+        run_pipeline(
+                state,
+                [&](long long first, long long count) {
+                    const std::lock_guard lock(mutex);
+                    for (long long i = 0; i < count; i++) {
+                        pending.push_back(first + i);
+                    }
+                    return count;
+                },
+                [&](long long &sum) {
+                    {
+                        const std::lock_guard lock(mutex);
+                        drained.assign(pending.cbegin(), pending.cend());
+                        pending.clear();
+                    }
+                    for (const auto value: drained) {
+                        sum += value;
+                    }
+                    return static_cast<long long>(drained.size());
+                });
+    }
+} // namespace
+
+BENCHMARK(BM_SpscRing)->UseRealTime();
+BENCHMARK(BM_SpscRingBatched)->UseRealTime();
+BENCHMARK(BM_MpmcRing)->UseRealTime();
+BENCHMARK(BM_MpmcRingBatched)->UseRealTime();
+BENCHMARK(BM_MutexVectorBatched)->UseRealTime();
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <filesystem>
+
+#include <serialization.hpp>
+#include <vector.hpp>
+
+namespace {
+    class TemporaryFile {
+    public:
+        TemporaryFile() : _path(std::filesystem::temp_directory_path() / "ds_serialization_benchmark") {
+            _fd = ::open(_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644); // NOLINT(cppcoreguidelines-pro-type-vararg)
+        }
+
+        TemporaryFile(const TemporaryFile &) = delete;
+
+        TemporaryFile(TemporaryFile &&) = delete;
+
+        ~TemporaryFile() {
+            ::close(_fd);
+            std::filesystem::remove(_path);
+        }
+
+        auto operator=(const TemporaryFile &) -> TemporaryFile & = delete;
+
+        auto operator=(TemporaryFile &&) -> TemporaryFile & = delete;
+
+        [[nodiscard]] auto fd() const {
+            return _fd;
+        }
+
+        void rewind() const {
+            ::lseek(_fd, 0, SEEK_SET);
+        }
+
+    private:
+        std::filesystem::path _path;
+        int _fd;
+    };
+
+    auto make_values(long long count) {
+        ds::Vector<std::uint64_t> values;
+        for (long long i = 0; i < count; i++) {
+            values.push_back(static_cast<std::uint64_t>(i));
+        }
+        return values;
+    }
+
+    void BM_Write(benchmark::State &state) {
+        const auto values = make_values(state.range(0));
+        const TemporaryFile file;
+        for (auto _: state) {
+            file.rewind();
+            ds::io::write(file.fd(), values);
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<long long>(sizeof(std::uint64_t)));
+    }
+
+    // Reads come from the page cache, so this measures the overhead on top of copying the bytes
+    void BM_Read(benchmark::State &state) {
+        const TemporaryFile file;
+        ds::io::write(file.fd(), make_values(state.range(0)));
+        ds::Vector<std::uint64_t> values;
+        for (auto _: state) {
+            file.rewind();
+            ds::io::read(file.fd(), values);
+            benchmark::DoNotOptimize(values.data());
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<long long>(sizeof(std::uint64_t)));
+    }
+
+    // Many short vectors, each stored length-prefixed
+    void BM_ReadNested(benchmark::State &state) {
+        const TemporaryFile file;
+        ds::Vector<ds::Vector<std::uint64_t>> nested;
+        for (long long i = 0; i < state.range(0) / 16; i++) {
+            nested.push_back(make_values(16));
+        }
+        ds::io::write(file.fd(), nested);
+        for (auto _: state) {
+            file.rewind();
+            ds::io::read(file.fd(), nested);
+            benchmark::DoNotOptimize(nested.data());
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<long long>(sizeof(std::uint64_t)));
+    }
+} // namespace
+
+BENCHMARK(BM_Write)->RangeMultiplier(64)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_Read)->RangeMultiplier(64)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_ReadNested)->RangeMultiplier(64)->Range(1 << 12, 1 << 24);
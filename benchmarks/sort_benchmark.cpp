@@ -0,0 +1,139 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include <parallel.hpp>
+#include <sort.hpp>
+#include <vector.hpp>
+
+namespace {
+    template<typename T>
+    auto random_vector(types::size_t size) -> ds::Vector<T> {
+        std::mt19937_64 generator(42); // NOLINT(cert-msc32-c,cert-msc51-cpp)
+        ds::Vector<T> v(size);
+        if constexpr (std::is_floating_point_v<T>) {
+            std::normal_distribution<T> distribution(0, 1000);
+            std::generate(v.begin(), v.end(), [&] { return distribution(generator); });
+        } else {
+            std::generate(v.begin(), v.end(), [&] { return static_cast<T>(generator()); });
+        }
+        return v;
+    }
+
+    // Every iteration sorts a fresh copy of the same random input
+    template<typename T, typename Sort>
+    void run_sort(benchmark::State &state, Sort sort) {
+        const auto input = random_vector<T>(state.range(0));
+        ds::Vector<T> v(input.size());
+        for (auto _: state) {
+            state.PauseTiming();
+            std::copy(input.cbegin(), input.cend(), v.begin());
+            state.ResumeTiming();
+            sort(v);
+            benchmark::DoNotOptimize(v.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template<typename T>
+    void BM_StdSort(benchmark::State &state) {
+        run_sort<T>(state, [](auto &v) { std::sort(v.begin(), v.end()); });
+    }
+
+    template<typename T>
+    void BM_RadixSort(benchmark::State &state) {
+        ds::SortBuffer buffer;
+        run_sort<T>(state, [&](auto &v) { ds::sort(v, buffer); });
+    }
+
+    // A comparator the radix sort does not recognize, so that pdqsort runs
+    template<typename T>
+    void BM_Pdqsort(benchmark::State &state) {
+        run_sort<T>(state, [](auto &v) { ds::sort(v, [](T lhs, T rhs) { return lhs < rhs; }); });
+    }
+
+    template<typename T>
+    void BM_ParallelRadixSort(benchmark::State &state) {
+        ds::SortBuffer buffer;
+        run_sort<T>(state, [&](auto &v) { ds::parallel_sort(v, buffer); });
+    }
+
+    void BM_StdSortByKey(benchmark::State &state) {
+        const auto input = random_vector<std::uint64_t>(state.range(0));
+        ds::Vector<std::pair<std::uint64_t, std::uint32_t>> pairs(input.size());
+        for (auto _: state) {
+            state.PauseTiming();
+            for (types::size_t i = 0; i < input.size(); i++) {
+                pairs[i] = {input[i], static_cast<std::uint32_t>(i)};
+            }
+            state.ResumeTiming();
+            std::sort(pairs.begin(), pairs.end(), [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+            benchmark::DoNotOptimize(pairs.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_SortByKey(benchmark::State &state) {
+        const auto input = random_vector<std::uint64_t>(state.range(0));
+        ds::Vector<std::uint64_t> keys(input.size());
+        ds::Vector<std::uint32_t> values(input.size());
+        ds::SortBuffer buffer;
+        for (auto _: state) {
+            state.PauseTiming();
+            std::copy(input.cbegin(), input.cend(), keys.begin());
+            for (types::size_t i = 0; i < input.size(); i++) {
+                values[i] = static_cast<std::uint32_t>(i);
+            }
+            state.ResumeTiming();
+            ds::sort_by_key(keys, values, buffer);
+            benchmark::DoNotOptimize(keys.data());
+            benchmark::DoNotOptimize(values.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_StdSortStrings(benchmark::State &state) {
+        const auto input = random_vector<std::uint32_t>(state.range(0));
+        ds::Vector<std::string> strings;
+        for (auto _: state) {
+            state.PauseTiming();
+            strings.clear();
+            for (const auto key: input) {
+                strings.push_back(std::to_string(key));
+            }
+            state.ResumeTiming();
+            std::sort(strings.begin(), strings.end());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_PdqsortStrings(benchmark::State &state) {
+        const auto input = random_vector<std::uint32_t>(state.range(0));
+        ds::Vector<std::string> strings;
+        for (auto _: state) {
+            state.PauseTiming();
+            strings.clear();
+            for (const auto key: input) {
+                strings.push_back(std::to_string(key));
+            }
+            state.ResumeTiming();
+            ds::sort(strings);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+} // namespace
+
+BENCHMARK(BM_StdSort<std::uint64_t>)->RangeMultiplier(10)->Range(1'000, 10'000'000);
+BENCHMARK(BM_RadixSort<std::uint64_t>)->RangeMultiplier(10)->Range(1'000, 10'000'000);
+BENCHMARK(BM_Pdqsort<std::uint64_t>)->RangeMultiplier(10)->Range(1'000, 10'000'000);
+BENCHMARK(BM_ParallelRadixSort<std::uint64_t>)->RangeMultiplier(10)->Range(100'000, 10'000'000)->UseRealTime();
+BENCHMARK(BM_StdSort<float>)->RangeMultiplier(10)->Range(1'000, 10'000'000);
+BENCHMARK(BM_RadixSort<float>)->RangeMultiplier(10)->Range(1'000, 10'000'000);
+BENCHMARK(BM_ParallelRadixSort<float>)->RangeMultiplier(10)->Range(100'000, 10'000'000)->UseRealTime();
+BENCHMARK(BM_StdSortByKey)->RangeMultiplier(10)->Range(1'000, 10'000'000);
+BENCHMARK(BM_SortByKey)->RangeMultiplier(10)->Range(1'000, 10'000'000);
+BENCHMARK(BM_StdSortStrings)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+BENCHMARK(BM_PdqsortStrings)->RangeMultiplier(10)->Range(1'000, 1'000'000);
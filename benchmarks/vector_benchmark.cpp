@@ -0,0 +1,158 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <vector.hpp>
+
+namespace {
+    // Element larger than a cache line, to see the cost of moving elements around
+    struct Large {
+        std::array<std::uint64_t, 16> payload;
+
+        bool operator==(const Large &) const = default;
+    };
+
+    template<typename T>
+    auto make_value(std::int64_t i) -> T {
+        if constexpr (std::is_same_v<T, std::string>) {
+            // Longer than the small string buffer, so every copy allocates
+            return std::string(32, 'x') + std::to_string(i);
+        } else if constexpr (std::is_same_v<T, Large>) {
+            Large large{};
+            large.payload.fill(static_cast<std::uint64_t>(i));
+            return large;
+        } else {
+            return static_cast<T>(i);
+        }
+    }
+
+    template<typename Container>
+    auto make_container(std::int64_t size) -> Container {
+        Container container;
+        container.reserve(size);
+        for (std::int64_t i = 0; i < size; i++) {
+            container.push_back(make_value<typename Container::value_type>(i));
+        }
+        return container;
+    }
+
+    template<typename Container>
+    void set_counters(benchmark::State &state) {
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(typename Container::value_type)));
+    }
+
+    template<typename Container>
+    void BM_PushBack(benchmark::State &state) {
+        const auto value = make_value<typename Container::value_type>(1);
+        for (auto _: state) {
+            Container container;
+            for (std::int64_t i = 0; i < state.range(0); i++) {
+                container.push_back(value);
+            }
+            benchmark::DoNotOptimize(container.data());
+        }
+        set_counters<Container>(state);
+    }
+
+    template<typename Container>
+    void BM_ReserveFill(benchmark::State &state) {
+        const auto value = make_value<typename Container::value_type>(1);
+        for (auto _: state) {
+            Container container;
+            container.reserve(state.range(0));
+            for (std::int64_t i = 0; i < state.range(0); i++) {
+                container.push_back(value);
+            }
+            benchmark::DoNotOptimize(container.data());
+        }
+        set_counters<Container>(state);
+    }
+
+    template<typename Container>
+    void BM_Copy(benchmark::State &state) {
+        const auto source = make_container<Container>(state.range(0));
+        for (auto _: state) {
+            Container copy(source);
+            benchmark::DoNotOptimize(copy.data());
+        }
+        set_counters<Container>(state);
+    }
+
+    template<typename Container>
+    void BM_Move(benchmark::State &state) {
+        auto source = make_container<Container>(state.range(0));
+        for (auto _: state) {
+            Container moved(std::move(source));
+            benchmark::DoNotOptimize(moved.data());
+            source = std::move(moved);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    template<typename Container>
+    void BM_Iterate(benchmark::State &state) {
+        auto container = make_container<Container>(state.range(0));
+        for (auto _: state) {
+            for (auto &value: container) {
+                benchmark::DoNotOptimize(value);
+            }
+        }
+        set_counters<Container>(state);
+    }
+
+    template<typename Container>
+    void BM_AssignValue(benchmark::State &state) {
+        const auto value = make_value<typename Container::value_type>(1);
+        Container container;
+        for (auto _: state) {
+            container.assign(state.range(0), value);
+            benchmark::DoNotOptimize(container.data());
+        }
+        set_counters<Container>(state);
+    }
+
+    template<typename Container>
+    void BM_Equality(benchmark::State &state) {
+        const auto lhs = make_container<Container>(state.range(0));
+        const auto rhs = lhs;
+        for (auto _: state) {
+            benchmark::DoNotOptimize(lhs == rhs);
+        }
+        set_counters<Container>(state);
+    }
+
+    // Trivial elements go up to 100M; elements owning memory or spanning cache lines stop earlier
+    // to keep the suite within a few GB of RAM
+    constexpr std::int64_t MIN_SIZE = 10;
+    constexpr std::int64_t MAX_TRIVIAL_SIZE = 100'000'000;
+    constexpr std::int64_t MAX_OTHER_SIZE = 1'000'000;
+    constexpr int SIZE_MULTIPLIER = 10;
+
+    void trivial_sizes(benchmark::internal::Benchmark *benchmark) {
+        benchmark->RangeMultiplier(SIZE_MULTIPLIER)->Range(MIN_SIZE, MAX_TRIVIAL_SIZE)->Unit(benchmark::kMicrosecond);
+    }
+
+    void other_sizes(benchmark::internal::Benchmark *benchmark) {
+        benchmark->RangeMultiplier(SIZE_MULTIPLIER)->Range(MIN_SIZE, MAX_OTHER_SIZE)->Unit(benchmark::kMicrosecond);
+    }
+} // namespace
+
+#define DS_VECTOR_BENCHMARK(name)                                                     \
+    BENCHMARK_TEMPLATE(name, ds::Vector<int>)->Apply(trivial_sizes);                  \
+    BENCHMARK_TEMPLATE(name, std::vector<int>)->Apply(trivial_sizes);                 \
+    BENCHMARK_TEMPLATE(name, ds::Vector<std::string>)->Apply(other_sizes);            \
+    BENCHMARK_TEMPLATE(name, std::vector<std::string>)->Apply(other_sizes);           \
+    BENCHMARK_TEMPLATE(name, ds::Vector<Large>)->Apply(other_sizes);                  \
+    BENCHMARK_TEMPLATE(name, std::vector<Large>)->Apply(other_sizes)
+
+DS_VECTOR_BENCHMARK(BM_PushBack);
+DS_VECTOR_BENCHMARK(BM_ReserveFill);
+DS_VECTOR_BENCHMARK(BM_Copy);
+DS_VECTOR_BENCHMARK(BM_Move);
+DS_VECTOR_BENCHMARK(BM_Iterate);
+DS_VECTOR_BENCHMARK(BM_AssignValue);
+DS_VECTOR_BENCHMARK(BM_Equality);
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+
+#include <vector.hpp>
+#include <views.hpp>
+
+namespace {
+    auto iota_vector(long long size) {
+        ds::Vector<long long> values(static_cast<types::size_t>(size));
+        std::iota(values.begin(), values.end(), 0);
+        return values;
+    }
+
+    auto is_odd(long long v) {
+        return v % 2 == 1;
+    }
+
+    auto square(long long v) {
+        return v * v;
+    }
+
+    // Every stage writes a new vector, as a pipeline without views would
+    void BM_Materialized(benchmark::State &state) {
+        const auto values = iota_vector(state.range(0));
+        for (auto _: state) {
+            ds::Vector<long long> odd;
+            for (auto v: values) {
+                if (is_odd(v)) {
+                    odd.push_back(v);
+                }
+            }
+            ds::Vector<long long> squares;
+            squares.reserve(odd.size());
+            for (auto v: odd) {
+                squares.push_back(square(v));
+            }
+            benchmark::DoNotOptimize(std::accumulate(squares.begin(), squares.end(), 0LL));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_Fused(benchmark::State &state) {
+        const auto values = iota_vector(state.range(0));
+        for (auto _: state) {
+            auto squares = values | ds::views::filter(is_odd) | ds::views::map(square);
+            benchmark::DoNotOptimize(std::accumulate(squares.begin(), squares.end(), 0LL));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_FusedCollect(benchmark::State &state) {
+        const auto values = iota_vector(state.range(0));
+        for (auto _: state) {
+            auto squares = values | ds::views::map(square) | ds::views::collect();
+            benchmark::DoNotOptimize(squares.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_ZipDot(benchmark::State &state) {
+        const auto lhs = iota_vector(state.range(0));
+        const auto rhs = iota_vector(state.range(0));
+        for (auto _: state) {
+            long long dot = 0;
+            for (auto [l, r]: ds::views::zip(lhs, rhs)) {
+                dot += l * r;
+            }
+            benchmark::DoNotOptimize(dot);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+} // namespace
+
+BENCHMARK(BM_Materialized)->RangeMultiplier(100)->Range(1'000, 10'000'000);
+BENCHMARK(BM_Fused)->RangeMultiplier(100)->Range(1'000, 10'000'000);
+BENCHMARK(BM_FusedCollect)->RangeMultiplier(100)->Range(1'000, 10'000'000);
+BENCHMARK(BM_ZipDot)->RangeMultiplier(100)->Range(1'000, 10'000'000);
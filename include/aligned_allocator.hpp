@@ -0,0 +1,84 @@
+//
+// Created by santiago on 12.10.23.
+//
+
+#ifndef DS_ALIGNED_ALLOCATOR_HPP
+#define DS_ALIGNED_ALLOCATOR_HPP
+
+#include <sys/mman.h>
+
+#include <bit>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#include "type_definitions.hpp"
+
+namespace ds {
+
+    constexpr types::size_t CACHE_LINE_BYTES = 64;
+    constexpr types::size_t PAGE_BYTES = 4096;
+    constexpr types::size_t HUGE_PAGE_BYTES = types::size_t{1} << 21;
+
+    // Allocator whose blocks start at a multiple of Alignment and span a whole number of Alignment
+    // units, e.g. CACHE_LINE_BYTES so aligned SIMD loads never split a line, or PAGE_BYTES and
+    // HUGE_PAGE_BYTES for buffers handed to the kernel or backed by transparent huge pages, which
+    // are asked for with MADV_HUGEPAGE. Vector rounds its capacity up to whole units as well, and
+    // exposes the slack after the last element through padded_size().
+    template<typename T, types::size_t Alignment = CACHE_LINE_BYTES>
+    struct AlignedAllocator {
+        static_assert(std::has_single_bit(Alignment), "Alignment must be a power of two");
+        static_assert(Alignment >= alignof(T), "Alignment must not be below the one of T");
+
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        static constexpr types::size_t alignment = Alignment;
+
+        template<typename U>
+        struct rebind {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() = default;
+
+        template<typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {} // NOLINT(google-explicit-constructor)
+
+        [[nodiscard]] T *allocate(std::size_t n) {
+            const auto bytes = block_bytes(n);
+            auto *ptr = ::operator new(bytes, std::align_val_t{Alignment});
+#ifdef MADV_HUGEPAGE
+            if constexpr (Alignment >= HUGE_PAGE_BYTES) {
+                madvise(ptr, bytes, MADV_HUGEPAGE);
+            }
+#endif
+            return static_cast<T *>(ptr);
+        }
+
+        void deallocate(T *ptr, std::size_t n) noexcept {
+            ::operator delete(ptr, block_bytes(n), std::align_val_t{Alignment});
+        }
+
+        template<typename U>
+        bool operator==(const AlignedAllocator<U, Alignment> &) const noexcept { return true; }
+
+    private:
+        static auto block_bytes(std::size_t n) -> std::size_t {
+            return (n * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+        }
+    };
+
+    // Alignment of the blocks Allocator returns: its alignment member if it has one, and the one of
+    // T otherwise
+    template<typename Allocator, typename T>
+    inline constexpr types::size_t allocation_alignment_v = [] {
+        if constexpr (requires { Allocator::alignment; }) {
+            return Allocator::alignment > alignof(T) ? types::size_t{Allocator::alignment} : types::size_t{alignof(T)};
+        } else {
+            return types::size_t{alignof(T)};
+        }
+    }();
+} // namespace ds
+
+#endif //DS_ALIGNED_ALLOCATOR_HPP
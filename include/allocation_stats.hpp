@@ -0,0 +1,23 @@
+//
+// Created by santiago on 13.08.23.
+//
+
+#ifndef DS_ALLOCATION_STATS_HPP
+#define DS_ALLOCATION_STATS_HPP
+
+#include "type_definitions.hpp"
+
+namespace ds {
+
+    // Memory accounting reported by Arena and Pool
+    struct AllocationStats {
+        // Bytes currently handed out to callers, including alignment padding and size-class rounding
+        types::size_t bytes_used = 0;
+        // Largest value bytes_used has reached since construction or the last reset_high_water_mark()
+        types::size_t high_water_mark = 0;
+        // Bytes obtained from the system, whether handed out or not
+        types::size_t bytes_reserved = 0;
+    };
+} // namespace ds
+
+#endif //DS_ALLOCATION_STATS_HPP
@@ -0,0 +1,222 @@
+//
+// Created by santiago on 13.08.23.
+//
+
+#ifndef DS_ARENA_HPP
+#define DS_ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "allocation_stats.hpp"
+#include "type_definitions.hpp"
+
+namespace ds {
+
+    // Bump-pointer memory resource. Allocations are carved consecutively out of blocks of doubling
+    // size and are all freed at once by release() or when the arena is destroyed; deallocate() only
+    // gives memory back for the most recent allocation. Growing the most recent allocation happens in
+    // place, so a single vector growing in an arena never copies while its block has room.
+    // Not thread-safe.
+    class Arena {
+    public:
+        using size_type = types::size_t;
+
+        static constexpr size_type DEFAULT_BLOCK_SIZE = size_type{64} << 10U;
+
+        explicit Arena(size_type initial_block_size = DEFAULT_BLOCK_SIZE) : _next_block_size(std::max(initial_block_size, MIN_BLOCK_SIZE)) {}
+
+        Arena(const Arena &) = delete;
+
+        Arena(Arena &&) = delete;
+
+        ~Arena() {
+            free_blocks(nullptr);
+        }
+
+        auto operator=(const Arena &) -> Arena & = delete;
+
+        auto operator=(Arena &&) -> Arena & = delete;
+
+        [[nodiscard]] auto allocate(size_type bytes, size_type alignment = alignof(std::max_align_t)) -> void * {
+            auto *ptr = aligned_cursor(alignment);
+            if (ptr == nullptr or static_cast<size_type>(_end - ptr) < bytes) {
+                add_block(bytes + alignment);
+                ptr = aligned_cursor(alignment);
+            }
+
+            _last_start = _cursor;
+            use(static_cast<size_type>(ptr + bytes - _cursor)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            _cursor = ptr + bytes;                               // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            return ptr;
+        }
+
+        // Only the most recent allocation is reclaimed, along with its alignment padding; the rest
+        // waits for release()
+        void deallocate(void *ptr, size_type bytes) noexcept {
+            if (is_last(ptr, bytes)) {
+                _stats.bytes_used -= static_cast<size_type>(_cursor - _last_start);
+                _cursor = _last_start;
+            }
+        }
+
+        // Resizes ptr without moving it, which works when it is the most recent allocation (and there
+        // is room left in its block) or when shrinking
+        auto try_extend(void *ptr, size_type old_bytes, size_type new_bytes) noexcept -> bool {
+            if (not is_last(ptr, old_bytes)) {
+                return new_bytes <= old_bytes;
+            }
+
+            auto *start = static_cast<std::byte *>(ptr);
+            if (static_cast<size_type>(_end - start) < new_bytes) {
+                return false;
+            }
+
+            _stats.bytes_used -= old_bytes;
+            use(new_bytes);
+            _cursor = start + new_bytes; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            return true;
+        }
+
+        // Frees every allocation at once. The newest, largest block is kept for the next round.
+        void release() noexcept {
+            if (_blocks == nullptr) {
+                return;
+            }
+
+            free_blocks(_blocks);
+            _blocks->previous = nullptr;
+            _cursor = _blocks->data();
+            _last_start = _cursor;
+            _stats.bytes_used = 0;
+            _stats.bytes_reserved = _blocks->size;
+        }
+
+        void reset_high_water_mark() noexcept {
+            _stats.high_water_mark = _stats.bytes_used;
+        }
+
+        [[nodiscard]] auto stats() const noexcept -> const AllocationStats & {
+            return _stats;
+        }
+
+    private:
+        struct alignas(std::max_align_t) Block {
+            Block *previous;
+            size_type size;
+
+            auto data() noexcept -> std::byte * {
+                return reinterpret_cast<std::byte *>(this + 1); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        };
+
+        static constexpr size_type MIN_BLOCK_SIZE = 4096;
+        static constexpr size_type MAX_BLOCK_GROWTH = size_type{64} << 20U;
+
+        Block *_blocks = nullptr;
+        std::byte *_cursor = nullptr;
+        // Cursor before the most recent allocation and its padding
+        std::byte *_last_start = nullptr;
+        std::byte *_end = nullptr;
+        size_type _next_block_size;
+        AllocationStats _stats;
+
+        [[nodiscard]] auto aligned_cursor(size_type alignment) const noexcept -> std::byte * {
+            if (_cursor == nullptr) {
+                return nullptr;
+            }
+
+            const auto address = reinterpret_cast<std::uintptr_t>(_cursor); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            const auto padding = (alignment - address % alignment) % alignment;
+            return static_cast<size_type>(_end - _cursor) < padding ? nullptr : _cursor + padding; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        void add_block(size_type min_bytes) {
+            const auto size = std::max(_next_block_size, min_bytes);
+            auto *block = ::new (::operator new(sizeof(Block) + size)) Block{_blocks, size};
+            _blocks = block;
+            _cursor = block->data();
+            _end = _cursor + size; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            _stats.bytes_reserved += size;
+            _next_block_size = std::min(2 * _next_block_size, std::max(MAX_BLOCK_GROWTH, _next_block_size));
+        }
+
+        // Frees the blocks older than keep, or every block if keep is null
+        void free_blocks(Block *keep) noexcept {
+            auto *block = keep == nullptr ? _blocks : keep->previous;
+            while (block != nullptr) {
+                auto *previous = block->previous;
+                ::operator delete(block);
+                block = previous;
+            }
+        }
+
+        [[nodiscard]] auto is_last(void *ptr, size_type bytes) const noexcept -> bool {
+            return static_cast<std::byte *>(ptr) + bytes == _cursor; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        void use(size_type bytes) noexcept {
+            _stats.bytes_used += bytes;
+            _stats.high_water_mark = std::max(_stats.high_water_mark, _stats.bytes_used);
+        }
+    };
+
+    // Allocator handing out memory from an Arena, which must outlive every container using it.
+    // Copies share the arena, and the allocator does not propagate on container assignment, so
+    // elements assigned into a container always end up in that container's arena.
+    template<typename T>
+    class ArenaAllocator {
+    public:
+        using value_type = T;
+
+        explicit ArenaAllocator(Arena &arena) noexcept : _arena(&arena) {}
+
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U> &other) noexcept : _arena(&other.arena()) {} // NOLINT(google-explicit-constructor)
+
+        [[nodiscard]] T *allocate(std::size_t n) {
+            if (n > std::allocator_traits<ArenaAllocator>::max_size(*this)) {
+                throw std::bad_array_new_length();
+            }
+
+            return static_cast<T *>(_arena->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *ptr, std::size_t n) noexcept {
+            _arena->deallocate(ptr, n * sizeof(T));
+        }
+
+        [[nodiscard]] bool try_extend(T *ptr, std::size_t old_n, std::size_t new_n) noexcept {
+            return _arena->try_extend(ptr, old_n * sizeof(T), new_n * sizeof(T));
+        }
+
+        // Only used for trivially relocatable elements, so moving them with memcpy is fine
+        [[nodiscard]] T *reallocate(T *ptr, std::size_t old_n, std::size_t new_n) {
+            if (try_extend(ptr, old_n, new_n)) {
+                return ptr;
+            }
+
+            auto *new_ptr = allocate(new_n);
+            std::memcpy(static_cast<void *>(new_ptr), ptr, std::min(old_n, new_n) * sizeof(T));
+            deallocate(ptr, old_n);
+            return new_ptr;
+        }
+
+        [[nodiscard]] auto arena() const noexcept -> Arena & {
+            return *_arena;
+        }
+
+        template<typename U>
+        bool operator==(const ArenaAllocator<U> &other) const noexcept { return _arena == &other.arena(); }
+
+    private:
+        Arena *_arena;
+    };
+} // namespace ds
+
+#endif //DS_ARENA_HPP
@@ -0,0 +1,436 @@
+//
+// Created by santiago on 17.09.23.
+//
+
+#ifndef DS_BIT_VECTOR_HPP
+#define DS_BIT_VECTOR_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+
+#include "type_definitions.hpp"
+#include "vector.hpp"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace ds {
+
+    // One bit per element, packed into 64-bit words. Bits past size() in the last word are always
+    // zero, so whole-vector operations can work a word at a time without masking.
+    class BitVector {
+    public:
+        using size_type = types::size_t;
+        using word_type = std::uint64_t;
+
+        static constexpr size_type WORD_BITS = 64;
+
+        // Proxy for a single bit, as bits cannot be referenced directly
+        class reference {
+        public:
+            reference(const reference &) = default;
+
+            ~reference() = default;
+
+            auto operator=(bool value) -> reference & {
+                *_word = value ? *_word | _mask : *_word & ~_mask;
+                return *this;
+            }
+
+            auto operator=(const reference &other) -> reference & { // NOLINT(bugprone-unhandled-self-assignment)
+                return *this = static_cast<bool>(other);
+            }
+
+            operator bool() const { // NOLINT(google-explicit-constructor)
+                return (*_word & _mask) != 0;
+            }
+
+            void flip() {
+                *_word ^= _mask;
+            }
+
+        private:
+            friend class BitVector;
+
+            word_type *_word;
+            word_type _mask;
+
+            reference(word_type *word, size_type bit) : _word(word), _mask(word_type{1} << bit) {}
+        };
+
+        BitVector() = default;
+
+        explicit BitVector(size_type count, bool value = false) {
+            resize(count, value);
+        }
+
+        BitVector(std::initializer_list<bool> init) {
+            reserve(init.size());
+            for (const auto value: init) {
+                push_back(value);
+            }
+        }
+
+        [[nodiscard]] auto all() const -> bool {
+            return count() == size();
+        }
+
+        [[nodiscard]] auto any() const -> bool {
+            return std::any_of(_words.begin(), _words.end(), [](word_type word) { return word != 0; });
+        }
+
+        void clear() {
+            _words.clear();
+            _size = 0;
+        }
+
+        // Number of set bits
+        [[nodiscard]] auto count() const -> size_type {
+            size_type result = 0;
+            for (size_type i = 0; i < _words.size(); i++) {
+                result += static_cast<size_type>(std::popcount(_words[i]));
+            }
+            return result;
+        }
+
+        [[nodiscard]] auto empty() const -> bool {
+            return _size == 0;
+        }
+
+        // Position of the first set bit, or size() if there is none
+        [[nodiscard]] auto find_first() const -> size_type {
+            return find_from(0);
+        }
+
+        // Position of the first set bit after pos, or size() if there is none
+        [[nodiscard]] auto find_next(size_type pos) const -> size_type {
+            return find_from(pos + 1);
+        }
+
+        void flip() {
+            for (size_type i = 0; i < _words.size(); i++) {
+                _words[i] = ~_words[i];
+            }
+            clear_tail();
+        }
+
+        void flip(size_type pos) {
+            _words[pos / WORD_BITS] ^= word_type{1} << (pos % WORD_BITS);
+        }
+
+        [[nodiscard]] auto none() const -> bool {
+            return not any();
+        }
+
+        auto operator&=(const BitVector &other) -> BitVector & {
+            check_same_size(other);
+            for (size_type i = 0; i < _words.size(); i++) {
+                _words[i] &= other._words[i];
+            }
+            return *this;
+        }
+
+        auto operator|=(const BitVector &other) -> BitVector & {
+            check_same_size(other);
+            for (size_type i = 0; i < _words.size(); i++) {
+                _words[i] |= other._words[i];
+            }
+            return *this;
+        }
+
+        auto operator^=(const BitVector &other) -> BitVector & {
+            check_same_size(other);
+            for (size_type i = 0; i < _words.size(); i++) {
+                _words[i] ^= other._words[i];
+            }
+            return *this;
+        }
+
+        friend auto operator&(BitVector lhs, const BitVector &rhs) -> BitVector {
+            return lhs &= rhs;
+        }
+
+        friend auto operator|(BitVector lhs, const BitVector &rhs) -> BitVector {
+            return lhs |= rhs;
+        }
+
+        friend auto operator^(BitVector lhs, const BitVector &rhs) -> BitVector {
+            return lhs ^= rhs;
+        }
+
+        friend auto operator~(BitVector bits) -> BitVector {
+            bits.flip();
+            return bits;
+        }
+
+        friend auto operator==(const BitVector &lhs, const BitVector &rhs) -> bool {
+            return lhs._size == rhs._size and std::equal(lhs._words.begin(), lhs._words.end(), rhs._words.begin());
+        }
+
+        auto operator[](size_type pos) -> reference {
+            return {&_words[pos / WORD_BITS], pos % WORD_BITS};
+        }
+
+        auto operator[](size_type pos) const -> bool {
+            return ((_words[pos / WORD_BITS] >> (pos % WORD_BITS)) & 1U) != 0;
+        }
+
+        void pop_back() {
+            _size--;
+            if (_size % WORD_BITS == 0) {
+                _words.pop_back();
+            } else {
+                clear_tail();
+            }
+        }
+
+        void push_back(bool value) {
+            if (_size % WORD_BITS == 0) {
+                _words.push_back(0);
+            }
+            _words[_size / WORD_BITS] |= word_type{value} << (_size % WORD_BITS);
+            _size++;
+        }
+
+        void reserve(size_type new_cap) {
+            _words.reserve(word_count(new_cap));
+        }
+
+        void reset() {
+            std::fill(_words.begin(), _words.end(), 0);
+        }
+
+        void reset(size_type pos) {
+            _words[pos / WORD_BITS] &= ~(word_type{1} << (pos % WORD_BITS));
+        }
+
+        void resize(size_type count, bool value = false) {
+            const auto old_size = _size;
+            if (value and old_size % WORD_BITS != 0) {
+                _words[old_size / WORD_BITS] |= ~word_type{0} << (old_size % WORD_BITS);
+            }
+
+            const auto words = word_count(count);
+            while (_words.size() > words) {
+                _words.pop_back();
+            }
+            _words.reserve(words);
+            while (_words.size() < words) {
+                _words.push_back(value ? ~word_type{0} : 0);
+            }
+
+            _size = count;
+            clear_tail();
+        }
+
+        void set() {
+            std::fill(_words.begin(), _words.end(), ~word_type{0});
+            clear_tail();
+        }
+
+        void set(size_type pos, bool value = true) {
+            (*this)[pos] = value;
+        }
+
+        void shrink_to_fit() {
+            _words.shrink_to_fit();
+        }
+
+        [[nodiscard]] auto size() const -> size_type {
+            return _size;
+        }
+
+        [[nodiscard]] auto test(size_type pos) const -> bool {
+            if (pos >= _size) {
+                throw std::out_of_range("id is out of range");
+            }
+
+            return (*this)[pos];
+        }
+
+        // Underlying words, least significant bit first
+        [[nodiscard]] auto words() const -> std::span<const word_type> {
+            return std::span(_words.data(), _words.size());
+        }
+
+    private:
+        Vector<word_type> _words;
+        size_type _size = 0;
+
+        static auto word_count(size_type bits) -> size_type {
+            return (bits + WORD_BITS - 1) / WORD_BITS;
+        }
+
+        void check_same_size(const BitVector &other) const {
+            if (_size != other._size) {
+                throw std::invalid_argument("Bit vectors differ in size");
+            }
+        }
+
+        void clear_tail() {
+            if (_size % WORD_BITS != 0) {
+                _words[_words.size() - 1] &= ~(~word_type{0} << (_size % WORD_BITS));
+            }
+        }
+
+        [[nodiscard]] auto find_from(size_type pos) const -> size_type {
+            if (pos >= _size) {
+                return _size;
+            }
+
+            auto index = pos / WORD_BITS;
+            auto word = _words[index] & (~word_type{0} << (pos % WORD_BITS));
+            while (word == 0) {
+                if (++index == _words.size()) {
+                    return _size;
+                }
+                word = _words[index];
+            }
+            return index * WORD_BITS + static_cast<size_type>(std::countr_zero(word));
+        }
+    };
+
+    // Rank and select over a BitVector, which must outlive it and not change while it is in use.
+    // Rank is constant time (Vigna's rank9): every block of 512 bits stores the ones before it and,
+    // packed in a second word, the ones before each of its words, so a query reads two counters and
+    // one popcount. Select finds the block from a sample taken every SELECT_SAMPLE ones and then
+    // scans the block's counters, which is constant time unless the ones are very unevenly spread.
+    // The counters take 25% on top of the bits.
+    class RankSelect {
+    public:
+        using size_type = types::size_t;
+        using word_type = BitVector::word_type;
+
+        static constexpr size_type SELECT_SAMPLE = 4096;
+
+        explicit RankSelect(const BitVector &bits) : _bits(&bits) {
+            const auto words = bits.words();
+            const auto num_blocks = (words.size() + WORDS_PER_BLOCK - 1) / WORDS_PER_BLOCK;
+            _counts.reserve(2 * (num_blocks + 1));
+            _samples.reserve(bits.size() / SELECT_SAMPLE + 1);
+
+            size_type ones = 0;
+            for (size_type block = 0; block < num_blocks; block++) {
+                word_type relative = 0;
+                size_type in_block = 0;
+                for (size_type i = 0; i < WORDS_PER_BLOCK; i++) {
+                    if (i > 0) {
+                        relative |= word_type{in_block} << (9 * (i - 1));
+                    }
+
+                    const auto index = block * WORDS_PER_BLOCK + i;
+                    const auto word_ones = index < words.size() ? static_cast<size_type>(std::popcount(words[index])) : 0;
+                    // Samples record the block holding every SELECT_SAMPLE-th one
+                    while (_samples.size() * SELECT_SAMPLE < ones + in_block + word_ones) {
+                        _samples.push_back(block);
+                    }
+                    in_block += word_ones;
+                }
+
+                _counts.push_back(ones);
+                _counts.push_back(relative);
+                ones += in_block;
+            }
+            // Sentinel block, so that the ones before block b + 1 can always be read
+            _counts.push_back(ones);
+            _counts.push_back(0);
+            _samples.push_back(num_blocks);
+            _ones = ones;
+        }
+
+        // Number of set bits
+        [[nodiscard]] auto ones() const -> size_type {
+            return _ones;
+        }
+
+        // Number of set bits before pos, for pos <= size()
+        [[nodiscard]] auto rank(size_type pos) const -> size_type {
+            const auto word = pos / BitVector::WORD_BITS;
+            const auto bit = pos % BitVector::WORD_BITS;
+            const auto block = word / WORDS_PER_BLOCK;
+            auto result = _counts[2 * block] + relative_count(block, word % WORDS_PER_BLOCK);
+            if (bit != 0) {
+                result += static_cast<size_type>(std::popcount(_bits->words()[word] & ~(~word_type{0} << bit)));
+            }
+            return result;
+        }
+
+        // Number of unset bits before pos, for pos <= size()
+        [[nodiscard]] auto rank0(size_type pos) const -> size_type {
+            return pos - rank(pos);
+        }
+
+        // Position of the set bit with rank k, i.e. the (k + 1)-th one
+        [[nodiscard]] auto select(size_type k) const -> size_type {
+            if (k >= _ones) {
+                throw std::out_of_range("Rank is out of range");
+            }
+
+            // The block is the last one starting with at most k ones before it, and lies between
+            // the samples around k
+            auto low = _samples[k / SELECT_SAMPLE];
+            auto high = _samples[k / SELECT_SAMPLE + 1];
+            while (low < high) {
+                const auto middle = low + (high - low + 1) / 2;
+                if (_counts[2 * middle] <= k) {
+                    low = middle;
+                } else {
+                    high = middle - 1;
+                }
+            }
+
+            auto remaining = k - _counts[2 * low];
+            size_type word = 0;
+            while (word + 1 < WORDS_PER_BLOCK and relative_count(low, word + 1) <= remaining) {
+                word++;
+            }
+            remaining -= relative_count(low, word);
+
+            const auto index = low * WORDS_PER_BLOCK + word;
+            return index * BitVector::WORD_BITS + select_in_word(_bits->words()[index], remaining);
+        }
+
+    private:
+        static constexpr size_type WORDS_PER_BLOCK = 8;
+
+        const BitVector *_bits;
+        // Per block: ones before the block, then 9-bit counts of ones before each of its words 1 to 7
+        Vector<word_type> _counts;
+        // _samples[i] is the block holding the one with rank i * SELECT_SAMPLE
+        Vector<size_type> _samples;
+        size_type _ones = 0;
+
+        [[nodiscard]] auto relative_count(size_type block, size_type word) const -> size_type {
+            return word == 0 ? 0 : (_counts[2 * block + 1] >> (9 * (word - 1))) & 0x1FFU;
+        }
+
+        // Position of the set bit with rank k within word
+        static auto select_in_word(word_type word, size_type k) -> size_type {
+#if defined(__BMI2__)
+            return static_cast<size_type>(std::countr_zero(_pdep_u64(word_type{1} << k, word)));
+#else
+            size_type byte = 0;
+            for (;; byte++) {
+                const auto byte_ones = static_cast<size_type>(std::popcount((word >> (8 * byte)) & 0xFFU));
+                if (k < byte_ones) {
+                    break;
+                }
+                k -= byte_ones;
+            }
+
+            word >>= 8 * byte;
+            for (size_type i = 0; i < k; i++) {
+                word &= word - 1;
+            }
+            return 8 * byte + static_cast<size_type>(std::countr_zero(word));
+#endif
+        }
+    };
+} // namespace ds
+
+#endif //DS_BIT_VECTOR_HPP
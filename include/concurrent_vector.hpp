@@ -0,0 +1,251 @@
+//
+// Created by santiago on 30.07.23.
+//
+
+#ifndef DS_CONCURRENT_VECTOR_HPP
+#define DS_CONCURRENT_VECTOR_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "type_definitions.hpp"
+
+namespace ds {
+
+    // Vector supporting concurrent appends and reads. Elements live in segments of doubling size
+    // that are never moved or freed before the container is destroyed, so references stay valid
+    // and growing never blocks other threads. Appending is lock-free: claiming a slot is a single
+    // fetch_add, and allocating a segment is a compare-and-swap that losers back out of.
+    //
+    // size() counts claimed slots, which may still be under construction. An element can be read
+    // once the push_back that returned its index happens-before the read, or once try_get()
+    // returns it. clear(), reserve() and destruction must not race with other operations.
+    //
+    // The slot is claimed before the element is built, and cannot be given back. If allocating its
+    // segment or constructing the element throws, its index stays counted in size() as a hole that is
+    // never constructed: try_get() returns nullptr and at() throws for it, while operator[] must not
+    // be used on it (debug builds assert that the element is constructed).
+    template<typename T, types::size_t FirstSegmentSize = 64>
+    class ConcurrentVector {
+        static_assert(std::has_single_bit(FirstSegmentSize), "First segment size must be a power of 2");
+
+        struct Slot {
+            alignas(T) std::byte storage[sizeof(T)]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+            std::atomic<bool> constructed;
+        };
+
+        static constexpr int FIRST_SEGMENT_BITS = std::countr_zero(FirstSegmentSize);
+        static constexpr int MAX_SEGMENTS = 64 - FIRST_SEGMENT_BITS;
+
+    public:
+        using size_type = types::size_t;
+        using value_type = T;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+
+        ConcurrentVector() = default;
+
+        ConcurrentVector(const ConcurrentVector &) = delete;
+
+        ConcurrentVector(ConcurrentVector &&) = delete;
+
+        ~ConcurrentVector() {
+            clear();
+            for (int segment = 0; segment < MAX_SEGMENTS; segment++) {
+                free_segment(segment, _segments[segment].load(std::memory_order_relaxed)); // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            }
+        }
+
+        auto operator=(const ConcurrentVector &) -> ConcurrentVector & = delete;
+
+        auto operator=(ConcurrentVector &&) -> ConcurrentVector & = delete;
+
+        auto at(size_type pos) -> reference {
+            auto *value = try_get(pos);
+            if (value == nullptr) {
+                throw std::out_of_range("id is out of range or not constructed yet");
+            }
+
+            return *value;
+        }
+
+        auto at(size_type pos) const -> const_reference {
+            const auto *value = try_get(pos);
+            if (value == nullptr) {
+                throw std::out_of_range("id is out of range or not constructed yet");
+            }
+
+            return *value;
+        }
+
+        // Number of elements the allocated segments can hold without allocating
+        [[nodiscard]] auto capacity() const -> size_type {
+            size_type total = 0;
+            for (int segment = 0; segment < MAX_SEGMENTS and _segments[segment].load(std::memory_order_acquire) != nullptr; segment++) { // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+                total += segment_size(segment);
+            }
+
+            return total;
+        }
+
+        // Destroys all elements but keeps the segments
+        void clear() {
+            const auto claimed = _size.load(std::memory_order_relaxed);
+            for (size_type index = 0; index < claimed; index++) {
+                auto &slot = slot_at(index);
+                if (slot.constructed.load(std::memory_order_relaxed)) {
+                    std::destroy_at(element(slot));
+                    slot.constructed.store(false, std::memory_order_relaxed);
+                }
+            }
+
+            _size.store(0, std::memory_order_relaxed);
+        }
+
+        // Constructs a new element and returns its index
+        template<typename... Args>
+        auto emplace_back(Args &&...args) -> size_type {
+            const auto index = _size.fetch_add(1, std::memory_order_relaxed);
+            auto &slot = claim_slot(index);
+            new (slot.storage) T(std::forward<Args>(args)...);
+            slot.constructed.store(true, std::memory_order_release);
+            return index;
+        }
+
+        [[nodiscard]] auto empty() const {
+            return size() == 0;
+        }
+
+        auto operator[](size_type pos) -> reference {
+            return *element(constructed_slot(pos));
+        }
+
+        auto operator[](size_type pos) const -> const_reference {
+            return *element(constructed_slot(pos));
+        }
+
+        auto push_back(const T &value) -> size_type {
+            return emplace_back(value);
+        }
+
+        auto push_back(T &&value) -> size_type {
+            return emplace_back(std::move(value));
+        }
+
+        // Allocates every segment needed to hold new_cap elements
+        void reserve(size_type new_cap) {
+            if (new_cap == 0) {
+                return;
+            }
+
+            for (int segment = 0; segment <= segment_of(new_cap - 1); segment++) {
+                if (_segments[segment].load(std::memory_order_acquire) == nullptr) { // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+                    allocate_segment(segment);
+                }
+            }
+        }
+
+        [[nodiscard]] auto size() const -> size_type {
+            return _size.load(std::memory_order_acquire);
+        }
+
+        // Element at pos if it has been fully constructed, nullptr otherwise
+        auto try_get(size_type pos) -> T * {
+            auto *slot = find_constructed(pos);
+            return slot != nullptr ? element(*slot) : nullptr;
+        }
+
+        auto try_get(size_type pos) const -> const T * {
+            auto *slot = find_constructed(pos);
+            return slot != nullptr ? element(*slot) : nullptr;
+        }
+
+    private:
+        std::atomic<size_type> _size = 0;
+        std::array<std::atomic<Slot *>, MAX_SEGMENTS> _segments = {};
+
+        // Segment k holds FirstSegmentSize << k elements, starting at index FirstSegmentSize * (2^k - 1)
+        static constexpr auto segment_of(size_type index) -> int {
+            return std::bit_width(index + FirstSegmentSize) - 1 - FIRST_SEGMENT_BITS;
+        }
+
+        static constexpr auto segment_size(int segment) -> size_type {
+            return FirstSegmentSize << segment;
+        }
+
+        static constexpr auto offset_in_segment(size_type index) -> size_type {
+            return index + FirstSegmentSize - segment_size(segment_of(index));
+        }
+
+        static auto element(Slot &slot) -> T * {
+            return std::launder(reinterpret_cast<T *>(slot.storage)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        }
+
+        auto find_constructed(size_type pos) const -> Slot * {
+            if (pos >= size()) {
+                return nullptr;
+            }
+
+            auto *segment = _segments[segment_of(pos)].load(std::memory_order_acquire); // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            if (segment == nullptr) {
+                return nullptr;
+            }
+
+            auto &slot = segment[offset_in_segment(pos)]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            return slot.constructed.load(std::memory_order_acquire) ? &slot : nullptr;
+        }
+
+        auto constructed_slot(size_type index) const -> Slot & {
+            auto &slot = slot_at(index);
+            assert(slot.constructed.load(std::memory_order_relaxed) and "Element was never constructed");
+            return slot;
+        }
+
+        // Only valid for indices whose segment is known to be allocated
+        auto slot_at(size_type index) const -> Slot & {
+            auto *slots = _segments[segment_of(index)].load(std::memory_order_acquire); // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            return slots[offset_in_segment(index)]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        auto claim_slot(size_type index) -> Slot & {
+            const auto segment = segment_of(index);
+            auto *slots = _segments[segment].load(std::memory_order_acquire); // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            if (slots == nullptr) {
+                slots = allocate_segment(segment);
+            }
+
+            return slots[offset_in_segment(index)]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        // Publishes a new segment unless another thread did it first, in which case ours is freed
+        auto allocate_segment(int segment) -> Slot * {
+            auto *fresh = std::allocator<Slot>().allocate(segment_size(segment));
+            for (size_type i = 0; i < segment_size(segment); i++) {
+                new (&fresh[i].constructed) std::atomic<bool>(false); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+
+            Slot *expected = nullptr;
+            if (_segments[segment].compare_exchange_strong(expected, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) { // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+                return fresh;
+            }
+
+            free_segment(segment, fresh);
+            return expected;
+        }
+
+        static void free_segment(int segment, Slot *slots) {
+            if (slots != nullptr) {
+                std::allocator<Slot>().deallocate(slots, segment_size(segment));
+            }
+        }
+    };
+} // namespace ds
+
+#endif //DS_CONCURRENT_VECTOR_HPP
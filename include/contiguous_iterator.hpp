@@ -5,6 +5,8 @@
 #ifndef DS_CONTIGUOUS_ITERATOR_HPP
 #define DS_CONTIGUOUS_ITERATOR_HPP
 
+#include <iterator>
+#include <type_traits>
 #include <utility>
 
 
@@ -20,65 +22,69 @@ namespace it {
 
         ContiguousIterator() = default;
 
-        explicit ContiguousIterator(pointer p) { _ptr = p; }
+        constexpr explicit ContiguousIterator(pointer p) : _ptr(p) {}
 
-        reference operator*() const { return *_ptr; }
+        template<typename OtherReference>
+            requires(not std::is_same_v<OtherReference, ReferenceType> and std::is_convertible_v<OtherReference, ReferenceType>)
+        constexpr ContiguousIterator(const ContiguousIterator<ValueType, OtherReference> &other) : _ptr(other.operator->()) {} // NOLINT(google-explicit-constructor)
 
-        pointer operator->() const { return _ptr; }
+        constexpr reference operator*() const { return *_ptr; }
 
-        ContiguousIterator &operator++() {
+        constexpr pointer operator->() const { return _ptr; }
+
+        constexpr ContiguousIterator &operator++() {
             _ptr++;
             return *this;
         }
 
-        ContiguousIterator operator++(int) {
+        constexpr ContiguousIterator operator++(int) {
             ContiguousIterator tmp = *this;
             ++(*this);
             return tmp;
         }
 
-        ContiguousIterator &operator+=(int i) {
+        constexpr ContiguousIterator &operator+=(int i) {
             _ptr += i;
             return *this;
         }
 
-        ContiguousIterator operator+(const difference_type other) const { return _ptr + other; }
+        constexpr ContiguousIterator operator+(const difference_type other) const { return ContiguousIterator(_ptr + other); }
 
-        friend ContiguousIterator operator+(const difference_type value,
+        friend constexpr ContiguousIterator operator+(const difference_type value,
                                             const ContiguousIterator &other) {
             return other + value;
         }
 
-        ContiguousIterator &operator--() {
+        constexpr ContiguousIterator &operator--() {
             _ptr--;
             return *this;
         }
 
-        ContiguousIterator operator--(int) {
+        constexpr ContiguousIterator operator--(int) {
             ContiguousIterator tmp = *this;
             --(*this);
             return tmp;
         }
 
-        ContiguousIterator &operator-=(int i) {
+        constexpr ContiguousIterator &operator-=(int i) {
             _ptr -= i;
             return *this;
         }
 
-        difference_type operator-(const ContiguousIterator &other) const {
+        constexpr difference_type operator-(const ContiguousIterator &other) const {
             return _ptr - other._ptr;
         }
 
-        ContiguousIterator operator-(const difference_type other) const { return _ptr - other; }
+        constexpr ContiguousIterator operator-(const difference_type other) const { return ContiguousIterator(_ptr - other); }
 
-        friend ContiguousIterator operator-(const difference_type value,
+        friend constexpr ContiguousIterator operator-(const difference_type value,
                                             const ContiguousIterator &other) {
             return other - value;
         }
 
-        reference operator[](difference_type idx) const { return _ptr[idx]; }
+        constexpr reference operator[](difference_type idx) const { return _ptr[idx]; }
 
-        auto operator<=>(const ContiguousIterator &) const = default;
+        constexpr auto operator<=>(const ContiguousIterator &) const = default;
 
     private:
         pointer _ptr;
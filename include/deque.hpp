@@ -0,0 +1,398 @@
+//
+// Created by santiago on 20.08.23.
+//
+
+#ifndef DS_DEQUE_HPP
+#define DS_DEQUE_HPP
+
+#include <algorithm>
+#include <bit>
+#include <initializer_list>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "contiguous_iterator.hpp"
+#include "segmented_iterator.hpp"
+#include "type_definitions.hpp"
+#include "vector.hpp"
+
+namespace ds {
+
+    namespace detail {
+        // About 4 KiB per block, but never fewer than 16 elements
+        template<typename T>
+        constexpr auto deque_block_size() -> types::size_t {
+            return std::bit_floor(std::max<types::size_t>(16, 4096 / sizeof(T)));
+        }
+    } // namespace detail
+
+    // Double-ended queue made of fixed-size blocks. Every element has a position that never changes:
+    // the element at position p lives at slot p % BlockSize of block p / BlockSize, and pushing to
+    // either end only moves the front or back position. Blocks are found through a ring of block
+    // pointers indexed by block number modulo its size, so pushing and popping at both ends are O(1)
+    // and elements never move. References and iterators stay valid until their element is removed.
+    // Emptied blocks are kept and reused, so a sliding window reaches a steady state without
+    // allocating; shrink_to_fit() gives them back.
+    template<typename T, typename Allocator = std::allocator<T>, types::size_t BlockSize = detail::deque_block_size<T>()>
+    class Deque {
+        static_assert(std::has_single_bit(BlockSize), "Block size must be a power of 2");
+
+        using alloc_traits = std::allocator_traits<Allocator>;
+        using map_allocator = typename alloc_traits::template rebind_alloc<T *>;
+
+    public:
+        using size_type = types::size_t;
+        using value_type = T;
+        using allocator_type = Allocator;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using difference_type = types::ptrdiff_t;
+        using iterator = it::SegmentedIterator<Deque, reference>;
+        using const_iterator = it::SegmentedIterator<Deque, const_reference>;
+        using segment_iterator = it::ContiguousIterator<T, reference>;
+        using const_segment_iterator = it::ContiguousIterator<T, const_reference>;
+
+        Deque() noexcept(noexcept(Allocator())) : Deque(Allocator()) {}
+
+        explicit Deque(const Allocator &alloc) noexcept : _allocator(alloc), _map(map_allocator(alloc)) {}
+
+        // Delegating to Deque(alloc) makes the destructor free what was built if a push throws
+        Deque(size_type count, const T &value, const Allocator &alloc = Allocator()) : Deque(alloc) {
+            for (size_type i = 0; i < count; i++) {
+                push_back(value);
+            }
+        }
+
+        Deque(std::initializer_list<T> init, const Allocator &alloc = Allocator()) : Deque(init.begin(), init.end(), alloc) {}
+
+        template<std::input_iterator InputIt>
+        Deque(InputIt first, InputIt last, const Allocator &alloc = Allocator()) : Deque(alloc) {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+
+        Deque(const Deque &other) : Deque(other, alloc_traits::select_on_container_copy_construction(other._allocator)) {}
+
+        Deque(const Deque &other, const Allocator &alloc) : Deque(other.cbegin(), other.cend(), alloc) {}
+
+        Deque(Deque &&other) noexcept
+            : _allocator(std::move(other._allocator)), _map(std::move(other._map)), _front(other._front), _back(other._back) {
+            other._map.clear();
+            other._front = 0;
+            other._back = 0;
+        }
+
+        ~Deque() {
+            release();
+        }
+
+        auto at(size_type pos) -> reference {
+            if (pos >= size()) {
+                throw std::out_of_range("id is out of range");
+            }
+
+            return (*this)[pos];
+        }
+
+        auto at(size_type pos) const -> const_reference {
+            if (pos >= size()) {
+                throw std::out_of_range("id is out of range");
+            }
+
+            return (*this)[pos];
+        }
+
+        auto back() -> reference {
+            return *element_address(_back - 1);
+        }
+
+        auto back() const -> const_reference {
+            return *element_address(_back - 1);
+        }
+
+        auto begin() {
+            return iterator(this, _front);
+        }
+
+        auto begin() const {
+            return cbegin();
+        }
+
+        auto cbegin() const {
+            return const_iterator(this, _front);
+        }
+
+        auto cend() const {
+            return const_iterator(this, _back);
+        }
+
+        // Keeps the blocks for later pushes
+        void clear() {
+            for (auto position = _front; position < _back; position++) {
+                alloc_traits::destroy(_allocator, element_address(position));
+            }
+            _front = 0;
+            _back = 0;
+        }
+
+        template<typename... Args>
+        auto emplace_back(Args &&...args) -> reference {
+            auto *dest = prepare_slot(_back);
+            alloc_traits::construct(_allocator, dest, std::forward<Args>(args)...);
+            _back++;
+            return *dest;
+        }
+
+        template<typename... Args>
+        auto emplace_front(Args &&...args) -> reference {
+            auto *dest = prepare_slot(_front - 1);
+            alloc_traits::construct(_allocator, dest, std::forward<Args>(args)...);
+            _front--;
+            return *dest;
+        }
+
+        [[nodiscard]] auto empty() const {
+            return _front == _back;
+        }
+
+        auto end() {
+            return iterator(this, _back);
+        }
+
+        auto end() const {
+            return cend();
+        }
+
+        auto front() -> reference {
+            return *element_address(_front);
+        }
+
+        auto front() const -> const_reference {
+            return *element_address(_front);
+        }
+
+        auto get_allocator() const {
+            return _allocator;
+        }
+
+        auto operator=(const Deque &other) -> Deque & {
+            if (this == &other) {
+                return *this;
+            }
+
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                if (_allocator != other._allocator) {
+                    release();
+                }
+                _allocator = other._allocator;
+            }
+
+            clear();
+            for (const auto &value: other) {
+                push_back(value);
+            }
+            return *this;
+        }
+
+        auto operator=(Deque &&other) noexcept(alloc_traits::propagate_on_container_move_assignment::value or alloc_traits::is_always_equal::value) -> Deque & {
+            if (this == &other) {
+                return *this;
+            }
+
+            if (alloc_traits::propagate_on_container_move_assignment::value or _allocator == other._allocator) {
+                release();
+                if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                    _allocator = std::move(other._allocator);
+                }
+                _map = std::move(other._map);
+                other._map.clear();
+                _front = std::exchange(other._front, 0);
+                _back = std::exchange(other._back, 0);
+            } else {
+                // Blocks cannot change hands, so the elements move one by one
+                clear();
+                for (auto &value: other) {
+                    push_back(std::move(value));
+                }
+                other.clear();
+            }
+            return *this;
+        }
+
+        auto operator=(std::initializer_list<T> ilist) -> Deque & {
+            clear();
+            for (const auto &value: ilist) {
+                push_back(value);
+            }
+            return *this;
+        }
+
+        auto operator[](size_type pos) -> reference {
+            return *element_address(_front + static_cast<difference_type>(pos));
+        }
+
+        auto operator[](size_type pos) const -> const_reference {
+            return *element_address(_front + static_cast<difference_type>(pos));
+        }
+
+        void pop_back() {
+            _back--;
+            alloc_traits::destroy(_allocator, element_address(_back));
+        }
+
+        void pop_front() {
+            alloc_traits::destroy(_allocator, element_address(_front));
+            _front++;
+        }
+
+        void push_back(const T &value) {
+            emplace_back(value);
+        }
+
+        void push_back(T &&value) {
+            emplace_back(std::move(value));
+        }
+
+        void push_front(const T &value) {
+            emplace_front(value);
+        }
+
+        void push_front(T &&value) {
+            emplace_front(std::move(value));
+        }
+
+        // Number of blocks holding elements; see segment()
+        [[nodiscard]] auto segment_count() const -> size_type {
+            return empty() ? 0 : static_cast<size_type>(block_of(_back - 1) - block_of(_front) + 1);
+        }
+
+        // Elements stored in the i-th block in use, which are contiguous in memory
+        auto segment(size_type i) -> std::ranges::subrange<segment_iterator> {
+            const auto [first, last] = segment_bounds(i);
+            return {segment_iterator(element_address(first)), segment_iterator(element_address(first) + (last - first))}; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        auto segment(size_type i) const -> std::ranges::subrange<const_segment_iterator> {
+            const auto [first, last] = segment_bounds(i);
+            return {const_segment_iterator(element_address(first)), const_segment_iterator(element_address(first) + (last - first))}; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        // Frees the blocks that hold no element
+        void shrink_to_fit() {
+            for (size_type index = 0; index < _map.size(); index++) {
+                if (_map[index] != nullptr and not is_live(static_cast<difference_type>(index), _map.size())) {
+                    deallocate_block(_map[index]);
+                }
+            }
+        }
+
+        [[nodiscard]] auto size() const {
+            return static_cast<size_type>(_back - _front);
+        }
+
+    private:
+        template<typename, typename>
+        friend struct it::SegmentedIterator;
+
+        static constexpr auto BLOCK_SHIFT = std::countr_zero(BlockSize);
+        static constexpr auto OFFSET_MASK = static_cast<difference_type>(BlockSize - 1);
+        static constexpr size_type MIN_MAP_SIZE = 8;
+
+        [[no_unique_address]] Allocator _allocator;
+        // Ring of block pointers, a power of 2 in size; block b lives at b % _map.size()
+        Vector<T *, map_allocator> _map;
+        // Positions of the first element and one past the last; either may be negative
+        difference_type _front = 0;
+        difference_type _back = 0;
+
+        // Arithmetic shifts round towards minus infinity, as needed for negative positions
+        static auto block_of(difference_type position) -> difference_type {
+            return position >> BLOCK_SHIFT;
+        }
+
+        static auto map_index(difference_type block, size_type map_size) -> size_type {
+            return static_cast<size_type>(block) & (map_size - 1);
+        }
+
+        void deallocate_block(T *&block) {
+            alloc_traits::deallocate(_allocator, block, BlockSize);
+            block = nullptr;
+        }
+
+        auto element_address(difference_type position) const -> T * {
+            return _map[map_index(block_of(position), _map.size())] + (position & OFFSET_MASK); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        // Whether map entry index of a map_size ring belongs to a block holding elements
+        [[nodiscard]] auto is_live(difference_type index, size_type map_size) const -> bool {
+            if (empty()) {
+                return false;
+            }
+
+            const auto first = block_of(_front);
+            const auto offset = (index - first) & static_cast<difference_type>(map_size - 1);
+            return offset <= block_of(_back - 1) - first;
+        }
+
+        // Makes sure the block for position, which is about to receive an element, exists
+        auto prepare_slot(difference_type position) -> T * {
+            const auto first = empty() ? position : std::min(_front, position);
+            const auto last = empty() ? position : std::max(_back - 1, position);
+            const auto blocks = static_cast<size_type>(block_of(last) - block_of(first) + 1);
+            if (blocks > _map.size()) {
+                grow_map(blocks);
+            }
+
+            auto &block = _map[map_index(block_of(position), _map.size())];
+            if (block == nullptr) {
+                block = alloc_traits::allocate(_allocator, BlockSize);
+            }
+            return block + (position & OFFSET_MASK); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        // Moves the blocks in use to a larger ring, at the index their block number maps to there
+        void grow_map(size_type min_blocks) {
+            const auto new_size = std::max({MIN_MAP_SIZE, std::bit_ceil(min_blocks), 2 * _map.size()});
+            Vector<T *, map_allocator> new_map(new_size, nullptr, _map.get_allocator());
+            if (not empty()) {
+                for (auto block = block_of(_front); block <= block_of(_back - 1); block++) {
+                    auto &old_entry = _map[map_index(block, _map.size())];
+                    new_map[map_index(block, new_size)] = std::exchange(old_entry, nullptr);
+                }
+            }
+
+            for (auto &entry: _map) {
+                if (entry != nullptr) {
+                    deallocate_block(entry);
+                }
+            }
+            _map = std::move(new_map);
+        }
+
+        void release() {
+            clear();
+            for (auto &entry: _map) {
+                if (entry != nullptr) {
+                    deallocate_block(entry);
+                }
+            }
+            _map.clear();
+        }
+
+        [[nodiscard]] auto segment_bounds(size_type i) const -> std::pair<difference_type, difference_type> {
+            const auto block = block_of(_front) + static_cast<difference_type>(i);
+            return {std::max(_front, block << BLOCK_SHIFT), std::min(_back, (block + 1) << BLOCK_SHIFT)};
+        }
+    };
+
+    template<typename T, typename Allocator, types::size_t BlockSize>
+    auto operator==(const Deque<T, Allocator, BlockSize> &lhs, const Deque<T, Allocator, BlockSize> &rhs) {
+        return lhs.size() == rhs.size() and std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+    }
+} // namespace ds
+
+#endif //DS_DEQUE_HPP
@@ -0,0 +1,645 @@
+//
+// Created by santiago on 03.09.23.
+//
+
+#ifndef DS_FLAT_HASH_MAP_HPP
+#define DS_FLAT_HASH_MAP_HPP
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "key_arg.hpp"
+#include "type_definitions.hpp"
+
+namespace ds {
+
+    // Transparent hash for std::string keys, so that maps can be queried with string_views and
+    // literals without building a std::string. Pair it with std::equal_to<>.
+    struct StringHash {
+        using is_transparent [[maybe_unused]] = void;
+
+        auto operator()(std::string_view value) const noexcept -> std::size_t {
+            return std::hash<std::string_view>()(value);
+        }
+    };
+
+    namespace detail {
+        // Control byte of a slot: EMPTY, or the low 7 bits of the hash of its key
+        using ctrl_t = std::uint8_t;
+        constexpr ctrl_t EMPTY = 0x80;
+
+        // Spreads the entropy of weak hashes (std::hash of integers is the identity) over every bit
+        inline auto mix_hash(std::size_t hash) -> std::uint64_t {
+            auto mixed = static_cast<std::uint64_t>(hash);
+            mixed ^= mixed >> 32U;
+            mixed *= 0x9E3779B97F4A7C15ULL;
+            mixed ^= mixed >> 29U;
+            return mixed;
+        }
+
+        // Bit i set for each matching control byte i of a group
+        class GroupMask {
+        public:
+            explicit GroupMask(std::uint64_t bits) : _bits(bits) {}
+
+            explicit operator bool() const {
+                return _bits != 0;
+            }
+
+            [[nodiscard]] auto lowest() const -> int {
+                return std::countr_zero(_bits) / BITS_PER_BYTE;
+            }
+
+            void clear_lowest() {
+                _bits &= _bits - 1;
+            }
+
+        private:
+#if defined(__SSE2__)
+            static constexpr int BITS_PER_BYTE = 1;
+#else
+            static constexpr int BITS_PER_BYTE = 8;
+#endif
+            std::uint64_t _bits;
+        };
+
+        // Control bytes that are probed together: 16 with one SSE2 compare, otherwise 8 in a word
+        class Group {
+        public:
+#if defined(__SSE2__)
+            static constexpr int WIDTH = 16;
+
+            explicit Group(const ctrl_t *ctrl) : _bytes(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))) {} // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+            [[nodiscard]] auto match(ctrl_t h2) const -> GroupMask {
+                return GroupMask(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_bytes, _mm_set1_epi8(static_cast<char>(h2))))));
+            }
+
+            [[nodiscard]] auto match_empty() const -> GroupMask {
+                return GroupMask(static_cast<std::uint32_t>(_mm_movemask_epi8(_bytes)));
+            }
+
+        private:
+            __m128i _bytes;
+#else
+            static constexpr int WIDTH = 8;
+
+            explicit Group(const ctrl_t *ctrl) {
+                std::memcpy(&_word, ctrl, sizeof(_word));
+            }
+
+            // May report false positives, which the key comparison rules out
+            [[nodiscard]] auto match(ctrl_t h2) const -> GroupMask {
+                const auto x = _word ^ (LSBS * h2);
+                return GroupMask((x - LSBS) & ~x & MSBS);
+            }
+
+            [[nodiscard]] auto match_empty() const -> GroupMask {
+                return GroupMask(_word & MSBS);
+            }
+
+        private:
+            static constexpr std::uint64_t LSBS = 0x0101010101010101ULL;
+            static constexpr std::uint64_t MSBS = 0x8080808080808080ULL;
+            std::uint64_t _word = 0;
+#endif
+        };
+    } // namespace detail
+
+    // Hash map with open addressing over two flat arrays: one control byte per slot and the slots
+    // themselves. A control byte holds 7 bits of the hash of its key, so a lookup compares a whole
+    // group of them at once and only touches the slots whose bits match (as in Swiss tables).
+    // Probing is linear, one slot at a time, so erasing shifts the following elements of the cluster
+    // back instead of leaving tombstones, and lookups never wade through deleted entries.
+    // Hash and KeyEqual are used with other key types too when both declare is_transparent.
+    //
+    // Inserting may rehash, invalidating iterators and references. Erasing invalidates iterators and
+    // references to the erased element and to the elements that follow it in its cluster.
+    template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+             typename Allocator = std::allocator<std::pair<const K, V>>>
+    class FlatHashMap {
+        // Elements are stored with a mutable key, so that erasing can move them, and handed out as
+        // value_type, which has the same layout
+        using slot_type = std::pair<K, V>;
+        using slot_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<slot_type>;
+        using ctrl_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<detail::ctrl_t>;
+        using slot_traits = std::allocator_traits<slot_allocator>;
+        using ctrl_traits = std::allocator_traits<ctrl_allocator>;
+
+        static constexpr bool IS_TRANSPARENT = requires {
+            typename Hash::is_transparent;
+            typename KeyEqual::is_transparent;
+        };
+
+        // Lookup argument type: any Q with transparent Hash and KeyEqual, otherwise K
+        template<typename Q>
+        using key_arg = typename detail::KeyArg<IS_TRANSPARENT>::template type<Q, K>;
+
+        template<typename MapPointer, typename Reference>
+        class Iterator {
+        public:
+            using iterator_category [[maybe_unused]] = std::forward_iterator_tag;
+            using difference_type = types::ptrdiff_t;
+            using value_type = std::pair<const K, V>;
+            using pointer = std::add_pointer_t<Reference>;
+            using reference = Reference;
+
+            Iterator() = default;
+
+            Iterator(MapPointer map, types::size_t index) : _map(map), _index(index) {
+                skip_empty();
+            }
+
+            template<typename OtherPointer, typename OtherReference>
+                requires(not std::is_same_v<OtherReference, Reference> and std::is_convertible_v<OtherReference, Reference>)
+            Iterator(const Iterator<OtherPointer, OtherReference> &other) : _map(other.map()), _index(other.index()) {} // NOLINT(google-explicit-constructor)
+
+            reference operator*() const { return _map->element(_index); }
+
+            pointer operator->() const { return &_map->element(_index); }
+
+            Iterator &operator++() {
+                _index++;
+                skip_empty();
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            bool operator==(const Iterator &other) const { return _index == other._index; }
+
+            [[nodiscard]] auto map() const { return _map; }
+
+            [[nodiscard]] auto index() const { return _index; }
+
+        private:
+            MapPointer _map = nullptr;
+            types::size_t _index = 0;
+
+            void skip_empty() {
+                while (_index < _map->_capacity and _map->_ctrl[_index] == detail::EMPTY) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    _index++;
+                }
+            }
+        };
+
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = std::pair<const K, V>;
+        using size_type = types::size_t;
+        using difference_type = types::ptrdiff_t;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using allocator_type = Allocator;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using iterator = Iterator<FlatHashMap *, reference>;
+        using const_iterator = Iterator<const FlatHashMap *, const_reference>;
+
+        FlatHashMap() : FlatHashMap(0) {}
+
+        explicit FlatHashMap(size_type bucket_count, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual(), const Allocator &alloc = Allocator())
+            : _hash(hash), _equal(equal), _slot_allocator(alloc), _ctrl_allocator(alloc) {
+            reserve(bucket_count);
+        }
+
+        FlatHashMap(std::initializer_list<value_type> init) : FlatHashMap(init.size()) {
+            for (const auto &value: init) {
+                insert(value);
+            }
+        }
+
+        FlatHashMap(const FlatHashMap &other)
+            : _hash(other._hash), _equal(other._equal),
+              _slot_allocator(slot_traits::select_on_container_copy_construction(other._slot_allocator)),
+              _ctrl_allocator(ctrl_traits::select_on_container_copy_construction(other._ctrl_allocator)) {
+            reserve(other.size());
+            for (const auto &value: other) {
+                insert(value);
+            }
+        }
+
+        FlatHashMap(FlatHashMap &&other) noexcept
+            : _hash(std::move(other._hash)), _equal(std::move(other._equal)),
+              _slot_allocator(std::move(other._slot_allocator)), _ctrl_allocator(std::move(other._ctrl_allocator)),
+              _ctrl(std::exchange(other._ctrl, nullptr)), _slots(std::exchange(other._slots, nullptr)),
+              _capacity(std::exchange(other._capacity, 0)), _size(std::exchange(other._size, 0)) {}
+
+        ~FlatHashMap() {
+            release();
+        }
+
+        auto operator=(const FlatHashMap &other) -> FlatHashMap & {
+            if (this != &other) {
+                auto copy = other;
+                swap(copy);
+            }
+            return *this;
+        }
+
+        auto operator=(FlatHashMap &&other) noexcept -> FlatHashMap & {
+            if (this != &other) {
+                release();
+                swap(other);
+            }
+            return *this;
+        }
+
+        template<typename Q = K>
+        auto at(const key_arg<Q> &key) -> V & {
+            const auto index = find_index(key);
+            if (index == _capacity) {
+                throw std::out_of_range("Key not found");
+            }
+
+            return slot(index).second;
+        }
+
+        template<typename Q = K>
+        auto at(const key_arg<Q> &key) const -> const V & {
+            return const_cast<FlatHashMap *>(this)->at(key); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+        }
+
+        auto begin() {
+            return iterator(this, 0);
+        }
+
+        auto begin() const {
+            return cbegin();
+        }
+
+        // Number of slots; the map rehashes before more than 7/8 of them are full
+        [[nodiscard]] auto capacity() const {
+            return _capacity;
+        }
+
+        auto cbegin() const {
+            return const_iterator(this, 0);
+        }
+
+        auto cend() const {
+            return const_iterator(this, _capacity);
+        }
+
+        void clear() {
+            for (size_type i = 0; i < _capacity; i++) {
+                if (_ctrl[i] != detail::EMPTY) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    slot_traits::destroy(_slot_allocator, &slot(i));
+                }
+            }
+            if (_ctrl != nullptr) {
+                std::fill_n(_ctrl, ctrl_bytes(_capacity), detail::EMPTY);
+            }
+            _size = 0;
+        }
+
+        template<typename Q = K>
+        [[nodiscard]] auto contains(const key_arg<Q> &key) const -> bool {
+            return find_index(key) != _capacity;
+        }
+
+        template<typename Q = K>
+        [[nodiscard]] auto count(const key_arg<Q> &key) const -> size_type {
+            return contains(key) ? 1 : 0;
+        }
+
+        template<typename... Args>
+        auto emplace(Args &&...args) -> std::pair<iterator, bool> {
+            slot_type value(std::forward<Args>(args)...);
+            return try_emplace(std::move(value.first), std::move(value.second));
+        }
+
+        [[nodiscard]] auto empty() const {
+            return _size == 0;
+        }
+
+        auto end() {
+            return iterator(this, _capacity);
+        }
+
+        auto end() const {
+            return cend();
+        }
+
+        // Returns the iterator to the element that now comes next. The element shifted back into the
+        // erased slot may come from the wrapped-around start of the table, in which case iterating on
+        // visits it again; erase_if() never does.
+        auto erase(const_iterator pos) -> iterator {
+            erase_at(pos.index());
+            return iterator(this, pos.index());
+        }
+
+        template<typename Q = K>
+        auto erase(const key_arg<Q> &key) -> size_type {
+            const auto index = find_index(key);
+            if (index == _capacity) {
+                return 0;
+            }
+
+            erase_at(index);
+            return 1;
+        }
+
+        template<typename Q = K>
+        auto find(const key_arg<Q> &key) -> iterator {
+            return iterator(this, find_index(key));
+        }
+
+        template<typename Q = K>
+        auto find(const key_arg<Q> &key) const -> const_iterator {
+            return const_iterator(this, find_index(key));
+        }
+
+        auto get_allocator() const {
+            return Allocator(_slot_allocator);
+        }
+
+        auto insert(const value_type &value) -> std::pair<iterator, bool> {
+            return try_emplace(value.first, value.second);
+        }
+
+        auto insert(value_type &&value) -> std::pair<iterator, bool> {
+            return try_emplace(value.first, std::move(value.second));
+        }
+
+        template<typename M>
+        auto insert_or_assign(const K &key, M &&value) -> std::pair<iterator, bool> {
+            auto result = try_emplace(key, std::forward<M>(value));
+            if (not result.second) {
+                result.first->second = std::forward<M>(value);
+            }
+            return result;
+        }
+
+        [[nodiscard]] auto load_factor() const -> float {
+            return _capacity == 0 ? 0.0F : static_cast<float>(_size) / static_cast<float>(_capacity);
+        }
+
+        auto operator[](const K &key) -> V & {
+            return try_emplace(key).first->second;
+        }
+
+        auto operator[](K &&key) -> V & {
+            return try_emplace(std::move(key)).first->second;
+        }
+
+        // Makes room for count elements without rehashing
+        void reserve(size_type count) {
+            if (count <= max_size_for(_capacity)) {
+                return;
+            }
+
+            auto new_capacity = std::max<size_type>(MIN_CAPACITY, std::bit_ceil(count));
+            while (count > max_size_for(new_capacity)) {
+                new_capacity *= 2;
+            }
+            rehash(new_capacity);
+        }
+
+        [[nodiscard]] auto size() const {
+            return _size;
+        }
+
+        void swap(FlatHashMap &other) noexcept {
+            using std::swap;
+            swap(_hash, other._hash);
+            swap(_equal, other._equal);
+            swap(_slot_allocator, other._slot_allocator);
+            swap(_ctrl_allocator, other._ctrl_allocator);
+            swap(_ctrl, other._ctrl);
+            swap(_slots, other._slots);
+            swap(_capacity, other._capacity);
+            swap(_size, other._size);
+        }
+
+        template<typename Key, typename... Args>
+        auto try_emplace(Key &&key, Args &&...args) -> std::pair<iterator, bool> {
+            const auto hash = hash_of(key);
+            if (auto index = find_index(key, hash); index != _capacity) {
+                return {iterator(this, index), false};
+            }
+
+            if (_size + 1 > max_size_for(_capacity)) {
+                reserve(std::max<size_type>(_size + 1, 2 * _size));
+            }
+
+            const auto index = first_empty(hash);
+            slot_traits::construct(_slot_allocator, &slot(index), std::piecewise_construct,
+                                   std::forward_as_tuple(std::forward<Key>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+            set_ctrl(index, h2(hash));
+            _size++;
+            return {iterator(this, index), true};
+        }
+
+        // Erases every element for which pred(element) holds; returns how many
+        template<typename Pred>
+        friend auto erase_if(FlatHashMap &map, Pred pred) -> size_type {
+            if (map.empty()) {
+                return 0;
+            }
+
+            // Starting right after an empty slot, elements only ever shift back onto slots already
+            // checked in this pass or onto the current one, so each element is checked exactly once
+            size_type start = 0;
+            while (map._ctrl[(start + map._capacity - 1) & map.mask()] != detail::EMPTY) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                start++;
+            }
+
+            size_type erased = 0;
+            for (size_type step = 0; step < map._capacity;) {
+                const auto index = (start + step) & map.mask();
+                if (map._ctrl[index] != detail::EMPTY and pred(std::as_const(map.element(index)))) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    map.erase_at(index);
+                    erased++;
+                } else {
+                    step++;
+                }
+            }
+            return erased;
+        }
+
+    private:
+        static constexpr size_type MIN_CAPACITY = 16;
+        static_assert(MIN_CAPACITY >= detail::Group::WIDTH, "Mirrored control bytes must not wrap more than once");
+
+        [[no_unique_address]] Hash _hash;
+        [[no_unique_address]] KeyEqual _equal;
+        [[no_unique_address]] slot_allocator _slot_allocator;
+        [[no_unique_address]] ctrl_allocator _ctrl_allocator;
+        // _capacity bytes followed by a copy of the first WIDTH - 1, so that any group can be loaded
+        // without wrapping around
+        detail::ctrl_t *_ctrl = nullptr;
+        slot_type *_slots = nullptr;
+        size_type _capacity = 0;
+        size_type _size = 0;
+
+        static auto ctrl_bytes(size_type capacity) -> size_type {
+            return capacity + detail::Group::WIDTH - 1;
+        }
+
+        static auto max_size_for(size_type capacity) -> size_type {
+            return capacity - capacity / 8;
+        }
+
+        static auto h2(std::uint64_t hash) -> detail::ctrl_t {
+            return static_cast<detail::ctrl_t>(hash & 0x7FU);
+        }
+
+        [[nodiscard]] auto mask() const -> size_type {
+            return _capacity - 1;
+        }
+
+        [[nodiscard]] auto home(std::uint64_t hash) const -> size_type {
+            return static_cast<size_type>(hash >> 7U) & mask();
+        }
+
+        template<typename Q>
+        [[nodiscard]] auto hash_of(const Q &key) const -> std::uint64_t {
+            return detail::mix_hash(_hash(key));
+        }
+
+        auto slot(size_type index) const -> slot_type & {
+            return _slots[index]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        auto element(size_type index) const -> value_type & {
+            return *std::launder(reinterpret_cast<value_type *>(&slot(index))); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        }
+
+        void set_ctrl(size_type index, detail::ctrl_t value) {
+            _ctrl[index] = value; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            if (index < detail::Group::WIDTH - 1) {
+                _ctrl[_capacity + index] = value; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        }
+
+        template<typename Q>
+        [[nodiscard]] auto find_index(const Q &key) const -> size_type {
+            return find_index(key, hash_of(key));
+        }
+
+        // Index of the slot holding key, or _capacity if there is none
+        template<typename Q>
+        [[nodiscard]] auto find_index(const Q &key, std::uint64_t hash) const -> size_type {
+            if (_capacity == 0) {
+                return _capacity;
+            }
+
+            for (auto position = home(hash);; position = (position + detail::Group::WIDTH) & mask()) {
+                const detail::Group group(_ctrl + position); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                for (auto matches = group.match(h2(hash)); matches; matches.clear_lowest()) {
+                    const auto index = (position + static_cast<size_type>(matches.lowest())) & mask();
+                    if (_equal(slot(index).first, key)) {
+                        return index;
+                    }
+                }
+                // Linear probing never leaves a gap between an element and its home slot
+                if (group.match_empty()) {
+                    return _capacity;
+                }
+            }
+        }
+
+        [[nodiscard]] auto first_empty(std::uint64_t hash) const -> size_type {
+            for (auto position = home(hash);; position = (position + detail::Group::WIDTH) & mask()) {
+                const detail::Group group(_ctrl + position); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                if (const auto empties = group.match_empty()) {
+                    return (position + static_cast<size_type>(empties.lowest())) & mask();
+                }
+            }
+        }
+
+        // Removes the element at index and shifts back every later element of its cluster that may
+        // move closer to its home slot, so that no element is left behind an empty slot
+        void erase_at(size_type index) {
+            slot_traits::destroy(_slot_allocator, &slot(index));
+            auto hole = index;
+            for (auto next = (hole + 1) & mask(); _ctrl[next] != detail::EMPTY; next = (next + 1) & mask()) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                const auto next_home = home(hash_of(slot(next).first));
+                // The element may fill the hole unless its home lies after the hole, up to next
+                if (((next - next_home) & mask()) >= ((next - hole) & mask())) {
+                    slot_traits::construct(_slot_allocator, &slot(hole), std::move(slot(next)));
+                    slot_traits::destroy(_slot_allocator, &slot(next));
+                    set_ctrl(hole, _ctrl[next]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    hole = next;
+                }
+            }
+            set_ctrl(hole, detail::EMPTY);
+            _size--;
+        }
+
+        void rehash(size_type new_capacity) {
+            auto *new_ctrl = ctrl_traits::allocate(_ctrl_allocator, ctrl_bytes(new_capacity));
+            slot_type *new_slots;
+            try {
+                new_slots = slot_traits::allocate(_slot_allocator, new_capacity);
+            } catch (...) {
+                ctrl_traits::deallocate(_ctrl_allocator, new_ctrl, ctrl_bytes(new_capacity));
+                throw;
+            }
+            std::fill_n(new_ctrl, ctrl_bytes(new_capacity), detail::EMPTY);
+
+            FlatHashMap fresh(0, _hash, _equal, get_allocator());
+            fresh._ctrl = new_ctrl;
+            fresh._slots = new_slots;
+            fresh._capacity = new_capacity;
+            // Elements are moved only if that cannot throw, so a failure leaves this map intact
+            for (size_type i = 0; i < _capacity; i++) {
+                if (_ctrl[i] != detail::EMPTY) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    const auto hash = hash_of(slot(i).first);
+                    const auto index = fresh.first_empty(hash);
+                    slot_traits::construct(fresh._slot_allocator, &fresh.slot(index), std::move_if_noexcept(slot(i)));
+                    fresh.set_ctrl(index, h2(hash));
+                    fresh._size++;
+                }
+            }
+            swap(fresh);
+        }
+
+        void release() {
+            clear();
+            if (_ctrl != nullptr) {
+                ctrl_traits::deallocate(_ctrl_allocator, _ctrl, ctrl_bytes(_capacity));
+                slot_traits::deallocate(_slot_allocator, _slots, _capacity);
+            }
+            _ctrl = nullptr;
+            _slots = nullptr;
+            _capacity = 0;
+        }
+    };
+
+    template<typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
+    auto operator==(const FlatHashMap<K, V, Hash, KeyEqual, Allocator> &lhs, const FlatHashMap<K, V, Hash, KeyEqual, Allocator> &rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+
+        return std::all_of(lhs.cbegin(), lhs.cend(), [&rhs](const auto &entry) {
+            const auto it = rhs.find(entry.first);
+            return it != rhs.cend() and it->second == entry.second;
+        });
+    }
+} // namespace ds
+
+#endif //DS_FLAT_HASH_MAP_HPP
@@ -0,0 +1,367 @@
+//
+// Created by santiago on 10.09.23.
+//
+
+#ifndef DS_FLAT_MAP_HPP
+#define DS_FLAT_MAP_HPP
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "key_arg.hpp"
+#include "sorted_keys.hpp"
+#include "type_definitions.hpp"
+#include "vector.hpp"
+
+namespace ds {
+
+    // Map over two parallel vectors, keys in sorted order and the values at the same positions, so
+    // lookups scan nothing but keys. Inserting or erasing shifts the elements after the position,
+    // which makes it a fit for tables built in bulk and then mostly queried.
+    template<typename Key, typename T, typename Compare = std::less<Key>, SearchLayout Layout = SearchLayout::sorted>
+    class FlatMap {
+        static constexpr bool transparent = requires { typename Compare::is_transparent; };
+
+        template<typename Q>
+        using key_arg = typename detail::KeyArg<transparent>::template type<Q, Key>;
+
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<Key, T>;
+        using size_type = types::size_t;
+        using difference_type = types::ptrdiff_t;
+        using key_compare = Compare;
+        using reference = std::pair<const Key &, T &>;
+        using const_reference = std::pair<const Key &, const T &>;
+
+        // Random access iterator over entries, dereferencing to a pair of references
+        template<typename Container, typename Reference>
+        struct EntryIterator {
+            // Keeps the pair of references alive for operator->, as there is no stored pair to point to
+            struct ArrowProxy {
+                Reference entry;
+
+                auto operator->() const -> const Reference * { return &entry; }
+            };
+
+            using iterator_category = std::random_access_iterator_tag;
+            using difference_type = types::ptrdiff_t;
+            using value_type = std::pair<Key, T>;
+            using pointer = ArrowProxy;
+            using reference = Reference;
+
+            EntryIterator() = default;
+
+            EntryIterator(Container *container, size_type pos) : _container(container), _pos(pos) {}
+
+            template<typename OtherContainer, typename OtherReference>
+                requires(not std::is_same_v<OtherContainer, Container> and std::is_convertible_v<OtherContainer *, Container *>)
+            EntryIterator(const EntryIterator<OtherContainer, OtherReference> &other) : _container(other._container), _pos(other._pos) {} // NOLINT(google-explicit-constructor)
+
+            reference operator*() const { return _container->entry(_pos); }
+
+            pointer operator->() const { return ArrowProxy{**this}; }
+
+            reference operator[](difference_type offset) const { return _container->entry(_pos + offset); }
+
+            EntryIterator &operator++() {
+                _pos++;
+                return *this;
+            }
+
+            EntryIterator operator++(int) {
+                EntryIterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            EntryIterator &operator--() {
+                _pos--;
+                return *this;
+            }
+
+            EntryIterator operator--(int) {
+                EntryIterator tmp = *this;
+                --(*this);
+                return tmp;
+            }
+
+            EntryIterator &operator+=(difference_type offset) {
+                _pos += offset;
+                return *this;
+            }
+
+            EntryIterator &operator-=(difference_type offset) {
+                _pos -= offset;
+                return *this;
+            }
+
+            EntryIterator operator+(difference_type offset) const { return EntryIterator(_container, _pos + offset); }
+
+            friend EntryIterator operator+(difference_type offset, const EntryIterator &other) { return other + offset; }
+
+            EntryIterator operator-(difference_type offset) const { return EntryIterator(_container, _pos - offset); }
+
+            difference_type operator-(const EntryIterator &other) const {
+                return static_cast<difference_type>(_pos) - static_cast<difference_type>(other._pos);
+            }
+
+            bool operator==(const EntryIterator &other) const { return _pos == other._pos; }
+
+            auto operator<=>(const EntryIterator &other) const { return _pos <=> other._pos; }
+
+            [[nodiscard]] auto position() const -> size_type { return _pos; }
+
+        private:
+            template<typename, typename>
+            friend struct EntryIterator;
+
+            Container *_container = nullptr;
+            size_type _pos = 0;
+        };
+
+        using iterator = EntryIterator<FlatMap, reference>;
+        using const_iterator = EntryIterator<const FlatMap, const_reference>;
+
+        FlatMap() : FlatMap(Compare()) {}
+
+        explicit FlatMap(const Compare &compare) : _keys(compare) {}
+
+        // Takes keys and values in any order, at matching positions. They are sorted once, and of
+        // equivalent keys only the first one is kept.
+        FlatMap(Vector<Key> keys, Vector<T> values, const Compare &compare = Compare()) : _keys(compare) {
+            if (keys.size() != values.size()) {
+                throw std::invalid_argument("Keys and values differ in size");
+            }
+
+            const auto order = detail::SortedKeys<Key, Compare, Layout>::sorted_unique_order(keys, compare);
+            Vector<Key> sorted_keys;
+            sorted_keys.reserve(order.size());
+            _values.reserve(order.size());
+            for (size_type i = 0; i < order.size(); i++) {
+                sorted_keys.push_back(std::move(keys[order[i]]));
+                _values.push_back(std::move(values[order[i]]));
+            }
+            _keys.assign_sorted(std::move(sorted_keys));
+        }
+
+        // Takes (key, value) pairs in any order; as above, only the first of equivalent keys is kept
+        template<std::input_iterator InputIt>
+        FlatMap(InputIt first, InputIt last, const Compare &compare = Compare()) : FlatMap(split(first, last), compare) {}
+
+        FlatMap(std::initializer_list<value_type> init, const Compare &compare = Compare()) : FlatMap(init.begin(), init.end(), compare) {}
+
+        template<typename Q = Key>
+        auto at(const key_arg<Q> &key) -> T & {
+            const auto pos = _keys.find(key);
+            if (pos == size()) {
+                throw std::out_of_range("Key not found");
+            }
+
+            return _values[pos];
+        }
+
+        template<typename Q = Key>
+        auto at(const key_arg<Q> &key) const -> const T & {
+            const auto pos = _keys.find(key);
+            if (pos == size()) {
+                throw std::out_of_range("Key not found");
+            }
+
+            return _values[pos];
+        }
+
+        auto begin() {
+            return iterator(this, 0);
+        }
+
+        auto begin() const {
+            return cbegin();
+        }
+
+        auto cbegin() const {
+            return const_iterator(this, 0);
+        }
+
+        auto cend() const {
+            return const_iterator(this, size());
+        }
+
+        void clear() {
+            _keys.clear();
+            _values.clear();
+        }
+
+        template<typename Q = Key>
+        [[nodiscard]] auto contains(const key_arg<Q> &key) const -> bool {
+            return _keys.find(key) != size();
+        }
+
+        template<typename Q = Key>
+        [[nodiscard]] auto count(const key_arg<Q> &key) const -> size_type {
+            return contains<Q>(key) ? 1 : 0;
+        }
+
+        [[nodiscard]] auto empty() const -> bool {
+            return size() == 0;
+        }
+
+        auto end() {
+            return iterator(this, size());
+        }
+
+        auto end() const {
+            return cend();
+        }
+
+        auto erase(const_iterator pos) -> iterator {
+            const auto index = pos.position();
+            _keys.erase(index);
+            _values.erase(_values.cbegin() + static_cast<difference_type>(index));
+            return iterator(this, index);
+        }
+
+        template<typename Q = Key>
+        auto erase(const key_arg<Q> &key) -> size_type {
+            const auto pos = _keys.find(key);
+            if (pos == size()) {
+                return 0;
+            }
+
+            erase(const_iterator(this, pos));
+            return 1;
+        }
+
+        template<typename Q = Key>
+        auto find(const key_arg<Q> &key) -> iterator {
+            return iterator(this, _keys.find(key));
+        }
+
+        template<typename Q = Key>
+        auto find(const key_arg<Q> &key) const -> const_iterator {
+            return const_iterator(this, _keys.find(key));
+        }
+
+        auto insert(const value_type &value) -> std::pair<iterator, bool> {
+            return try_emplace(value.first, value.second);
+        }
+
+        auto insert(value_type &&value) -> std::pair<iterator, bool> {
+            return try_emplace(std::move(value.first), std::move(value.second));
+        }
+
+        template<typename M>
+        auto insert_or_assign(const Key &key, M &&value) -> std::pair<iterator, bool> {
+            auto [it, inserted] = try_emplace(key, std::forward<M>(value));
+            if (not inserted) {
+                _values[it.position()] = std::forward<M>(value);
+            }
+            return {it, inserted};
+        }
+
+        [[nodiscard]] auto key_comp() const -> const Compare & {
+            return _keys.compare();
+        }
+
+        // Sorted keys, contiguous so they can be scanned or searched on their own
+        [[nodiscard]] auto keys() const -> std::span<const Key> {
+            return std::span(_keys.keys().data(), size());
+        }
+
+        template<typename Q = Key>
+        auto lower_bound(const key_arg<Q> &key) -> iterator {
+            return iterator(this, _keys.lower_bound(key));
+        }
+
+        template<typename Q = Key>
+        auto lower_bound(const key_arg<Q> &key) const -> const_iterator {
+            return const_iterator(this, _keys.lower_bound(key));
+        }
+
+        auto operator[](const Key &key) -> T & {
+            return _values[try_emplace(key).first.position()];
+        }
+
+        auto operator[](Key &&key) -> T & {
+            return _values[try_emplace(std::move(key)).first.position()];
+        }
+
+        void reserve(size_type new_cap) {
+            _keys.reserve(new_cap);
+            _values.reserve(new_cap);
+        }
+
+        void shrink_to_fit() {
+            _keys.shrink_to_fit();
+            _values.shrink_to_fit();
+        }
+
+        [[nodiscard]] auto size() const -> size_type {
+            return _keys.size();
+        }
+
+        template<typename K, typename... Args>
+            requires std::is_constructible_v<Key, K &&>
+        auto try_emplace(K &&key, Args &&...args) -> std::pair<iterator, bool> {
+            const auto pos = _keys.lower_bound(key);
+            if (pos < size() and not key_comp()(key, _keys.keys()[pos])) {
+                return {iterator(this, pos), false};
+            }
+
+            _keys.emplace(pos, std::forward<K>(key));
+            try {
+                _values.emplace(_values.cbegin() + static_cast<difference_type>(pos), std::forward<Args>(args)...);
+            } catch (...) {
+                _keys.erase(pos);
+                throw;
+            }
+            return {iterator(this, pos), true};
+        }
+
+        // Values in key order
+        auto values() -> std::span<T> {
+            return std::span(_values.data(), size());
+        }
+
+        auto values() const -> std::span<const T> {
+            return std::span(_values.data(), size());
+        }
+
+    private:
+        detail::SortedKeys<Key, Compare, Layout> _keys;
+        Vector<T> _values;
+
+        template<typename, typename>
+        friend struct EntryIterator;
+
+        FlatMap(std::pair<Vector<Key>, Vector<T>> &&entries, const Compare &compare)
+            : FlatMap(std::move(entries.first), std::move(entries.second), compare) {}
+
+        template<std::input_iterator InputIt>
+        static auto split(InputIt first, InputIt last) -> std::pair<Vector<Key>, Vector<T>> {
+            std::pair<Vector<Key>, Vector<T>> entries;
+            for (; first != last; ++first) {
+                const auto &[key, value] = *first;
+                entries.first.push_back(key);
+                entries.second.push_back(value);
+            }
+            return entries;
+        }
+
+        auto entry(size_type pos) -> reference {
+            return reference(_keys.keys()[pos], _values[pos]);
+        }
+
+        auto entry(size_type pos) const -> const_reference {
+            return const_reference(_keys.keys()[pos], _values[pos]);
+        }
+    };
+} // namespace ds
+
+#endif //DS_FLAT_MAP_HPP
@@ -0,0 +1,166 @@
+//
+// Created by santiago on 10.09.23.
+//
+
+#ifndef DS_FLAT_SET_HPP
+#define DS_FLAT_SET_HPP
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <utility>
+
+#include "contiguous_iterator.hpp"
+#include "key_arg.hpp"
+#include "sorted_keys.hpp"
+#include "type_definitions.hpp"
+#include "vector.hpp"
+
+namespace ds {
+
+    // Set kept as a sorted vector of keys; see FlatMap
+    template<typename Key, typename Compare = std::less<Key>, SearchLayout Layout = SearchLayout::sorted>
+    class FlatSet {
+        static constexpr bool transparent = requires { typename Compare::is_transparent; };
+
+        template<typename Q>
+        using key_arg = typename detail::KeyArg<transparent>::template type<Q, Key>;
+
+    public:
+        using key_type = Key;
+        using value_type = Key;
+        using size_type = types::size_t;
+        using difference_type = types::ptrdiff_t;
+        using key_compare = Compare;
+        using reference = const Key &;
+        using const_reference = const Key &;
+        // Keys cannot be modified in place, as that could break their order
+        using iterator = it::ContiguousIterator<const Key, const Key &>;
+        using const_iterator = iterator;
+
+        FlatSet() : FlatSet(Compare()) {}
+
+        explicit FlatSet(const Compare &compare) : _keys(compare) {}
+
+        // Takes keys in any order. They are sorted once, and of equivalent keys only the first one is kept.
+        explicit FlatSet(Vector<Key> keys, const Compare &compare = Compare()) : _keys(compare) {
+            const auto order = detail::SortedKeys<Key, Compare, Layout>::sorted_unique_order(keys, compare);
+            Vector<Key> sorted_keys;
+            sorted_keys.reserve(order.size());
+            for (size_type i = 0; i < order.size(); i++) {
+                sorted_keys.push_back(std::move(keys[order[i]]));
+            }
+            _keys.assign_sorted(std::move(sorted_keys));
+        }
+
+        template<std::input_iterator InputIt>
+        FlatSet(InputIt first, InputIt last, const Compare &compare = Compare()) : FlatSet(Vector<Key>(first, last), compare) {}
+
+        FlatSet(std::initializer_list<Key> init, const Compare &compare = Compare()) : FlatSet(init.begin(), init.end(), compare) {}
+
+        auto begin() const {
+            return iterator(_keys.keys().data());
+        }
+
+        auto cbegin() const {
+            return begin();
+        }
+
+        auto cend() const {
+            return end();
+        }
+
+        void clear() {
+            _keys.clear();
+        }
+
+        template<typename Q = Key>
+        [[nodiscard]] auto contains(const key_arg<Q> &key) const -> bool {
+            return _keys.find(key) != size();
+        }
+
+        template<typename Q = Key>
+        [[nodiscard]] auto count(const key_arg<Q> &key) const -> size_type {
+            return contains<Q>(key) ? 1 : 0;
+        }
+
+        [[nodiscard]] auto empty() const -> bool {
+            return size() == 0;
+        }
+
+        auto end() const {
+            return begin() + static_cast<difference_type>(size());
+        }
+
+        auto erase(const_iterator pos) -> iterator {
+            const auto index = pos - begin();
+            _keys.erase(static_cast<size_type>(index));
+            return begin() + index;
+        }
+
+        template<typename Q = Key>
+        auto erase(const key_arg<Q> &key) -> size_type {
+            const auto pos = _keys.find(key);
+            if (pos == size()) {
+                return 0;
+            }
+
+            _keys.erase(pos);
+            return 1;
+        }
+
+        template<typename Q = Key>
+        auto find(const key_arg<Q> &key) const -> iterator {
+            return begin() + static_cast<difference_type>(_keys.find(key));
+        }
+
+        auto insert(const Key &key) -> std::pair<iterator, bool> {
+            return emplace_key(key);
+        }
+
+        auto insert(Key &&key) -> std::pair<iterator, bool> {
+            return emplace_key(std::move(key));
+        }
+
+        [[nodiscard]] auto key_comp() const -> const Compare & {
+            return _keys.compare();
+        }
+
+        [[nodiscard]] auto keys() const -> std::span<const Key> {
+            return std::span(_keys.keys().data(), size());
+        }
+
+        template<typename Q = Key>
+        auto lower_bound(const key_arg<Q> &key) const -> iterator {
+            return begin() + static_cast<difference_type>(_keys.lower_bound(key));
+        }
+
+        void reserve(size_type new_cap) {
+            _keys.reserve(new_cap);
+        }
+
+        void shrink_to_fit() {
+            _keys.shrink_to_fit();
+        }
+
+        [[nodiscard]] auto size() const -> size_type {
+            return _keys.size();
+        }
+
+    private:
+        detail::SortedKeys<Key, Compare, Layout> _keys;
+
+        template<typename K>
+        auto emplace_key(K &&key) -> std::pair<iterator, bool> {
+            const auto pos = _keys.lower_bound(key);
+            const auto inserted = pos == size() or key_comp()(key, _keys.keys()[pos]);
+            if (inserted) {
+                _keys.emplace(pos, std::forward<K>(key));
+            }
+            return {begin() + static_cast<difference_type>(pos), inserted};
+        }
+    };
+} // namespace ds
+
+#endif //DS_FLAT_SET_HPP
@@ -0,0 +1,75 @@
+//
+// Created by santiago on 25.06.23.
+//
+
+#ifndef DS_GROWTH_POLICY_HPP
+#define DS_GROWTH_POLICY_HPP
+
+#include <algorithm>
+#include <bit>
+
+#include "type_definitions.hpp"
+
+namespace ds {
+
+    // A growth policy decides the capacity a container moves to once it runs out of space. It must
+    // provide next_capacity(current, required, element_size), returning a value >= required.
+
+    // Grows geometrically by Numerator / Denominator, never going below MinCapacity elements
+    template<types::size_t Numerator, types::size_t Denominator, types::size_t MinCapacity = 1>
+    struct FactorGrowth {
+        static_assert(Numerator > Denominator, "Growth factor must be larger than 1");
+
+        static constexpr auto next_capacity(types::size_t current, types::size_t required, types::size_t /*element_size*/) -> types::size_t {
+            const types::size_t grown = current + std::max<types::size_t>(current * (Numerator - Denominator) / Denominator, 1);
+            return std::max({grown, required, MinCapacity});
+        }
+    };
+
+    template<types::size_t MinCapacity = 1>
+    using DoublingGrowth = FactorGrowth<2, 1, MinCapacity>;
+
+    // Less memory wasted on large containers, and freed blocks can eventually be reused for growing
+    template<types::size_t MinCapacity = 1>
+    using OneAndAHalfGrowth = FactorGrowth<3, 2, MinCapacity>;
+
+    // Rounds the block size up to the next allocator size class (four classes per power of two, as
+    // jemalloc and tcmalloc do), so the slack the allocator hands out anyway becomes usable capacity
+    template<typename BasePolicy = DoublingGrowth<>>
+    struct SizeClassGrowth {
+        static constexpr types::size_t MIN_CLASS_BYTES = 16;
+
+        static constexpr auto round_to_size_class(types::size_t bytes) -> types::size_t {
+            if (bytes <= MIN_CLASS_BYTES) {
+                return MIN_CLASS_BYTES;
+            }
+
+            const auto group_bits = std::bit_width(bytes - 1);
+            const types::size_t spacing = types::size_t{1} << (group_bits - 3);
+            return (bytes + spacing - 1) / spacing * spacing;
+        }
+
+        static constexpr auto next_capacity(types::size_t current, types::size_t required, types::size_t element_size) -> types::size_t {
+            const auto capacity = BasePolicy::next_capacity(current, required, element_size);
+            return round_to_size_class(capacity * element_size) / element_size;
+        }
+    };
+
+    // Once a block spans more than one page, rounds it up to whole pages (e.g. 2 MiB for huge pages)
+    template<types::size_t PageSize = 4096, typename BasePolicy = OneAndAHalfGrowth<>>
+    struct PageGrowth {
+        static_assert(std::has_single_bit(PageSize), "Page size must be a power of 2");
+
+        static constexpr auto next_capacity(types::size_t current, types::size_t required, types::size_t element_size) -> types::size_t {
+            const auto capacity = BasePolicy::next_capacity(current, required, element_size);
+            const auto bytes = capacity * element_size;
+            if (bytes <= PageSize) {
+                return capacity;
+            }
+
+            return ((bytes + PageSize - 1) & ~(PageSize - 1)) / element_size;
+        }
+    };
+} // namespace ds
+
+#endif //DS_GROWTH_POLICY_HPP
@@ -0,0 +1,40 @@
+//
+// Created by santiago on 18.06.23.
+//
+
+#ifndef DS_INLINE_BUFFER_HPP
+#define DS_INLINE_BUFFER_HPP
+
+#include <cstddef>
+
+#include "type_definitions.hpp"
+
+namespace ds::detail {
+
+    // Uninitialized, suitably aligned storage for Capacity elements of T living inside the owning object
+    template<typename T, types::size_t Capacity>
+    struct InlineBuffer {
+        constexpr auto data() -> T * {
+            return reinterpret_cast<T *>(_bytes); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        }
+
+        constexpr auto data() const -> const T * {
+            return reinterpret_cast<const T *>(_bytes); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        }
+
+        alignas(T) std::byte _bytes[Capacity * sizeof(T)]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    };
+
+    template<typename T>
+    struct InlineBuffer<T, 0> {
+        constexpr auto data() -> T * {
+            return nullptr;
+        }
+
+        constexpr auto data() const -> const T * {
+            return nullptr;
+        }
+    };
+} // namespace ds::detail
+
+#endif //DS_INLINE_BUFFER_HPP
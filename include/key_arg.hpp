@@ -0,0 +1,26 @@
+//
+// Created by santiago on 03.09.23.
+//
+
+#ifndef DS_KEY_ARG_HPP
+#define DS_KEY_ARG_HPP
+
+namespace ds::detail {
+
+    // Argument type of associative lookups: Q itself when the container's hash and comparison are
+    // transparent, otherwise Key. Used as KeyArg<transparent>::type<Q, Key>, Q stays deducible in the
+    // first case and defaults to Key in the second, so plain lookups still convert to Key.
+    template<bool Transparent>
+    struct KeyArg {
+        template<typename Q, typename Key>
+        using type = Key;
+    };
+
+    template<>
+    struct KeyArg<true> {
+        template<typename Q, typename Key>
+        using type = Q;
+    };
+} // namespace ds::detail
+
+#endif //DS_KEY_ARG_HPP
@@ -0,0 +1,56 @@
+//
+// Created by santiago on 12.06.23.
+//
+
+#ifndef DS_MALLOC_ALLOCATOR_HPP
+#define DS_MALLOC_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+namespace ds {
+
+    // Allocator backed by malloc/realloc/free. Containers holding trivially relocatable elements
+    // grow through realloc(), which can often extend the block without copying.
+    template<typename T>
+    struct MallocAllocator {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "malloc cannot satisfy over-aligned types");
+
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        MallocAllocator() = default;
+
+        template<typename U>
+        MallocAllocator(const MallocAllocator<U> &) noexcept {} // NOLINT(google-explicit-constructor)
+
+        [[nodiscard]] T *allocate(std::size_t n) {
+            auto *ptr = std::malloc(n * sizeof(T)); // NOLINT(cppcoreguidelines-no-malloc)
+            if (ptr == nullptr) {
+                throw std::bad_alloc();
+            }
+
+            return static_cast<T *>(ptr);
+        }
+
+        [[nodiscard]] T *reallocate(T *ptr, std::size_t /*old_n*/, std::size_t new_n) {
+            auto *new_ptr = std::realloc(ptr, new_n * sizeof(T)); // NOLINT(cppcoreguidelines-no-malloc)
+            if (new_ptr == nullptr) {
+                throw std::bad_alloc();
+            }
+
+            return static_cast<T *>(new_ptr);
+        }
+
+        void deallocate(T *ptr, std::size_t /*n*/) noexcept {
+            std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+        }
+
+        template<typename U>
+        bool operator==(const MallocAllocator<U> &) const noexcept { return true; }
+    };
+} // namespace ds
+
+#endif //DS_MALLOC_ALLOCATOR_HPP
@@ -0,0 +1,382 @@
+//
+// Created by santiago on 09.07.23.
+//
+
+#ifndef DS_MAPPED_VECTOR_HPP
+#define DS_MAPPED_VECTOR_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "contiguous_iterator.hpp"
+#include "type_definitions.hpp"
+
+namespace ds {
+
+    enum class MapMode {
+        read_only,
+        read_write
+    };
+
+    // First bytes of every file backing a MappedVector. Elements start right after it.
+    struct alignas(64) MappedVectorHeader {
+        static constexpr std::array<char, 8> MAGIC = {'D', 'S', 'V', 'E', 'C', 'T', 'O', 'R'};
+        static constexpr std::uint32_t VERSION = 1;
+
+        std::array<char, 8> magic;
+        std::uint32_t version;
+        std::uint32_t element_size;
+        std::uint64_t size;
+        std::uint64_t capacity;
+    };
+
+    // Vector whose elements live in a memory-mapped file, so opening an existing dataset costs one
+    // mmap() regardless of its size. Writes go straight to the page cache; sync() flushes them.
+    // Elements must be trivially copyable, as they are stored as raw bytes. A read_only vector (see
+    // MappedVectorView) maps the file without write access and only has the members that read it.
+    template<typename T, MapMode Mode = MapMode::read_write>
+    class MappedVector {
+        static_assert(std::is_trivially_copyable_v<T>, "MappedVector can only store trivially copyable types");
+        static_assert(alignof(T) <= alignof(MappedVectorHeader), "Element alignment is larger than the header alignment");
+
+    public:
+        using size_type = types::size_t;
+        using value_type = T;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using difference_type = types::ptrdiff_t;
+        using pointer = T *;
+        using iterator = it::ContiguousIterator<T, reference>;
+        using const_iterator = it::ContiguousIterator<T, const_reference>;
+
+        static constexpr bool WRITABLE = Mode == MapMode::read_write;
+
+        // Opens path, creating an empty vector if it does not exist and the vector is writable.
+        // Throws std::runtime_error if the file was written with a different format or element size.
+        explicit MappedVector(const std::string &path) {
+            const int flags = WRITABLE ? O_RDWR | O_CREAT : O_RDONLY;
+            _fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644); // NOLINT(cppcoreguidelines-pro-type-vararg)
+            if (_fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+            }
+
+            try {
+                struct stat file_stat {};
+                if (fstat(_fd, &file_stat) < 0) {
+                    throw std::system_error(errno, std::generic_category(), "Cannot stat " + path);
+                }
+
+                if (file_stat.st_size == 0 and WRITABLE) {
+                    initialize();
+                } else if (static_cast<size_type>(file_stat.st_size) < sizeof(MappedVectorHeader)) {
+                    throw std::runtime_error("File is not a mapped vector");
+                } else {
+                    map(static_cast<size_type>(file_stat.st_size));
+                    validate();
+                }
+            } catch (...) {
+                unmap();
+                ::close(_fd);
+                throw;
+            }
+        }
+
+        MappedVector(const MappedVector &) = delete;
+
+        MappedVector(MappedVector &&other) noexcept : _fd(std::exchange(other._fd, -1)),
+                                                      _mapping(std::exchange(other._mapping, nullptr)),
+                                                      _mapped_bytes(std::exchange(other._mapped_bytes, 0)) {}
+
+        ~MappedVector() {
+            unmap();
+            if (_fd >= 0) {
+                ::close(_fd);
+            }
+        }
+
+        auto operator=(const MappedVector &) -> MappedVector & = delete;
+
+        auto operator=(MappedVector &&other) noexcept -> MappedVector & {
+            std::swap(_fd, other._fd);
+            std::swap(_mapping, other._mapping);
+            std::swap(_mapped_bytes, other._mapped_bytes);
+            return *this;
+        }
+
+        auto at(size_type pos) -> reference
+            requires WRITABLE
+        {
+            if (pos >= size()) {
+                throw std::out_of_range("id is out of range");
+            }
+
+            return data()[pos]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        auto at(size_type pos) const -> const_reference {
+            if (pos >= size()) {
+                throw std::out_of_range("id is out of range");
+            }
+
+            return data()[pos]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        auto back() -> reference
+            requires WRITABLE
+        {
+            return data()[size() - 1]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        auto back() const -> const_reference {
+            return data()[size() - 1]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        auto begin()
+            requires WRITABLE
+        {
+            return iterator(data());
+        }
+
+        auto begin() const {
+            return cbegin();
+        }
+
+        [[nodiscard]] auto capacity() const -> size_type {
+            return header().capacity;
+        }
+
+        auto cbegin() const {
+            return const_iterator(const_cast<T *>(data())); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+        }
+
+        auto cend() const {
+            return const_iterator(const_cast<T *>(data()) + size()); // NOLINT(cppcoreguidelines-pro-type-const-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        void clear()
+            requires WRITABLE
+        {
+            header().size = 0;
+        }
+
+        auto data() -> T *
+            requires WRITABLE
+        {
+            return reinterpret_cast<T *>(_mapping + sizeof(MappedVectorHeader)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        auto data() const -> const T * {
+            return reinterpret_cast<const T *>(_mapping + sizeof(MappedVectorHeader)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        template<typename... Args>
+        auto emplace_back(Args &&...args) -> reference
+            requires WRITABLE
+        {
+            T *slot = nullptr;
+            if (size() < capacity()) {
+                slot = new (data() + size()) T(std::forward<Args>(args)...); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            } else {
+                // Built before growing, as the arguments may refer to elements that the remap moves
+                T value(std::forward<Args>(args)...);
+                reserve(capacity() > 0 ? capacity() * 2 : 1);
+                slot = new (data() + size()) T(value); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+
+            header().size++;
+            return *slot;
+        }
+
+        [[nodiscard]] auto empty() const {
+            return size() == 0;
+        }
+
+        auto end()
+            requires WRITABLE
+        {
+            return iterator(data() + size()); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        auto end() const {
+            return cend();
+        }
+
+        auto front() -> reference
+            requires WRITABLE
+        {
+            return data()[0]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        auto front() const -> const_reference {
+            return data()[0]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        auto operator[](size_type pos) -> reference
+            requires WRITABLE
+        {
+            return data()[pos]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        auto operator[](size_type pos) const -> const_reference {
+            return data()[pos]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        void pop_back()
+            requires WRITABLE
+        {
+            if (size() == 0) {
+                return;
+            }
+
+            header().size--;
+        }
+
+        void push_back(const T &value)
+            requires WRITABLE
+        {
+            emplace_back(value);
+        }
+
+        // Grows the backing file so that it can hold new_cap elements
+        void reserve(size_type new_cap)
+            requires WRITABLE
+        {
+            if (new_cap <= capacity()) {
+                return;
+            }
+
+            resize_file(new_cap);
+        }
+
+        void shrink_to_fit()
+            requires WRITABLE
+        {
+            resize_file(size());
+        }
+
+        [[nodiscard]] auto size() const -> size_type {
+            return header().size;
+        }
+
+        // Blocks until all changes have been written back to the file
+        void sync() {
+            if (msync(_mapping, _mapped_bytes, MS_SYNC) < 0) {
+                throw std::system_error(errno, std::generic_category(), "Cannot sync mapped vector");
+            }
+        }
+
+    private:
+        int _fd = -1;
+        std::byte *_mapping = nullptr;
+        size_type _mapped_bytes = 0;
+
+        static constexpr auto file_bytes(size_type capacity) -> size_type {
+            return sizeof(MappedVectorHeader) + capacity * sizeof(T);
+        }
+
+        auto header() -> MappedVectorHeader & {
+            return *reinterpret_cast<MappedVectorHeader *>(_mapping); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        }
+
+        auto header() const -> const MappedVectorHeader & {
+            return *reinterpret_cast<const MappedVectorHeader *>(_mapping); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        }
+
+        void initialize() {
+            truncate_file(file_bytes(0));
+            map(file_bytes(0));
+            header() = MappedVectorHeader{MappedVectorHeader::MAGIC, MappedVectorHeader::VERSION, sizeof(T), 0, 0};
+        }
+
+        void validate() const {
+            if (_mapped_bytes < sizeof(MappedVectorHeader) or header().magic != MappedVectorHeader::MAGIC) {
+                throw std::runtime_error("File is not a mapped vector");
+            }
+
+            if (header().version != MappedVectorHeader::VERSION) {
+                throw std::runtime_error("Unsupported mapped vector version " + std::to_string(header().version));
+            }
+
+            if (header().element_size != sizeof(T)) {
+                throw std::runtime_error("Mapped vector stores elements of " + std::to_string(header().element_size) +
+                                         " bytes, expected " + std::to_string(sizeof(T)));
+            }
+
+            // Compared in elements, as a corrupt capacity could overflow file_bytes()
+            if (header().capacity > (_mapped_bytes - sizeof(MappedVectorHeader)) / sizeof(T) or header().size > header().capacity) {
+                throw std::runtime_error("Mapped vector file is truncated");
+            }
+        }
+
+        void map(size_type bytes) {
+            const int protection = WRITABLE ? PROT_READ | PROT_WRITE : PROT_READ;
+            auto *mapping = mmap(nullptr, bytes, protection, MAP_SHARED, _fd, 0);
+            if (mapping == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "Cannot map file");
+            }
+
+            _mapping = static_cast<std::byte *>(mapping);
+            _mapped_bytes = bytes;
+        }
+
+        void unmap() {
+            if (_mapping != nullptr) {
+                munmap(_mapping, _mapped_bytes);
+                _mapping = nullptr;
+                _mapped_bytes = 0;
+            }
+        }
+
+        void truncate_file(size_type bytes) const {
+            if (ftruncate(_fd, static_cast<off_t>(bytes)) < 0) {
+                throw std::system_error(errno, std::generic_category(), "Cannot resize file");
+            }
+        }
+
+        void resize_file(size_type new_capacity) {
+            if (new_capacity < size()) {
+                throw std::length_error("New capacity must be larger than current size");
+            }
+
+            const auto new_bytes = file_bytes(new_capacity);
+            if (new_bytes > _mapped_bytes) {
+                truncate_file(new_bytes);
+            }
+
+#ifdef __linux__
+            auto *mapping = mremap(_mapping, _mapped_bytes, new_bytes, MREMAP_MAYMOVE);
+            if (mapping == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "Cannot remap file");
+            }
+            _mapping = static_cast<std::byte *>(mapping);
+            _mapped_bytes = new_bytes;
+#else
+            unmap();
+            map(new_bytes);
+#endif
+
+            if (new_bytes < file_bytes(capacity())) {
+                truncate_file(new_bytes);
+            }
+            header().capacity = new_capacity;
+        }
+    };
+
+    template<typename T>
+    using MappedVectorView = MappedVector<T, MapMode::read_only>;
+} // namespace ds
+
+#endif //DS_MAPPED_VECTOR_HPP
@@ -0,0 +1,146 @@
+//
+// Created by santiago on 02.07.23.
+//
+
+#ifndef DS_MMAP_ALLOCATOR_HPP
+#define DS_MMAP_ALLOCATOR_HPP
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include "type_definitions.hpp"
+
+namespace ds {
+
+    // Allocator for very large buffers. Blocks of at least MinMappedBytes are anonymous memory
+    // mappings that grow with mremap(), so the kernel moves page table entries instead of the
+    // contents and RSS never doubles while growing. Smaller blocks come from malloc/realloc.
+    // Pair it with PageGrowth so capacity is expressed in whole pages, e.g.
+    //     ds::Vector<double, ds::MmapAllocator<double>, 0, ds::PageGrowth<>>
+    // As with any reallocating allocator, Vector only takes the mremap path for trivially
+    // relocatable elements. HugePages asks for transparent huge pages with MADV_HUGEPAGE.
+    template<typename T, bool HugePages = false, types::size_t MinMappedBytes = types::size_t{1} << 20>
+    struct MmapAllocator {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "malloc cannot satisfy over-aligned types");
+
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        template<typename U>
+        struct rebind {
+            using other = MmapAllocator<U, HugePages, MinMappedBytes>;
+        };
+
+        MmapAllocator() = default;
+
+        template<typename U>
+        MmapAllocator(const MmapAllocator<U, HugePages, MinMappedBytes> &) noexcept {} // NOLINT(google-explicit-constructor)
+
+        [[nodiscard]] T *allocate(std::size_t n) {
+            const auto bytes = n * sizeof(T);
+            if (not is_mapped(bytes)) {
+                return static_cast<T *>(checked(std::malloc(bytes))); // NOLINT(cppcoreguidelines-no-malloc)
+            }
+
+            auto *ptr = mmap(nullptr, mapped_bytes(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+
+            advise(ptr, mapped_bytes(bytes));
+            return static_cast<T *>(ptr);
+        }
+
+        [[nodiscard]] T *reallocate(T *ptr, std::size_t old_n, std::size_t new_n) {
+            const auto old_bytes = old_n * sizeof(T);
+            const auto new_bytes = new_n * sizeof(T);
+
+            if (not is_mapped(old_bytes) and not is_mapped(new_bytes)) {
+                return static_cast<T *>(checked(std::realloc(ptr, new_bytes))); // NOLINT(cppcoreguidelines-no-malloc)
+            }
+
+            if (is_mapped(old_bytes) and is_mapped(new_bytes)) {
+                return remap(ptr, old_bytes, new_bytes);
+            }
+
+            // Crossing the threshold in either direction means changing allocator, so copy once
+            T *new_ptr = allocate(new_n);
+            std::memcpy(static_cast<void *>(new_ptr), static_cast<const void *>(ptr), std::min(old_bytes, new_bytes));
+            deallocate(ptr, old_n);
+            return new_ptr;
+        }
+
+        void deallocate(T *ptr, std::size_t n) noexcept {
+            const auto bytes = n * sizeof(T);
+            if (not is_mapped(bytes)) {
+                std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+                return;
+            }
+
+            munmap(ptr, mapped_bytes(bytes));
+        }
+
+        template<typename U>
+        bool operator==(const MmapAllocator<U, HugePages, MinMappedBytes> &) const noexcept { return true; }
+
+    private:
+        static auto page_size() -> std::size_t {
+            static const auto size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            return size;
+        }
+
+        static auto is_mapped(std::size_t bytes) -> bool {
+            return bytes >= MinMappedBytes;
+        }
+
+        static auto mapped_bytes(std::size_t bytes) -> std::size_t {
+            return (bytes + page_size() - 1) / page_size() * page_size();
+        }
+
+        static auto checked(void *ptr) -> void * {
+            if (ptr == nullptr) {
+                throw std::bad_alloc();
+            }
+
+            return ptr;
+        }
+
+        static void advise([[maybe_unused]] void *ptr, [[maybe_unused]] std::size_t bytes) {
+#ifdef MADV_HUGEPAGE
+            if constexpr (HugePages) {
+                madvise(ptr, bytes, MADV_HUGEPAGE);
+            }
+#endif
+        }
+
+        auto remap(T *ptr, std::size_t old_bytes, std::size_t new_bytes) -> T * {
+            if (mapped_bytes(old_bytes) == mapped_bytes(new_bytes)) {
+                return ptr;
+            }
+
+#ifdef __linux__
+            auto *new_ptr = mremap(ptr, mapped_bytes(old_bytes), mapped_bytes(new_bytes), MREMAP_MAYMOVE);
+            if (new_ptr == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+
+            advise(new_ptr, mapped_bytes(new_bytes));
+            return static_cast<T *>(new_ptr);
+#else
+            T *new_ptr = allocate(new_bytes / sizeof(T));
+            std::memcpy(static_cast<void *>(new_ptr), static_cast<const void *>(ptr), std::min(old_bytes, new_bytes));
+            munmap(ptr, mapped_bytes(old_bytes));
+            return new_ptr;
+#endif
+        }
+    };
+} // namespace ds
+
+#endif //DS_MMAP_ALLOCATOR_HPP
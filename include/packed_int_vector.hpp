@@ -0,0 +1,266 @@
+//
+// Created by santiago on 24.09.23.
+//
+
+#ifndef DS_PACKED_INT_VECTOR_HPP
+#define DS_PACKED_INT_VECTOR_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "simd.hpp"
+#include "type_definitions.hpp"
+#include "vector.hpp"
+
+namespace ds {
+
+    // Width template argument of a PackedIntVector whose width is chosen at runtime
+    constexpr unsigned DYNAMIC_WIDTH = 0;
+
+    namespace detail {
+        // Values are packed in blocks of PACKED_LANES * 64 values. Value j of lane l within a block
+        // is value j * PACKED_LANES + l, and the lanes are interleaved word by word, so the k-th word
+        // of every lane sits in one run of PACKED_LANES words. Decoding a block then loads one run per
+        // word and applies the same shift to all lanes, i.e. it is plain vector code.
+        constexpr types::size_t PACKED_LANES = 8;
+        constexpr types::size_t PACKED_BLOCK = PACKED_LANES * 64;
+
+        constexpr auto low_bits(unsigned width) -> std::uint64_t {
+            return width == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << width) - 1;
+        }
+
+        // Decodes whole blocks into out. Width is the bit width if known at compile time, so the
+        // shifts of each row become constants, and width otherwise.
+        template<unsigned Width>
+        struct UnpackKernel {
+            template<int Bytes, typename T>
+            DS_SIMD_ALWAYS_INLINE static void run(const std::uint64_t *words, types::size_t num_blocks, unsigned width, T *out) {
+                if constexpr (Width != DYNAMIC_WIDTH) {
+                    width = Width;
+                }
+
+                const auto mask = low_bits(width);
+                for (types::size_t block = 0; block < num_blocks; block++) {
+                    const auto *block_words = words + block * width * PACKED_LANES; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    auto *block_out = out + block * PACKED_BLOCK;                   // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    for (types::size_t row = 0; row < 64; row++) {
+                        const auto bit = row * width;
+                        const auto offset = bit % 64;
+                        const auto *low = block_words + bit / 64 * PACKED_LANES; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+#if defined(DS_SIMD_VECTOR_EXTENSIONS)
+                        // One register of 64-bit lanes whatever Bytes is, as it fixes the layout;
+                        // narrower targets split it into several registers
+                        simd::detail::Register<std::uint64_t, 8 * PACKED_LANES> low_reg;
+                        simd::detail::Register<std::uint64_t, 8 * PACKED_LANES> high_reg;
+                        simd::detail::load(low_reg, low);
+                        simd::detail::load(high_reg, low + PACKED_LANES); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                        const auto values = ((low_reg >> offset) | ((high_reg << 1) << (63 - offset))) & mask;
+                        const auto narrowed = __builtin_convertvector(values, simd::detail::Register<T, sizeof(T) * PACKED_LANES>);
+                        std::memcpy(block_out + row * PACKED_LANES, &narrowed, sizeof(narrowed)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+#else
+                        for (types::size_t lane = 0; lane < PACKED_LANES; lane++) {
+                            const auto value = ((low[lane] >> offset) | ((low[lane + PACKED_LANES] << 1) << (63 - offset))) & mask; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                            block_out[row * PACKED_LANES + lane] = static_cast<T>(value);                                            // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                        }
+#endif
+                    }
+                }
+            }
+        };
+    } // namespace detail
+
+    // Unsigned integers stored in width bits each, for columns whose values need far fewer bits
+    // than their type. Width is fixed at compile time, or chosen at construction with DYNAMIC_WIDTH.
+    // Single elements are read with a couple of shifts; decode() unpacks whole ranges with SIMD.
+    template<std::unsigned_integral T = std::uint32_t, unsigned Width = DYNAMIC_WIDTH>
+    class PackedIntVector {
+        static_assert(sizeof(T) <= 8 and not std::same_as<T, bool>, "Elements must be unsigned integers of at most 64 bits");
+        static_assert(Width <= std::numeric_limits<T>::digits, "Width must not exceed the bits of T");
+
+    public:
+        using size_type = types::size_t;
+        using value_type = T;
+        using word_type = std::uint64_t;
+
+        PackedIntVector()
+            requires(Width != DYNAMIC_WIDTH)
+        = default;
+
+        explicit PackedIntVector(unsigned width)
+            requires(Width == DYNAMIC_WIDTH)
+            : _width(width) {
+            if (width == 0 or width > std::numeric_limits<T>::digits) {
+                throw std::invalid_argument("Width must be between 1 and the bits of T");
+            }
+        }
+
+        auto at(size_type pos) const -> T {
+            if (pos >= _size) {
+                throw std::out_of_range("id is out of range");
+            }
+
+            return (*this)[pos];
+        }
+
+        void clear() {
+            _words.clear();
+            _size = 0;
+        }
+
+        // Writes the elements from first on to the front of out, as many as fit, and returns how many
+        auto decode(std::span<T> out, size_type first = 0) const -> size_type {
+            const auto count = first < _size ? std::min<size_type>(out.size(), _size - first) : 0;
+            size_type done = 0;
+            // Up to the next block boundary one by one, then whole blocks at once
+            for (; done < count and (first + done) % detail::PACKED_BLOCK != 0; done++) {
+                out[done] = (*this)[first + done];
+            }
+
+            const auto num_blocks = (count - done) / detail::PACKED_BLOCK;
+            if (num_blocks > 0) {
+                const auto *words = _words.data() + (first + done) / detail::PACKED_BLOCK * width() * detail::PACKED_LANES; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                simd::detail::dispatch<detail::UnpackKernel<Width>>(words, num_blocks, width(), out.data() + done);        // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                done += num_blocks * detail::PACKED_BLOCK;
+            }
+
+            for (; done < count; done++) {
+                out[done] = (*this)[first + done];
+            }
+            return count;
+        }
+
+        // All elements, unpacked
+        [[nodiscard]] auto decode() const -> Vector<T> {
+            Vector<T> values;
+            values.resize_for_overwrite(_size);
+            decode(std::span(values.data(), _size));
+            return values;
+        }
+
+        [[nodiscard]] auto empty() const -> bool {
+            return _size == 0;
+        }
+
+        [[nodiscard]] auto max_value() const -> T {
+            return static_cast<T>(detail::low_bits(width()));
+        }
+
+        auto operator[](size_type pos) const -> T {
+            const auto [index, offset] = locate(pos);
+            const auto low = _words[index];
+            const auto high = _words[index + detail::PACKED_LANES];
+            return static_cast<T>(((low >> offset) | ((high << 1) << (63 - offset))) & detail::low_bits(width()));
+        }
+
+        void pop_back() {
+            store(_size - 1, 0);
+            _size--;
+            if (_size % detail::PACKED_BLOCK == 0) {
+                for (size_type i = 0; i < width() * detail::PACKED_LANES; i++) {
+                    _words.pop_back();
+                }
+            }
+        }
+
+        // Throws std::out_of_range if value needs more than width() bits
+        void push_back(T value) {
+            check_fits(value);
+            if (_size % detail::PACKED_BLOCK == 0) {
+                add_block();
+            }
+            store(_size, value);
+            _size++;
+        }
+
+        void reserve(size_type new_cap) {
+            const auto blocks = (new_cap + detail::PACKED_BLOCK - 1) / detail::PACKED_BLOCK;
+            _words.reserve((blocks * width() + 1) * detail::PACKED_LANES);
+        }
+
+        // Throws std::out_of_range if value needs more than width() bits
+        void set(size_type pos, T value) {
+            check_fits(value);
+            store(pos, value);
+        }
+
+        void shrink_to_fit() {
+            _words.shrink_to_fit();
+        }
+
+        [[nodiscard]] auto size() const -> size_type {
+            return _size;
+        }
+
+        [[nodiscard]] auto width() const -> unsigned {
+            if constexpr (Width != DYNAMIC_WIDTH) {
+                return Width;
+            } else {
+                return _width;
+            }
+        }
+
+        // Underlying words, in the interleaved layout described in detail::PACKED_LANES
+        [[nodiscard]] auto words() const -> std::span<const word_type> {
+            return std::span(_words.data(), _words.size());
+        }
+
+    private:
+        struct Location {
+            size_type index;
+            size_type offset;
+        };
+
+        // Whole blocks followed by one row of PACKED_LANES zero words, so that the word after the
+        // one holding the low bits of an element can always be read
+        Vector<word_type> _words;
+        size_type _size = 0;
+        [[no_unique_address]] std::conditional_t<Width == DYNAMIC_WIDTH, unsigned, std::integral_constant<unsigned, Width>> _width{};
+
+        // Word holding the low bits of the element at pos, and their offset in it. The high bits, if
+        // any, are at the same offset PACKED_LANES words later.
+        [[nodiscard]] auto locate(size_type pos) const -> Location {
+            const auto block = pos / detail::PACKED_BLOCK;
+            const auto in_block = pos % detail::PACKED_BLOCK;
+            const auto bit = in_block / detail::PACKED_LANES * width();
+            const auto index = (block * width() + bit / 64) * detail::PACKED_LANES + in_block % detail::PACKED_LANES;
+            return {index, bit % 64};
+        }
+
+        void add_block() {
+            if (_words.empty()) {
+                for (size_type i = 0; i < detail::PACKED_LANES; i++) {
+                    _words.push_back(0);
+                }
+            }
+            // The zero row at the end becomes the first row of the block, and a new one follows it
+            for (size_type i = 0; i < width() * detail::PACKED_LANES; i++) {
+                _words.push_back(0);
+            }
+        }
+
+        void check_fits(T value) const {
+            if (value > max_value()) {
+                throw std::out_of_range("Value does not fit in the bit width");
+            }
+        }
+
+        void store(size_type pos, T value) {
+            const auto [index, offset] = locate(pos);
+            const auto mask = detail::low_bits(width());
+            _words[index] = (_words[index] & ~(mask << offset)) | (word_type{value} << offset);
+            if (offset + width() > 64) {
+                const auto spilled = 64 - offset;
+                auto &high = _words[index + detail::PACKED_LANES];
+                high = (high & ~(mask >> spilled)) | (word_type{value} >> spilled);
+            }
+        }
+    };
+} // namespace ds
+
+#endif //DS_PACKED_INT_VECTOR_HPP
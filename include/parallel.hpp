@@ -0,0 +1,270 @@
+//
+// Created by santiago on 06.08.23.
+//
+
+#ifndef DS_PARALLEL_HPP
+#define DS_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "simd.hpp"
+#include "sort.hpp"
+#include "thread_pool.hpp"
+#include "type_definitions.hpp"
+
+// Bulk operations that split a contiguous range into chunks run by a ThreadPool; the calling thread
+// takes part. Each chunk is written by the thread that runs it, so filling storage that has not been
+// touched yet (e.g. after Vector::resize_for_overwrite) maps its pages on the NUMA node of that thread.
+namespace ds {
+
+    namespace detail {
+        // Ranges shorter than this run on the calling thread, as a task would cost more than it saves
+        constexpr types::size_t PARALLEL_GRAIN = 1U << 14U;
+
+        template<typename Range>
+        auto range_size(const Range &range) {
+            return static_cast<types::size_t>(std::ranges::size(range));
+        }
+
+        // Splits n elements into at most twice as many chunks as pool threads, none below PARALLEL_GRAIN
+        inline auto chunk_count(types::size_t n, const ThreadPool &pool) -> types::size_t {
+            return std::clamp<types::size_t>(n / PARALLEL_GRAIN, 1, 2 * (pool.size() + 1));
+        }
+
+        inline auto chunk_begin(types::size_t chunk, types::size_t num_chunks, types::size_t n) -> types::size_t {
+            return n / num_chunks * chunk + std::min(chunk, n % num_chunks);
+        }
+
+        template<typename Dst, typename Src>
+        void check_destination(const Dst &dst, const Src &src) {
+            if (range_size(dst) < range_size(src)) {
+                throw std::invalid_argument("Destination is smaller than the source");
+            }
+        }
+
+        // Radix sort that splits the keys in buckets by their highest differing byte in one parallel pass,
+        // and then radix sorts the buckets concurrently. In that pass every chunk counts its keys per
+        // bucket, and scatters them after those of the same bucket in all earlier chunks, which keeps the
+        // sort stable.
+        template<RadixOrder Order, radix_sortable T>
+        void parallel_radix_sort(T *data, types::size_t n, SortBuffer &buffer, ThreadPool &pool) {
+            using U = radix_bits_t<T>;
+            const auto num_chunks = chunk_count(n, pool);
+            const auto [scratch] = buffer.acquire<T>(n);
+            std::vector<std::array<types::size_t, RADIX_BUCKETS>> offsets(num_chunks);
+            std::vector<U> differing(num_chunks);
+            const auto for_each_chunk = [&](auto fn) {
+                pool.parallel_for(num_chunks, 1, [&](types::size_t first_chunk, types::size_t last_chunk) {
+                    for (auto chunk = first_chunk; chunk < last_chunk; chunk++) {
+                        fn(chunk, chunk_begin(chunk, num_chunks, n), chunk_begin(chunk + 1, num_chunks, n));
+                    }
+                });
+            };
+
+            const auto first = radix_bits<Order>(data[0]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            for_each_chunk([&](types::size_t chunk, types::size_t begin, types::size_t end) {
+                auto bits = U{0};
+                for (auto i = begin; i < end; i++) {
+                    bits |= radix_bits<Order>(data[i]) ^ first; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                }
+                differing[chunk] = bits;
+            });
+            const auto all_differing = std::reduce(differing.begin(), differing.end(), U{0}, std::bit_or<>());
+            if (all_differing == 0) {
+                return;
+            }
+
+            const auto pass = static_cast<types::size_t>(std::bit_width(all_differing) - 1) / RADIX_BITS;
+            for_each_chunk([&](types::size_t chunk, types::size_t begin, types::size_t end) {
+                auto &counts = offsets[chunk];
+                counts.fill(0);
+                for (auto i = begin; i < end; i++) {
+                    counts[radix_digit<Order>(data[i], pass)]++; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                }
+            });
+
+            std::array<types::size_t, RADIX_BUCKETS + 1> bucket_begin{};
+            auto sum = types::size_t{0};
+            for (types::size_t bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+                bucket_begin[bucket] = sum;
+                for (auto &counts: offsets) {
+                    sum += std::exchange(counts[bucket], sum);
+                }
+            }
+            bucket_begin[RADIX_BUCKETS] = n;
+
+            for_each_chunk([&](types::size_t chunk, types::size_t begin, types::size_t end) {
+                auto &positions = offsets[chunk];
+                for (auto i = begin; i < end; i++) {
+                    scratch[positions[radix_digit<Order>(data[i], pass)]++] = data[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                }
+            });
+
+            pool.parallel_for(RADIX_BUCKETS, 1, [&](types::size_t first_bucket, types::size_t last_bucket) {
+                for (auto bucket = first_bucket; bucket < last_bucket; bucket++) {
+                    const auto begin = bucket_begin[bucket];
+                    const auto size = bucket_begin[bucket + 1] - begin;
+                    radix_sort<Order, T, void>(scratch + begin, nullptr, data + begin, nullptr, size, pass); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    std::copy(scratch + begin, scratch + begin + size, data + begin);                        // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                }
+            });
+        }
+    } // namespace detail
+
+    template<std::ranges::contiguous_range Range>
+    void parallel_fill(Range &&range, const std::ranges::range_value_t<Range> &value, ThreadPool &pool = ThreadPool::global()) {
+        using T = std::ranges::range_value_t<Range>;
+        auto *data = std::ranges::data(range);
+        pool.parallel_for(detail::range_size(range), detail::PARALLEL_GRAIN, [&](types::size_t begin, types::size_t end) {
+            if constexpr (simd::vectorizable<T>) {
+                simd::fill(std::span(data + begin, end - begin), value); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            } else {
+                std::fill(data + begin, data + end, value); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        });
+    }
+
+    // Copies src to the front of dst, which must be at least as large
+    template<std::ranges::contiguous_range Src, std::ranges::contiguous_range Dst>
+    void parallel_copy(const Src &src, Dst &&dst, ThreadPool &pool = ThreadPool::global()) {
+        detail::check_destination(dst, src);
+        const auto *in = std::ranges::data(src);
+        auto *out = std::ranges::data(dst);
+        pool.parallel_for(detail::range_size(src), detail::PARALLEL_GRAIN, [&](types::size_t begin, types::size_t end) {
+            std::copy(in + begin, in + end, out + begin); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        });
+    }
+
+    // Writes fn(src[i]) to dst[i] for every element of src; dst must be at least as large
+    template<std::ranges::contiguous_range Src, std::ranges::contiguous_range Dst, typename Fn>
+    void parallel_transform(const Src &src, Dst &&dst, Fn fn, ThreadPool &pool = ThreadPool::global()) {
+        detail::check_destination(dst, src);
+        const auto *in = std::ranges::data(src);
+        auto *out = std::ranges::data(dst);
+        pool.parallel_for(detail::range_size(src), detail::PARALLEL_GRAIN, [&](types::size_t begin, types::size_t end) {
+            std::transform(in + begin, in + end, out + begin, fn); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        });
+    }
+
+    // Folds init and the elements with op, which must be associative. Elements are combined in order
+    // within each chunk and chunk results in order after them, so op need not be commutative.
+    template<std::ranges::contiguous_range Range, typename T, typename BinaryOp = std::plus<>>
+    auto parallel_reduce(const Range &range, T init, BinaryOp op = {}, ThreadPool &pool = ThreadPool::global()) -> T {
+        const auto n = detail::range_size(range);
+        const auto *data = std::ranges::data(range);
+        const auto num_chunks = detail::chunk_count(n, pool);
+        std::vector<std::optional<T>> partials(num_chunks);
+        pool.parallel_for(num_chunks, 1, [&](types::size_t first_chunk, types::size_t last_chunk) {
+            for (auto chunk = first_chunk; chunk < last_chunk; chunk++) {
+                const auto begin = detail::chunk_begin(chunk, num_chunks, n);
+                const auto end = detail::chunk_begin(chunk + 1, num_chunks, n);
+                if (begin == end) {
+                    continue;
+                }
+
+                T partial = data[begin]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                for (auto i = begin + 1; i < end; i++) {
+                    partial = op(std::move(partial), data[i]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                }
+                partials[chunk].emplace(std::move(partial));
+            }
+        });
+
+        for (auto &partial: partials) {
+            if (partial) {
+                init = op(std::move(init), std::move(*partial));
+            }
+        }
+        return init;
+    }
+
+    // Integer and floating point keys ordered by std::less or std::greater are radix sorted as in ds::sort,
+    // with scratch memory taken from buffer. Other ranges are not sorted stably: chunks are sorted
+    // concurrently and then merged pairwise, one parallel round per level.
+    template<std::ranges::contiguous_range Range, typename Compare = std::less<>>
+    void parallel_sort(Range &&range, SortBuffer &buffer, Compare comp = {}, ThreadPool &pool = ThreadPool::global()) {
+        using T = std::ranges::range_value_t<Range>;
+        constexpr auto ORDER = detail::radix_order_v<Compare, T>;
+        const auto n = detail::range_size(range);
+        auto *data = std::ranges::data(range);
+        if constexpr (ORDER != detail::RadixOrder::none) {
+            if (n <= detail::PARALLEL_GRAIN) {
+                ds::sort(range, buffer, comp);
+            } else {
+                detail::parallel_radix_sort<ORDER>(data, n, buffer, pool);
+            }
+            return;
+        }
+
+        // A power of two, so that every merge round pairs up all the runs
+        const auto num_runs = std::bit_floor(detail::chunk_count(n, pool));
+        const auto run_begin = [&](types::size_t run) {
+            return data + detail::chunk_begin(run, num_runs, n); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        };
+
+        pool.parallel_for(num_runs, 1, [&](types::size_t first_run, types::size_t last_run) {
+            for (auto run = first_run; run < last_run; run++) {
+                ds::sort(run_begin(run), run_begin(run + 1), comp);
+            }
+        });
+
+        for (types::size_t width = 1; width < num_runs; width *= 2) {
+            pool.parallel_for(num_runs / (2 * width), 1, [&](types::size_t first_pair, types::size_t last_pair) {
+                for (auto pair = first_pair; pair < last_pair; pair++) {
+                    const auto first = pair * 2 * width;
+                    std::inplace_merge(run_begin(first), run_begin(first + width), run_begin(first + 2 * width), comp);
+                }
+            });
+        }
+    }
+
+    template<std::ranges::contiguous_range Range, typename Compare = std::less<>>
+    void parallel_sort(Range &&range, Compare comp = {}, ThreadPool &pool = ThreadPool::global()) {
+        SortBuffer buffer;
+        parallel_sort(range, buffer, comp, pool);
+    }
+
+    template<std::ranges::contiguous_range Lhs, std::ranges::contiguous_range Rhs>
+    auto parallel_equal(const Lhs &lhs, const Rhs &rhs, ThreadPool &pool = ThreadPool::global()) -> bool {
+        using T = std::ranges::range_value_t<Lhs>;
+        const auto n = detail::range_size(lhs);
+        if (n != detail::range_size(rhs)) {
+            return false;
+        }
+
+        const auto *lhs_data = std::ranges::data(lhs);
+        const auto *rhs_data = std::ranges::data(rhs);
+        std::atomic<bool> mismatch = false;
+        pool.parallel_for(n, detail::PARALLEL_GRAIN, [&](types::size_t begin, types::size_t end) {
+            // Chunks starting after a mismatch was found elsewhere have nothing left to decide
+            if (mismatch.load(std::memory_order_relaxed)) {
+                return;
+            }
+
+            const auto equal = [&] {
+                if constexpr (simd::vectorizable<T> and std::same_as<T, std::ranges::range_value_t<Rhs>>) {
+                    return simd::equal(std::span(lhs_data + begin, end - begin), std::span(rhs_data + begin, end - begin)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                } else {
+                    return std::equal(lhs_data + begin, lhs_data + end, rhs_data + begin); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                }
+            }();
+            if (not equal) {
+                mismatch.store(true, std::memory_order_relaxed);
+            }
+        });
+
+        return not mismatch.load(std::memory_order_relaxed);
+    }
+
+} // namespace ds
+
+#endif //DS_PARALLEL_HPP
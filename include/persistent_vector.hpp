@@ -0,0 +1,447 @@
+//
+// Created by santiago on 08.10.23.
+//
+
+#ifndef DS_PERSISTENT_VECTOR_HPP
+#define DS_PERSISTENT_VECTOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "static_vector.hpp"
+#include "type_definitions.hpp"
+#include "vector.hpp"
+
+namespace ds {
+
+    // Immutable vector whose updates return a new version and leave the old one untouched. Elements
+    // live in a trie of 32-way nodes, so push_back and set copy only the O(log32 n) nodes on the path
+    // to the element and share the rest with the old version. The last, possibly partial, chunk is
+    // kept out of the trie as a tail, which makes most appends touch a single chunk.
+    //
+    // Copying a version is O(1), as it only shares its nodes. Nodes never change once two versions
+    // share them and are freed through atomic reference counts, so versions can be copied and read
+    // from any number of threads, e.g. as snapshots taken while a writer keeps appending.
+    template<typename T>
+    class PersistentVector {
+        static constexpr unsigned BITS = 5;
+        static constexpr types::size_t BRANCHES = types::size_t{1} << BITS;
+        static constexpr types::size_t MASK = BRANCHES - 1;
+
+        // Nodes are leaves, holding BRANCHES elements, or inner nodes, holding BRANCHES children. Which
+        // one a node is follows from its depth, so they carry no tag.
+        struct Node {
+            std::atomic<types::size_t> refs = 1;
+        };
+
+        struct Inner : Node {
+            std::array<Node *, BRANCHES> children{};
+        };
+
+        struct Leaf : Node {
+            StaticVector<T, BRANCHES> values;
+        };
+
+    public:
+        using size_type = types::size_t;
+        using value_type = T;
+        using reference = const T &;
+        using const_reference = const T &;
+        using difference_type = types::ptrdiff_t;
+
+        // Remembers the chunk of its position, so stepping through it only walks the trie once per chunk
+        class const_iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using difference_type = types::ptrdiff_t;
+            using value_type = T;
+            using pointer = const T *;
+            using reference = const T &;
+
+            const_iterator() = default;
+
+            const_iterator(const PersistentVector *vector, size_type pos) : _vector(vector) { seek(pos); }
+
+            reference operator*() const { return _chunk[_pos & MASK]; } // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+            pointer operator->() const { return &**this; }
+
+            reference operator[](difference_type offset) const { return (*_vector)[_pos + offset]; }
+
+            const_iterator &operator++() {
+                _pos++;
+                if ((_pos & MASK) == 0) {
+                    seek(_pos);
+                }
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            const_iterator &operator--() {
+                _pos--;
+                if (_chunk == nullptr or (_pos & MASK) == MASK) {
+                    seek(_pos);
+                }
+                return *this;
+            }
+
+            const_iterator operator--(int) {
+                const_iterator tmp = *this;
+                --(*this);
+                return tmp;
+            }
+
+            const_iterator &operator+=(difference_type offset) {
+                seek(_pos + offset);
+                return *this;
+            }
+
+            const_iterator &operator-=(difference_type offset) {
+                seek(_pos - offset);
+                return *this;
+            }
+
+            const_iterator operator+(difference_type offset) const { return const_iterator(_vector, _pos + offset); }
+
+            friend const_iterator operator+(difference_type offset, const const_iterator &other) { return other + offset; }
+
+            const_iterator operator-(difference_type offset) const { return const_iterator(_vector, _pos - offset); }
+
+            difference_type operator-(const const_iterator &other) const {
+                return static_cast<difference_type>(_pos) - static_cast<difference_type>(other._pos);
+            }
+
+            bool operator==(const const_iterator &other) const { return _pos == other._pos; }
+
+            auto operator<=>(const const_iterator &other) const { return _pos <=> other._pos; }
+
+        private:
+            const PersistentVector *_vector = nullptr;
+            size_type _pos = 0;
+            const T *_chunk = nullptr;
+
+            void seek(size_type pos) {
+                _pos = pos;
+                _chunk = pos < _vector->size() ? _vector->leaf_for(pos)->values.data() : nullptr;
+            }
+        };
+
+        using iterator = const_iterator;
+
+        class Transient;
+
+        PersistentVector() = default;
+
+        template<std::input_iterator InputIt>
+        PersistentVector(InputIt first, InputIt last) {
+            for (; first != last; ++first) {
+                push_back_in_place(*first);
+            }
+        }
+
+        PersistentVector(std::initializer_list<T> init) : PersistentVector(init.begin(), init.end()) {}
+
+        explicit PersistentVector(const Vector<T> &values) : PersistentVector(values.cbegin(), values.cend()) {}
+
+        PersistentVector(const PersistentVector &other) noexcept
+            : _size(other._size), _shift(other._shift), _root(other._root), _tail(other._tail) {
+            retain(_root);
+            retain(_tail);
+        }
+
+        PersistentVector(PersistentVector &&other) noexcept
+            : _size(std::exchange(other._size, 0)), _shift(std::exchange(other._shift, BITS)),
+              _root(std::exchange(other._root, nullptr)), _tail(std::exchange(other._tail, nullptr)) {}
+
+        ~PersistentVector() {
+            release(_root, _shift);
+            release(_tail, 0);
+        }
+
+        auto at(size_type pos) const -> const T & {
+            if (pos >= _size) {
+                throw std::out_of_range("id is out of range");
+            }
+
+            return (*this)[pos];
+        }
+
+        auto back() const -> const T & {
+            return (*this)[_size - 1];
+        }
+
+        auto begin() const {
+            return const_iterator(this, 0);
+        }
+
+        auto cbegin() const {
+            return begin();
+        }
+
+        auto cend() const {
+            return end();
+        }
+
+        [[nodiscard]] auto empty() const -> bool {
+            return _size == 0;
+        }
+
+        auto end() const {
+            return const_iterator(this, _size);
+        }
+
+        auto front() const -> const T & {
+            return (*this)[0];
+        }
+
+        auto operator[](size_type pos) const -> const T & {
+            return leaf_for(pos)->values[pos & MASK];
+        }
+
+        auto operator=(const PersistentVector &other) noexcept -> PersistentVector & {
+            PersistentVector copy(other);
+            swap(copy);
+            return *this;
+        }
+
+        auto operator=(PersistentVector &&other) noexcept -> PersistentVector & {
+            PersistentVector moved(std::move(other));
+            swap(moved);
+            return *this;
+        }
+
+        // New version with value appended
+        [[nodiscard]] auto push_back(T value) const & -> PersistentVector {
+            PersistentVector copy(*this);
+            copy.push_back_in_place(std::move(value));
+            return copy;
+        }
+
+        // Appends in place the nodes that no other version shares
+        [[nodiscard]] auto push_back(T value) && -> PersistentVector {
+            push_back_in_place(std::move(value));
+            return std::move(*this);
+        }
+
+        // New version with the element at pos replaced by value
+        [[nodiscard]] auto set(size_type pos, T value) const & -> PersistentVector {
+            PersistentVector copy(*this);
+            copy.set_in_place(pos, std::move(value));
+            return copy;
+        }
+
+        [[nodiscard]] auto set(size_type pos, T value) && -> PersistentVector {
+            set_in_place(pos, std::move(value));
+            return std::move(*this);
+        }
+
+        [[nodiscard]] auto size() const -> size_type {
+            return _size;
+        }
+
+        void swap(PersistentVector &other) noexcept {
+            std::swap(_size, other._size);
+            std::swap(_shift, other._shift);
+            std::swap(_root, other._root);
+            std::swap(_tail, other._tail);
+        }
+
+        [[nodiscard]] auto to_vector() const -> Vector<T> {
+            Vector<T> values;
+            values.reserve(_size);
+            for (size_type pos = 0; pos < _size; pos += BRANCHES) {
+                const auto &chunk = leaf_for(pos)->values;
+                values.insert(values.cend(), chunk.cbegin(), chunk.cend());
+            }
+            return values;
+        }
+
+        // Handle for building a new version out of many updates
+        [[nodiscard]] auto transient() const -> Transient {
+            return Transient(*this);
+        }
+
+    private:
+        size_type _size = 0;
+        // Bits of a position consumed above the children of the root
+        unsigned _shift = BITS;
+        Node *_root = nullptr;
+        Leaf *_tail = nullptr;
+
+        static void retain(Node *node) {
+            if (node != nullptr) {
+                node->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // shift is 0 for leaves, and grows by BITS per level above them
+        static void release(Node *node, unsigned shift) {
+            if (node == nullptr or node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return;
+            }
+
+            if (shift == 0) {
+                delete static_cast<Leaf *>(node); // NOLINT(cppcoreguidelines-owning-memory)
+                return;
+            }
+
+            auto *inner = static_cast<Inner *>(node);
+            for (auto *child: inner->children) {
+                release(child, shift - BITS);
+            }
+            delete inner; // NOLINT(cppcoreguidelines-owning-memory)
+        }
+
+        // Makes node one that only this version holds, copying it if it is shared. A node held once
+        // is only reachable through this version, so it can be changed in place.
+        template<typename N>
+        static auto unshare(N *&node, unsigned shift) -> N * {
+            if (node->refs.load(std::memory_order_acquire) == 1) {
+                return node;
+            }
+
+            N *copy = nullptr;
+            if (shift == 0) {
+                auto leaf = std::make_unique<Leaf>();
+                leaf->values = static_cast<const Leaf *>(static_cast<Node *>(node))->values;
+                copy = static_cast<N *>(static_cast<Node *>(leaf.release()));
+            } else {
+                auto *inner = new Inner; // NOLINT(cppcoreguidelines-owning-memory)
+                inner->children = static_cast<const Inner *>(static_cast<Node *>(node))->children;
+                for (auto *child: inner->children) {
+                    retain(child);
+                }
+                copy = static_cast<N *>(static_cast<Node *>(inner));
+            }
+
+            release(node, shift);
+            node = copy;
+            return copy;
+        }
+
+        // Elements before it are in the trie, in full leaves; the rest are in the tail
+        [[nodiscard]] auto tail_offset() const -> size_type {
+            return _tail == nullptr ? _size : _size - _tail->values.size();
+        }
+
+        auto leaf_for(size_type pos) const -> const Leaf * {
+            if (pos >= tail_offset()) {
+                return _tail;
+            }
+
+            const Node *node = _root;
+            for (auto shift = _shift; shift > 0; shift -= BITS) {
+                node = static_cast<const Inner *>(node)->children[(pos >> shift) & MASK];
+            }
+            return static_cast<const Leaf *>(node);
+        }
+
+        void push_back_in_place(T value) {
+            if (_tail == nullptr or _tail->values.size() == BRANCHES) {
+                auto leaf = std::make_unique<Leaf>();
+                if (_tail != nullptr) {
+                    push_tail();
+                }
+                _tail = leaf.release();
+            } else {
+                unshare(_tail, 0);
+            }
+
+            _tail->values.push_back(std::move(value));
+            _size++;
+        }
+
+        // Moves the full tail into the trie, adding a level on top when the root is full
+        void push_tail() {
+            const auto pos = tail_offset();
+            if (_root == nullptr) {
+                _root = new Inner; // NOLINT(cppcoreguidelines-owning-memory)
+            } else if ((pos >> BITS) >= (size_type{1} << _shift)) {
+                auto *root = new Inner; // NOLINT(cppcoreguidelines-owning-memory)
+                root->children[0] = _root;
+                _root = root;
+                _shift += BITS;
+            }
+
+            Node **slot = &_root;
+            for (auto shift = _shift; shift > BITS; shift -= BITS) {
+                slot = &static_cast<Inner *>(unshare(*slot, shift))->children[(pos >> shift) & MASK];
+                if (*slot == nullptr) {
+                    *slot = new Inner; // NOLINT(cppcoreguidelines-owning-memory)
+                }
+            }
+            static_cast<Inner *>(unshare(*slot, BITS))->children[(pos >> BITS) & MASK] = std::exchange(_tail, nullptr);
+        }
+
+        void set_in_place(size_type pos, T value) {
+            if (pos >= _size) {
+                throw std::out_of_range("id is out of range");
+            }
+
+            if (pos >= tail_offset()) {
+                unshare(_tail, 0)->values[pos & MASK] = std::move(value);
+                return;
+            }
+
+            Node **slot = &_root;
+            for (auto shift = _shift; shift > 0; shift -= BITS) {
+                slot = &static_cast<Inner *>(unshare(*slot, shift))->children[(pos >> shift) & MASK];
+            }
+            static_cast<Leaf *>(unshare(*slot, 0))->values[pos & MASK] = std::move(value);
+        }
+    };
+
+    // Changes the nodes that only it holds in place, instead of copying a path per update as separate
+    // versions do. persistent() returns the current version in O(1); the transient can keep going
+    // afterwards, and copies whatever it then shares with that version before changing it.
+    template<typename T>
+    class PersistentVector<T>::Transient {
+    public:
+        explicit Transient(PersistentVector vector) : _vector(std::move(vector)) {}
+
+        auto operator[](size_type pos) const -> const T & {
+            return _vector[pos];
+        }
+
+        [[nodiscard]] auto persistent() const & -> PersistentVector {
+            return _vector;
+        }
+
+        [[nodiscard]] auto persistent() && -> PersistentVector {
+            return std::move(_vector);
+        }
+
+        void push_back(T value) {
+            _vector.push_back_in_place(std::move(value));
+        }
+
+        void set(size_type pos, T value) {
+            _vector.set_in_place(pos, std::move(value));
+        }
+
+        [[nodiscard]] auto size() const -> size_type {
+            return _vector.size();
+        }
+
+    private:
+        PersistentVector _vector;
+    };
+
+    template<typename T>
+    auto operator==(const PersistentVector<T> &lhs, const PersistentVector<T> &rhs) {
+        return lhs.size() == rhs.size() and std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+    }
+} // namespace ds
+
+#endif //DS_PERSISTENT_VECTOR_HPP
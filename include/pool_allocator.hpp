@@ -0,0 +1,203 @@
+//
+// Created by santiago on 13.08.23.
+//
+
+#ifndef DS_POOL_ALLOCATOR_HPP
+#define DS_POOL_ALLOCATOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#include "allocation_stats.hpp"
+#include "type_definitions.hpp"
+#include "vector.hpp"
+
+namespace ds {
+
+    // Memory resource with one free list per power-of-two size class, from 16 bytes to
+    // MAX_POOLED_BYTES. Chunks are carved out of slabs that are kept until the pool is destroyed, so
+    // freeing and reallocating the same sizes never reaches malloc. Larger requests go straight to
+    // operator new. Resizing within a size class happens in place. Not thread-safe.
+    class Pool {
+    public:
+        using size_type = types::size_t;
+
+        static constexpr size_type MIN_POOLED_BYTES = 16;
+        static constexpr size_type MAX_POOLED_BYTES = 4096;
+        static constexpr size_type SLAB_SIZE = size_type{64} << 10U;
+
+        Pool() = default;
+
+        Pool(const Pool &) = delete;
+
+        Pool(Pool &&) = delete;
+
+        ~Pool() {
+            for (auto *slab: _slabs) {
+                ::operator delete(slab, std::align_val_t(MAX_POOLED_BYTES));
+            }
+        }
+
+        auto operator=(const Pool &) -> Pool & = delete;
+
+        auto operator=(Pool &&) -> Pool & = delete;
+
+        [[nodiscard]] auto allocate(size_type bytes, size_type alignment = alignof(std::max_align_t)) -> void * {
+            const auto size = class_size(bytes, alignment);
+            if (size > MAX_POOLED_BYTES) {
+                auto *ptr = ::operator new(bytes, std::align_val_t(std::max<size_type>(alignment, alignof(std::max_align_t))));
+                _stats.bytes_reserved += bytes;
+                use(bytes);
+                return ptr;
+            }
+
+            auto &size_class = _classes[class_index(size)]; // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            if (size_class.free != nullptr) {
+                auto *chunk = size_class.free;
+                size_class.free = chunk->next;
+                use(size);
+                return chunk;
+            }
+
+            if (size_class.fresh == size_class.fresh_end) {
+                add_slab(size_class);
+            }
+            auto *chunk = size_class.fresh;
+            size_class.fresh += size; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            use(size);
+            return chunk;
+        }
+
+        // bytes and alignment must be the ones the memory was allocated with
+        void deallocate(void *ptr, size_type bytes, size_type alignment = alignof(std::max_align_t)) noexcept {
+            const auto size = class_size(bytes, alignment);
+            if (size > MAX_POOLED_BYTES) {
+                ::operator delete(ptr, std::align_val_t(std::max<size_type>(alignment, alignof(std::max_align_t))));
+                _stats.bytes_reserved -= bytes;
+                _stats.bytes_used -= bytes;
+                return;
+            }
+
+            auto &size_class = _classes[class_index(size)]; // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            size_class.free = ::new (ptr) FreeChunk{size_class.free};
+            _stats.bytes_used -= size;
+        }
+
+        // Resizes ptr without moving it, which works while the size class stays the same
+        [[nodiscard]] static auto try_extend(void * /*ptr*/, size_type old_bytes, size_type new_bytes, size_type alignment = alignof(std::max_align_t)) noexcept -> bool {
+            const auto size = class_size(old_bytes, alignment);
+            return size <= MAX_POOLED_BYTES and size == class_size(new_bytes, alignment);
+        }
+
+        void reset_high_water_mark() noexcept {
+            _stats.high_water_mark = _stats.bytes_used;
+        }
+
+        [[nodiscard]] auto stats() const noexcept -> const AllocationStats & {
+            return _stats;
+        }
+
+    private:
+        struct FreeChunk {
+            FreeChunk *next;
+        };
+
+        struct SizeClass {
+            FreeChunk *free = nullptr;
+            // Part of the newest slab of this class not handed out yet
+            std::byte *fresh = nullptr;
+            std::byte *fresh_end = nullptr;
+        };
+
+        static constexpr int NUM_CLASSES = std::countr_zero(MAX_POOLED_BYTES) - std::countr_zero(MIN_POOLED_BYTES) + 1;
+
+        std::array<SizeClass, NUM_CLASSES> _classes = {};
+        Vector<std::byte *> _slabs;
+        AllocationStats _stats;
+
+        // Chunks of a power-of-two size are aligned to that size, as slabs are aligned to the largest
+        static auto class_size(size_type bytes, size_type alignment) noexcept -> size_type {
+            return std::bit_ceil(std::max({bytes, alignment, MIN_POOLED_BYTES}));
+        }
+
+        static auto class_index(size_type size) noexcept -> int {
+            return std::countr_zero(size) - std::countr_zero(MIN_POOLED_BYTES);
+        }
+
+        void add_slab(SizeClass &size_class) {
+            auto *slab = static_cast<std::byte *>(::operator new(SLAB_SIZE, std::align_val_t(MAX_POOLED_BYTES)));
+            try {
+                _slabs.push_back(slab);
+            } catch (...) {
+                ::operator delete(slab, std::align_val_t(MAX_POOLED_BYTES));
+                throw;
+            }
+            size_class.fresh = slab;
+            size_class.fresh_end = slab + SLAB_SIZE; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            _stats.bytes_reserved += SLAB_SIZE;
+        }
+
+        void use(size_type bytes) noexcept {
+            _stats.bytes_used += bytes;
+            _stats.high_water_mark = std::max(_stats.high_water_mark, _stats.bytes_used);
+        }
+    };
+
+    // Allocator handing out memory from a Pool, which must outlive every container using it. Copies
+    // share the pool, and the allocator does not propagate on container assignment.
+    template<typename T>
+    class PoolAllocator {
+    public:
+        using value_type = T;
+
+        explicit PoolAllocator(Pool &pool) noexcept : _pool(&pool) {}
+
+        template<typename U>
+        PoolAllocator(const PoolAllocator<U> &other) noexcept : _pool(&other.pool()) {} // NOLINT(google-explicit-constructor)
+
+        [[nodiscard]] T *allocate(std::size_t n) {
+            if (n > std::allocator_traits<PoolAllocator>::max_size(*this)) {
+                throw std::bad_array_new_length();
+            }
+
+            return static_cast<T *>(_pool->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *ptr, std::size_t n) noexcept {
+            _pool->deallocate(ptr, n * sizeof(T), alignof(T));
+        }
+
+        [[nodiscard]] bool try_extend(T *ptr, std::size_t old_n, std::size_t new_n) noexcept {
+            return Pool::try_extend(ptr, old_n * sizeof(T), new_n * sizeof(T), alignof(T));
+        }
+
+        // Only used for trivially relocatable elements, so moving them with memcpy is fine
+        [[nodiscard]] T *reallocate(T *ptr, std::size_t old_n, std::size_t new_n) {
+            if (try_extend(ptr, old_n, new_n)) {
+                return ptr;
+            }
+
+            auto *new_ptr = allocate(new_n);
+            std::memcpy(static_cast<void *>(new_ptr), ptr, std::min(old_n, new_n) * sizeof(T));
+            deallocate(ptr, old_n);
+            return new_ptr;
+        }
+
+        [[nodiscard]] auto pool() const noexcept -> Pool & {
+            return *_pool;
+        }
+
+        template<typename U>
+        bool operator==(const PoolAllocator<U> &other) const noexcept { return _pool == &other.pool(); }
+
+    private:
+        Pool *_pool;
+    };
+} // namespace ds
+
+#endif //DS_POOL_ALLOCATOR_HPP
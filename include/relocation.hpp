@@ -0,0 +1,38 @@
+//
+// Created by santiago on 12.06.23.
+//
+
+#ifndef DS_RELOCATION_HPP
+#define DS_RELOCATION_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+namespace ds {
+
+    // A type is trivially relocatable if moving it to a new address and abandoning the old one is
+    // equivalent to a memcpy. Every trivially copyable type is; other types (e.g. ones owning a heap
+    // buffer through a plain pointer) can opt in by specializing this trait.
+    template<typename T>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+    template<typename T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    // Allocators that can grow or shrink a block in place (or move it bitwise, like realloc) expose
+    // reallocate(). Containers only use it for trivially relocatable element types.
+    template<typename Allocator, typename T>
+    concept reallocating_allocator = requires(Allocator alloc, T *ptr, std::size_t n) {
+        { alloc.reallocate(ptr, n, n) } -> std::same_as<T *>;
+    };
+
+    // Allocators that can sometimes resize a block without moving it expose try_extend(), which
+    // reports whether it did. Nothing moves, so containers use it for any element type.
+    template<typename Allocator, typename T>
+    concept extending_allocator = requires(Allocator alloc, T *ptr, std::size_t n) {
+        { alloc.try_extend(ptr, n, n) } -> std::same_as<bool>;
+    };
+} // namespace ds
+
+#endif //DS_RELOCATION_HPP
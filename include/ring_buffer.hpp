@@ -0,0 +1,368 @@
+//
+// Created by santiago on 27.08.23.
+//
+
+#ifndef DS_RING_BUFFER_HPP
+#define DS_RING_BUFFER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "inline_buffer.hpp"
+#include "type_definitions.hpp"
+
+namespace ds {
+
+    namespace detail {
+        // Fixed rather than std::hardware_destructive_interference_size, whose value may differ
+        // between translation units compiled with different flags
+        constexpr types::size_t CACHE_LINE_SIZE = 64;
+    } // namespace detail
+
+    // Bounded queue for exactly one producer thread and one consumer thread. Head and tail are
+    // free-running counters on separate cache lines, masked with N - 1 to find the slot. Each side
+    // keeps a private copy of the other side's counter and only rereads it when the ring looks full
+    // (or empty), so in steady state a push or pop touches no shared cache line but the slot itself.
+    template<typename T, types::size_t N>
+    class SpscRing {
+        static_assert(std::has_single_bit(N), "Capacity must be a power of 2");
+
+    public:
+        using size_type = types::size_t;
+        using value_type = T;
+
+        SpscRing() = default;
+
+        SpscRing(const SpscRing &) = delete;
+
+        SpscRing(SpscRing &&) = delete;
+
+        ~SpscRing() {
+            const auto tail = _tail.load(std::memory_order_relaxed);
+            for (auto head = _head.load(std::memory_order_relaxed); head != tail; head++) {
+                std::destroy_at(slot(head));
+            }
+        }
+
+        auto operator=(const SpscRing &) -> SpscRing & = delete;
+
+        auto operator=(SpscRing &&) -> SpscRing & = delete;
+
+        [[nodiscard]] static constexpr auto capacity() -> size_type {
+            return N;
+        }
+
+        // Only meaningful while neither side is running
+        [[nodiscard]] auto empty() const -> bool {
+            return size() == 0;
+        }
+
+        // Producer side. Copies the longest prefix of values that fits and returns its length.
+        auto push(std::span<const T> values) -> size_type {
+            const auto tail = _tail.load(std::memory_order_relaxed);
+            const auto count = std::min<size_type>(values.size(), free_slots(tail, values.size()));
+            size_type pushed = 0;
+            try {
+                for (; pushed < count; pushed++) {
+                    ::new (static_cast<void *>(slot(tail + pushed))) T(values[pushed]);
+                }
+            } catch (...) {
+                _tail.store(tail + pushed, std::memory_order_release);
+                throw;
+            }
+
+            _tail.store(tail + count, std::memory_order_release);
+            return count;
+        }
+
+        // Consumer side. Moves up to out.size() elements into out and returns how many.
+        auto pop(std::span<T> out) -> size_type {
+            const auto head = _head.load(std::memory_order_relaxed);
+            const auto count = std::min<size_type>(out.size(), available(head, out.size()));
+            size_type popped = 0;
+            try {
+                for (; popped < count; popped++) {
+                    auto *value = slot(head + popped);
+                    out[popped] = std::move(*value);
+                    std::destroy_at(value);
+                }
+            } catch (...) {
+                _head.store(head + popped, std::memory_order_release);
+                throw;
+            }
+
+            _head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        // Only meaningful while neither side is running; otherwise a snapshot that may be stale
+        [[nodiscard]] auto size() const -> size_type {
+            return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+        }
+
+        // Producer side
+        template<typename... Args>
+        auto try_emplace(Args &&...args) -> bool {
+            const auto tail = _tail.load(std::memory_order_relaxed);
+            if (free_slots(tail, 1) == 0) {
+                return false;
+            }
+
+            ::new (static_cast<void *>(slot(tail))) T(std::forward<Args>(args)...);
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side
+        auto try_pop() -> std::optional<T> {
+            const auto head = _head.load(std::memory_order_relaxed);
+            if (available(head, 1) == 0) {
+                return std::nullopt;
+            }
+
+            auto *value = slot(head);
+            std::optional<T> result(std::move(*value));
+            std::destroy_at(value);
+            _head.store(head + 1, std::memory_order_release);
+            return result;
+        }
+
+        auto try_push(const T &value) -> bool {
+            return try_emplace(value);
+        }
+
+        auto try_push(T &&value) -> bool {
+            return try_emplace(std::move(value));
+        }
+
+    private:
+        static constexpr size_type MASK = N - 1;
+
+        // Written by the consumer
+        alignas(detail::CACHE_LINE_SIZE) std::atomic<size_type> _head = 0;
+        size_type _cached_tail = 0;
+        // Written by the producer
+        alignas(detail::CACHE_LINE_SIZE) std::atomic<size_type> _tail = 0;
+        size_type _cached_head = 0;
+        alignas(detail::CACHE_LINE_SIZE) detail::InlineBuffer<T, N> _slots;
+
+        auto slot(size_type index) -> T * {
+            return _slots.data() + (index & MASK); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        // Free slots from tail on, rereading the consumer's head only if fewer than wanted are known
+        auto free_slots(size_type tail, size_type wanted) -> size_type {
+            if (N - (tail - _cached_head) < wanted) {
+                _cached_head = _head.load(std::memory_order_acquire);
+            }
+            return N - (tail - _cached_head);
+        }
+
+        // Elements from head on, rereading the producer's tail only if fewer than wanted are known
+        auto available(size_type head, size_type wanted) -> size_type {
+            if (_cached_tail - head < wanted) {
+                _cached_tail = _tail.load(std::memory_order_acquire);
+            }
+            return _cached_tail - head;
+        }
+    };
+
+    // Bounded queue for any number of producers and consumers (Dmitry Vyukov's design). Each slot
+    // carries a sequence number saying whether it is ready for the producer or the consumer of a
+    // given position, so threads only contend on the position counters, which sit on their own
+    // cache lines. The capacity is rounded up to a power of 2.
+    // A claimed slot cannot be given back, so nothing may throw between claiming and publishing it:
+    // elements are built before claiming a slot and moved in, which must not throw.
+    template<typename T>
+    class MpmcRing {
+        static_assert(std::is_nothrow_move_constructible_v<T> and std::is_nothrow_move_assignable_v<T>, "Moving elements must not throw");
+
+    public:
+        using size_type = types::size_t;
+        using value_type = T;
+
+        explicit MpmcRing(size_type min_capacity)
+            : _capacity(std::bit_ceil(std::max<size_type>(min_capacity, 2))), _cells(std::make_unique<Cell[]>(_capacity)) { // NOLINT(cppcoreguidelines-avoid-c-arrays)
+            for (size_type i = 0; i < _capacity; i++) {
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpmcRing(const MpmcRing &) = delete;
+
+        MpmcRing(MpmcRing &&) = delete;
+
+        ~MpmcRing() {
+            while (try_pop()) {
+            }
+        }
+
+        auto operator=(const MpmcRing &) -> MpmcRing & = delete;
+
+        auto operator=(MpmcRing &&) -> MpmcRing & = delete;
+
+        [[nodiscard]] auto capacity() const -> size_type {
+            return _capacity;
+        }
+
+        // Copies the longest prefix of values that fits, claiming all its slots at once, and returns its length
+        auto push(std::span<const T> values) -> size_type
+            requires std::is_nothrow_copy_constructible_v<T>
+        {
+            if (values.empty()) {
+                return 0;
+            }
+
+            auto position = _enqueue_position.load(std::memory_order_relaxed);
+            while (true) {
+                const auto dif = distance(position, 0);
+                if (dif < 0) {
+                    return 0;
+                }
+                if (dif > 0) {
+                    position = _enqueue_position.load(std::memory_order_relaxed);
+                    continue;
+                }
+
+                const auto count = 1 + ready_cells(position + 1, values.size() - 1, 0);
+                if (_enqueue_position.compare_exchange_weak(position, position + count, std::memory_order_relaxed)) {
+                    for (size_type i = 0; i < count; i++) {
+                        auto &target = cell(position + i);
+                        ::new (static_cast<void *>(target.value())) T(values[i]);
+                        target.sequence.store(position + i + 1, std::memory_order_release);
+                    }
+                    return count;
+                }
+            }
+        }
+
+        // Moves up to out.size() elements into out, claiming all their slots at once, and returns how many
+        auto pop(std::span<T> out) -> size_type {
+            if (out.empty()) {
+                return 0;
+            }
+
+            auto position = _dequeue_position.load(std::memory_order_relaxed);
+            while (true) {
+                const auto dif = distance(position, 1);
+                if (dif < 0) {
+                    return 0;
+                }
+                if (dif > 0) {
+                    position = _dequeue_position.load(std::memory_order_relaxed);
+                    continue;
+                }
+
+                const auto count = 1 + ready_cells(position + 1, out.size() - 1, 1);
+                if (_dequeue_position.compare_exchange_weak(position, position + count, std::memory_order_relaxed)) {
+                    for (size_type i = 0; i < count; i++) {
+                        auto &source = cell(position + i);
+                        out[i] = std::move(*source.value());
+                        std::destroy_at(source.value());
+                        source.sequence.store(position + i + _capacity, std::memory_order_release);
+                    }
+                    return count;
+                }
+            }
+        }
+
+        template<typename... Args>
+        auto try_emplace(Args &&...args) -> bool {
+            T value(std::forward<Args>(args)...);
+            auto position = _enqueue_position.load(std::memory_order_relaxed);
+            while (true) {
+                const auto dif = distance(position, 0);
+                if (dif < 0) {
+                    return false;
+                }
+                if (dif > 0) {
+                    position = _enqueue_position.load(std::memory_order_relaxed);
+                    continue;
+                }
+                if (_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    auto &target = cell(position);
+                    ::new (static_cast<void *>(target.value())) T(std::move(value));
+                    target.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+
+        auto try_pop() -> std::optional<T> {
+            auto position = _dequeue_position.load(std::memory_order_relaxed);
+            while (true) {
+                const auto dif = distance(position, 1);
+                if (dif < 0) {
+                    return std::nullopt;
+                }
+                if (dif > 0) {
+                    position = _dequeue_position.load(std::memory_order_relaxed);
+                    continue;
+                }
+                if (_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    auto &source = cell(position);
+                    std::optional<T> result(std::move(*source.value()));
+                    std::destroy_at(source.value());
+                    source.sequence.store(position + _capacity, std::memory_order_release);
+                    return result;
+                }
+            }
+        }
+
+        auto try_push(const T &value) -> bool {
+            return try_emplace(value);
+        }
+
+        auto try_push(T &&value) -> bool {
+            return try_emplace(std::move(value));
+        }
+
+    private:
+        struct Cell {
+            // position when free for the producer of position, position + 1 when holding its value
+            std::atomic<size_type> sequence;
+            alignas(T) std::byte storage[sizeof(T)]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+            auto value() -> T * {
+                return reinterpret_cast<T *>(storage); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            }
+        };
+
+        const size_type _capacity;
+        const std::unique_ptr<Cell[]> _cells; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+        alignas(detail::CACHE_LINE_SIZE) std::atomic<size_type> _enqueue_position = 0;
+        alignas(detail::CACHE_LINE_SIZE) std::atomic<size_type> _dequeue_position = 0;
+
+        auto cell(size_type position) -> Cell & {
+            return _cells[position & (_capacity - 1)];
+        }
+
+        // How far the sequence of the cell of position is from position plus lag: 0 for cells a producer
+        // may fill, 1 for cells a consumer may empty. Below 0 the cell is still in use from the previous
+        // lap, so the ring is full or empty; above 0 another thread already claimed position, and the
+        // position counter has to be read again.
+        auto distance(size_type position, size_type lag) -> types::ptrdiff_t {
+            return static_cast<types::ptrdiff_t>(cell(position).sequence.load(std::memory_order_acquire) - (position + lag));
+        }
+
+        // Consecutive cells from position on, up to wanted, whose sequence is their position plus lag
+        auto ready_cells(size_type position, size_type wanted, size_type lag) -> size_type {
+            size_type count = 0;
+            while (count < wanted and count < _capacity and
+                   cell(position + count).sequence.load(std::memory_order_acquire) == position + count + lag) {
+                count++;
+            }
+            return count;
+        }
+    };
+} // namespace ds
+
+#endif //DS_RING_BUFFER_HPP
@@ -0,0 +1,101 @@
+//
+// Created by santiago on 20.08.23.
+//
+
+#ifndef DS_SEGMENTED_ITERATOR_HPP
+#define DS_SEGMENTED_ITERATOR_HPP
+
+#include <compare>
+#include <iterator>
+#include <type_traits>
+
+
+namespace it {
+
+    // Random-access iterator over a container whose elements live in separate blocks, such as
+    // ds::Deque. It stores the element's position rather than its address, which Container maps
+    // to an address through element_address(). Positions never change while an element is alive,
+    // so iterators stay valid when elements are added or removed at either end.
+    template<typename Container, typename ReferenceType>
+    struct SegmentedIterator {
+        using iterator_concept [[maybe_unused]] = std::random_access_iterator_tag;
+        using iterator_category [[maybe_unused]] = std::random_access_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = typename Container::value_type;
+        using pointer = std::add_pointer_t<ReferenceType>;
+        using reference = ReferenceType;
+
+        SegmentedIterator() = default;
+
+        SegmentedIterator(const Container *container, difference_type position) : _container(container), _position(position) {}
+
+        template<typename OtherReference>
+            requires(not std::is_same_v<OtherReference, ReferenceType> and std::is_convertible_v<OtherReference, ReferenceType>)
+        SegmentedIterator(const SegmentedIterator<Container, OtherReference> &other) : _container(other.container()), _position(other.position()) {} // NOLINT(google-explicit-constructor)
+
+        reference operator*() const { return *_container->element_address(_position); }
+
+        pointer operator->() const { return _container->element_address(_position); }
+
+        SegmentedIterator &operator++() {
+            _position++;
+            return *this;
+        }
+
+        SegmentedIterator operator++(int) {
+            SegmentedIterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        SegmentedIterator &operator+=(difference_type i) {
+            _position += i;
+            return *this;
+        }
+
+        SegmentedIterator operator+(const difference_type other) const { return SegmentedIterator(_container, _position + other); }
+
+        friend SegmentedIterator operator+(const difference_type value,
+                                           const SegmentedIterator &other) {
+            return other + value;
+        }
+
+        SegmentedIterator &operator--() {
+            _position--;
+            return *this;
+        }
+
+        SegmentedIterator operator--(int) {
+            SegmentedIterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        SegmentedIterator &operator-=(difference_type i) {
+            _position -= i;
+            return *this;
+        }
+
+        difference_type operator-(const SegmentedIterator &other) const {
+            return _position - other._position;
+        }
+
+        SegmentedIterator operator-(const difference_type other) const { return SegmentedIterator(_container, _position - other); }
+
+        reference operator[](difference_type idx) const { return *(*this + idx); }
+
+        bool operator==(const SegmentedIterator &other) const { return _position == other._position; }
+
+        auto operator<=>(const SegmentedIterator &other) const { return _position <=> other._position; }
+
+        [[nodiscard]] auto container() const { return _container; }
+
+        [[nodiscard]] auto position() const { return _position; }
+
+    private:
+        const Container *_container = nullptr;
+        difference_type _position = 0;
+    };
+} // namespace it
+
+#endif //DS_SEGMENTED_ITERATOR_HPP
@@ -0,0 +1,469 @@
+//
+// Created by santiago on 01.10.23.
+//
+
+#ifndef DS_SERIALIZATION_HPP
+#define DS_SERIALIZATION_HPP
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include "type_definitions.hpp"
+#include "vector.hpp"
+
+// Binary snapshots of Vectors, written to and read from file descriptors or iostreams. Vectors of
+// trivially copyable elements are stored as their raw bytes and moved with one system call where
+// the kernel allows it; other elements (nested Vectors, strings) are stored length-prefixed.
+// Data is stored in native byte order, so snapshots are only portable between similar machines.
+namespace ds::io {
+
+    // First bytes of every serialized Vector
+    struct SerializedVectorHeader {
+        static constexpr std::array<char, 8> MAGIC = {'D', 'S', 'S', 'E', 'R', 'I', 'A', 'L'};
+        static constexpr std::uint32_t VERSION = 2;
+
+        std::array<char, 8> magic;
+        std::uint32_t version;
+        // sizeof(T) for raw elements, 0 for length-prefixed ones
+        std::uint32_t element_size;
+        std::uint64_t size;
+        // Bytes following the header, so readers never consume input beyond the vector
+        std::uint64_t payload_bytes;
+        // Hash of the element type's structure, see detail::TypeTag
+        std::uint64_t element_type;
+    };
+
+    namespace detail {
+        // Largest transfer per system call; Linux moves at most 0x7ffff000 bytes at a time anyway
+        constexpr types::size_t MAX_TRANSFER = types::size_t{1} << 30U;
+        constexpr types::size_t IO_BUFFER_SIZE = types::size_t{1} << 16U;
+
+        template<typename T>
+        struct Codec;
+
+        [[noreturn]] inline void throw_truncated() {
+            throw std::runtime_error("Unexpected end of input");
+        }
+
+        constexpr auto mix_tag(std::uint64_t hash, std::uint64_t value) -> std::uint64_t {
+            constexpr std::uint64_t FNV_PRIME = 0x100000001b3;
+            return (hash ^ value) * FNV_PRIME;
+        }
+
+        constexpr std::uint64_t TAG_SEED = 0xcbf29ce484222325;
+
+        // Identifies an element type by its structure, so that no other type reads it back: raw
+        // elements by their kind of number and size, sequences by their kind and the tag of what they
+        // hold. Trivially copyable classes are only told apart by their size.
+        template<typename T>
+        struct TypeTag {
+            static constexpr char KIND = std::is_same_v<T, bool> ? 'b'
+                                         : std::is_floating_point_v<T> ? 'f'
+                                         : std::is_signed_v<T> ? 'i'
+                                         : std::is_unsigned_v<T> ? 'u'
+                                                                 : 'r';
+            static constexpr std::uint64_t value = mix_tag(mix_tag(TAG_SEED, KIND), sizeof(T));
+        };
+
+        template<typename T, typename Allocator, types::size_t InlineCapacity, typename GrowthPolicy>
+        struct TypeTag<Vector<T, Allocator, InlineCapacity, GrowthPolicy>> {
+            static constexpr std::uint64_t value = mix_tag(mix_tag(TAG_SEED, 'V'), TypeTag<T>::value);
+        };
+
+        template<typename Char, typename Traits, typename Allocator>
+        struct TypeTag<std::basic_string<Char, Traits, Allocator>> {
+            static constexpr std::uint64_t value = mix_tag(mix_tag(TAG_SEED, 'S'), TypeTag<Char>::value);
+        };
+
+        template<typename T>
+        concept raw_element = std::is_trivially_copyable_v<T> and std::is_default_constructible_v<T>;
+
+        template<typename T>
+        concept serializable = requires(const T &value) { Codec<T>::size(value); };
+
+        // Element types stored as their bytes
+        template<raw_element T>
+        struct Codec<T> {
+            static auto size(const T & /*value*/) -> types::size_t {
+                return sizeof(T);
+            }
+
+            template<typename Writer>
+            static void write(Writer &writer, const T &value) {
+                writer.write(&value, sizeof(T));
+            }
+
+            template<typename Reader>
+            static void read(Reader &reader, T &value) {
+                reader.read(&value, sizeof(T));
+            }
+        };
+
+        // Length, then the elements: in one piece if they are raw, one after the other otherwise
+        template<typename Container, typename T>
+        struct SequenceCodec {
+            static auto size(const Container &values) -> types::size_t {
+                types::size_t bytes = sizeof(std::uint64_t);
+                if constexpr (raw_element<T>) {
+                    bytes += values.size() * sizeof(T);
+                } else {
+                    for (const auto &value: values) {
+                        bytes += Codec<T>::size(value);
+                    }
+                }
+                return bytes;
+            }
+
+            template<typename Writer>
+            static void write(Writer &writer, const Container &values) {
+                const std::uint64_t count = values.size();
+                writer.write(&count, sizeof(count));
+                write_elements(writer, values);
+            }
+
+            template<typename Writer>
+            static void write_elements(Writer &writer, const Container &values) {
+                if constexpr (raw_element<T>) {
+                    writer.write(values.data(), values.size() * sizeof(T));
+                } else {
+                    for (const auto &value: values) {
+                        Codec<T>::write(writer, value);
+                    }
+                }
+            }
+
+            template<typename Reader>
+            static void read(Reader &reader, Container &values) {
+                std::uint64_t count = 0;
+                reader.read(&count, sizeof(count));
+                read_elements(reader, values, count);
+            }
+
+            template<typename Reader>
+            static void read_elements(Reader &reader, Container &values, types::size_t count) {
+                values.clear();
+                if constexpr (raw_element<T>) {
+                    // A corrupt length must not turn into a huge allocation before it is detected, nor wrap
+                    // around when converted to bytes
+                    if (count > std::numeric_limits<types::size_t>::max() / sizeof(T)) {
+                        throw_truncated();
+                    }
+                    reader.check_available(count * sizeof(T));
+                    if constexpr (requires { values.resize_for_overwrite(count); }) {
+                        values.resize_for_overwrite(count);
+                    } else {
+                        values.resize(count);
+                    }
+                    reader.read(values.data(), count * sizeof(T));
+                } else {
+                    reader.check_available(count);
+                    values.reserve(count);
+                    for (types::size_t i = 0; i < count; i++) {
+                        T value;
+                        Codec<T>::read(reader, value);
+                        values.push_back(std::move(value));
+                    }
+                }
+            }
+        };
+
+        template<serializable T, typename Allocator, types::size_t InlineCapacity, typename GrowthPolicy>
+        struct Codec<Vector<T, Allocator, InlineCapacity, GrowthPolicy>> : SequenceCodec<Vector<T, Allocator, InlineCapacity, GrowthPolicy>, T> {};
+
+        template<typename Char, typename Traits, typename Allocator>
+        struct Codec<std::basic_string<Char, Traits, Allocator>> : SequenceCodec<std::basic_string<Char, Traits, Allocator>, Char> {};
+
+        // Buffers small writes; large ones go out in one writev() together with what is buffered
+        class FdWriter {
+        public:
+            explicit FdWriter(int fd) : _fd(fd), _buffer(IO_BUFFER_SIZE) {}
+
+            void write(const void *data, types::size_t bytes) {
+                // Empty vectors pass a null data(), which memcpy must not see
+                if (bytes == 0) {
+                    return;
+                }
+
+                if (_used + bytes <= _buffer.size()) {
+                    std::memcpy(_buffer.data() + _used, data, bytes); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    _used += bytes;
+                    return;
+                }
+
+                std::array<iovec, 2> parts{iovec{_buffer.data(), _used}, iovec{const_cast<void *>(data), bytes}}; // NOLINT(cppcoreguidelines-pro-type-const-cast)
+                write_all(parts.data(), static_cast<int>(parts.size()));
+                _used = 0;
+            }
+
+            void flush() {
+                if (_used > 0) {
+                    iovec part{_buffer.data(), _used};
+                    write_all(&part, 1);
+                    _used = 0;
+                }
+            }
+
+        private:
+            int _fd;
+            Vector<std::byte> _buffer;
+            types::size_t _used = 0;
+
+            void write_all(iovec *parts, int count) {
+                while (count > 0) {
+                    // Each call moves at most MAX_TRANSFER bytes: a larger first part goes out alone, clamped
+                    const auto length = parts[0].iov_len;                               // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    parts[0].iov_len = std::min<types::size_t>(length, MAX_TRANSFER); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    const auto written = ::writev(_fd, parts, length <= MAX_TRANSFER ? count : 1);
+                    parts[0].iov_len = length; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    if (written < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        throw std::system_error(errno, std::generic_category(), "Cannot write vector");
+                    }
+
+                    // Skip the parts written in full and advance into the first one that is not
+                    auto remaining = static_cast<types::size_t>(written);
+                    while (count > 0 and remaining >= parts[0].iov_len) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                        remaining -= parts[0].iov_len;                    // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                        parts++;                                          // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                        count--;
+                    }
+                    if (count > 0) {
+                        parts[0].iov_base = static_cast<std::byte *>(parts[0].iov_base) + remaining; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                        parts[0].iov_len -= remaining;                                             // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    }
+                }
+            }
+        };
+
+        // Reads at most limit bytes, so that whatever follows the vector stays in the descriptor.
+        // Small reads are served from a buffer; large ones go straight to their destination.
+        class FdReader {
+        public:
+            FdReader(int fd, types::size_t limit) : _fd(fd), _limit(limit), _buffer(std::min(limit, IO_BUFFER_SIZE)) {}
+
+            void check_available(types::size_t bytes) const {
+                if (bytes > _limit + (_end - _begin)) {
+                    throw_truncated();
+                }
+            }
+
+            void read(void *data, types::size_t bytes) {
+                // Empty vectors pass a null data(), and an empty payload leaves the buffer unallocated
+                if (bytes == 0) {
+                    return;
+                }
+
+                auto *out = static_cast<std::byte *>(data);
+                const auto buffered = std::min(bytes, _end - _begin);
+                if (buffered > 0) {
+                    std::memcpy(out, _buffer.data() + _begin, buffered); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    _begin += buffered;
+                    out += buffered;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    bytes -= buffered;
+                    if (bytes == 0) {
+                        return;
+                    }
+                }
+
+                if (bytes >= _buffer.size()) {
+                    read_exactly(out, bytes);
+                    return;
+                }
+
+                _begin = 0;
+                _end = read_at_least(_buffer.data(), bytes, std::min<types::size_t>(_buffer.size(), _limit));
+                std::memcpy(out, _buffer.data(), bytes);
+                _begin = bytes;
+            }
+
+            // Bytes of the vector not consumed, which means its payload length was wrong
+            [[nodiscard]] auto unread() const -> types::size_t {
+                return _limit + (_end - _begin);
+            }
+
+        private:
+            int _fd;
+            types::size_t _limit;
+            Vector<std::byte> _buffer;
+            types::size_t _begin = 0;
+            types::size_t _end = 0;
+
+            void read_exactly(std::byte *out, types::size_t bytes) {
+                read_at_least(out, bytes, bytes);
+            }
+
+            // Reads between min and max bytes into out and returns how many
+            auto read_at_least(std::byte *out, types::size_t min, types::size_t max) -> types::size_t {
+                if (min > _limit) {
+                    throw_truncated();
+                }
+
+                types::size_t done = 0;
+                while (done < min) {
+                    const auto result = ::read(_fd, out + done, std::min(max - done, MAX_TRANSFER)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    if (result < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        throw std::system_error(errno, std::generic_category(), "Cannot read vector");
+                    }
+                    if (result == 0) {
+                        throw_truncated();
+                    }
+                    done += static_cast<types::size_t>(result);
+                }
+                _limit -= done;
+                return done;
+            }
+        };
+
+        class StreamWriter {
+        public:
+            explicit StreamWriter(std::ostream &stream) : _stream(stream) {}
+
+            void write(const void *data, types::size_t bytes) {
+                const auto *in = static_cast<const char *>(data);
+                for (types::size_t done = 0; done < bytes;) {
+                    const auto chunk = std::min(bytes - done, MAX_TRANSFER);
+                    _stream.write(in + done, static_cast<std::streamsize>(chunk)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    done += chunk;
+                }
+                if (not _stream) {
+                    throw std::runtime_error("Cannot write vector");
+                }
+            }
+
+            void flush() {
+                _stream.flush();
+                if (not _stream) {
+                    throw std::runtime_error("Cannot write vector");
+                }
+            }
+
+        private:
+            std::ostream &_stream;
+        };
+
+        class StreamReader {
+        public:
+            StreamReader(std::istream &stream, types::size_t limit) : _stream(stream), _limit(limit) {}
+
+            void check_available(types::size_t bytes) const {
+                if (bytes > _limit) {
+                    throw_truncated();
+                }
+            }
+
+            void read(void *data, types::size_t bytes) {
+                check_available(bytes);
+                auto *out = static_cast<char *>(data);
+                for (types::size_t done = 0; done < bytes;) {
+                    const auto chunk = std::min(bytes - done, MAX_TRANSFER);
+                    _stream.read(out + done, static_cast<std::streamsize>(chunk)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    if (static_cast<types::size_t>(_stream.gcount()) != chunk) {
+                        throw_truncated();
+                    }
+                    done += chunk;
+                }
+                _limit -= bytes;
+            }
+
+            [[nodiscard]] auto unread() const -> types::size_t {
+                return _limit;
+            }
+
+        private:
+            std::istream &_stream;
+            types::size_t _limit;
+        };
+
+        template<typename T>
+        constexpr auto element_size() -> std::uint32_t {
+            return raw_element<T> ? sizeof(T) : 0;
+        }
+
+        template<typename Writer, typename T, typename Allocator, types::size_t InlineCapacity, typename GrowthPolicy>
+        void write_vector(Writer &writer, const Vector<T, Allocator, InlineCapacity, GrowthPolicy> &values) {
+            using Sequence = SequenceCodec<Vector<T, Allocator, InlineCapacity, GrowthPolicy>, T>;
+            const SerializedVectorHeader header{SerializedVectorHeader::MAGIC, SerializedVectorHeader::VERSION, element_size<T>(), values.size(),
+                                                Sequence::size(values) - sizeof(std::uint64_t), TypeTag<T>::value};
+            writer.write(&header, sizeof(header));
+            Sequence::write_elements(writer, values);
+            writer.flush();
+        }
+
+        template<typename T>
+        void check_header(const SerializedVectorHeader &header) {
+            if (header.magic != SerializedVectorHeader::MAGIC or header.version != SerializedVectorHeader::VERSION) {
+                throw std::runtime_error("Input is not a serialized vector");
+            }
+            if (header.element_size != element_size<T>() or header.element_type != TypeTag<T>::value) {
+                throw std::runtime_error("Serialized vector has a different element type");
+            }
+        }
+
+        template<typename Reader, typename T, typename Allocator, types::size_t InlineCapacity, typename GrowthPolicy>
+        void read_vector(Reader &reader, Vector<T, Allocator, InlineCapacity, GrowthPolicy> &values, types::size_t count) {
+            SequenceCodec<Vector<T, Allocator, InlineCapacity, GrowthPolicy>, T>::read_elements(reader, values, count);
+            if (reader.unread() != 0) {
+                throw std::runtime_error("Serialized vector is longer than its elements");
+            }
+        }
+    } // namespace detail
+
+    // Writes values to fd, starting at its current offset
+    template<detail::serializable T, typename Allocator, types::size_t InlineCapacity, typename GrowthPolicy>
+    void write(int fd, const Vector<T, Allocator, InlineCapacity, GrowthPolicy> &values) {
+        detail::FdWriter writer(fd);
+        detail::write_vector(writer, values);
+    }
+
+    template<detail::serializable T, typename Allocator, types::size_t InlineCapacity, typename GrowthPolicy>
+    void write(std::ostream &stream, const Vector<T, Allocator, InlineCapacity, GrowthPolicy> &values) {
+        detail::StreamWriter writer(stream);
+        detail::write_vector(writer, values);
+    }
+
+    // Replaces the contents of values with a vector written by write(). Consumes exactly the bytes
+    // write() produced, so several vectors can be read back to back from one descriptor or pipe.
+    // Throws std::runtime_error on input that is truncated or holds other element types (as far as
+    // detail::TypeTag tells them apart), and std::system_error if reading fails.
+    template<detail::serializable T, typename Allocator, types::size_t InlineCapacity, typename GrowthPolicy>
+    void read(int fd, Vector<T, Allocator, InlineCapacity, GrowthPolicy> &values) {
+        SerializedVectorHeader header{};
+        detail::FdReader header_reader(fd, sizeof(header));
+        header_reader.read(&header, sizeof(header));
+        detail::check_header<T>(header);
+
+        detail::FdReader reader(fd, header.payload_bytes);
+        detail::read_vector(reader, values, header.size);
+    }
+
+    template<detail::serializable T, typename Allocator, types::size_t InlineCapacity, typename GrowthPolicy>
+    void read(std::istream &stream, Vector<T, Allocator, InlineCapacity, GrowthPolicy> &values) {
+        SerializedVectorHeader header{};
+        detail::StreamReader header_reader(stream, sizeof(header));
+        header_reader.read(&header, sizeof(header));
+        detail::check_header<T>(header);
+
+        detail::StreamReader reader(stream, header.payload_bytes);
+        detail::read_vector(reader, values, header.size);
+    }
+} // namespace ds::io
+
+#endif //DS_SERIALIZATION_HPP
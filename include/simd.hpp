@@ -0,0 +1,336 @@
+//
+// Created by santiago on 16.07.23.
+//
+
+#ifndef DS_SIMD_HPP
+#define DS_SIMD_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+
+#include "type_definitions.hpp"
+
+// Vectorized kernels for ranges of integers and floating point numbers. Kernels are written once
+// with GCC/Clang vector extensions and instantiated for 128, 256 and 512-bit registers; on x86 the
+// widest one supported by the running CPU is picked at runtime, so binaries need no -mavx2 flag.
+//
+// sum() adds lanes in a different order than a sequential loop, so floating point results may
+// differ in the last bits. Comparisons follow IEEE semantics (NaN != NaN, -0.0 == 0.0).
+
+#if defined(__GNUC__)
+#define DS_SIMD_VECTOR_EXTENSIONS 1
+#define DS_SIMD_ALWAYS_INLINE [[gnu::always_inline]] inline
+#else
+#define DS_SIMD_ALWAYS_INLINE inline
+#endif
+
+namespace ds::simd {
+
+    template<typename T>
+    concept vectorizable = (std::integral<T> or std::floating_point<T>) and not std::same_as<T, bool> and sizeof(T) <= 8;
+
+    namespace detail {
+
+#if defined(DS_SIMD_VECTOR_EXTENSIONS)
+        template<typename T, int Bytes>
+        struct RegisterOf {
+            typedef T type __attribute__((vector_size(Bytes))); // NOLINT(modernize-use-using)
+        };
+
+        template<typename T, int Bytes>
+        using Register = typename RegisterOf<T, Bytes>::type;
+
+        // Registers are only passed by reference: passing wide vectors by value is ABI dependent
+        template<typename Reg, typename T>
+        DS_SIMD_ALWAYS_INLINE void load(Reg &reg, const T *ptr) {
+            std::memcpy(&reg, ptr, sizeof(reg));
+        }
+
+        template<typename Mask>
+        DS_SIMD_ALWAYS_INLINE auto any(const Mask &mask) -> bool {
+            for (int lane = 0; lane < static_cast<int>(sizeof(mask) / sizeof(mask[0])); lane++) {
+                if (mask[lane] != 0) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+#endif
+
+        template<typename T, int Bytes>
+        constexpr types::size_t LANES = Bytes / sizeof(T);
+
+        struct EqualKernel {
+            template<int Bytes, typename T>
+            DS_SIMD_ALWAYS_INLINE static auto run(const T *lhs, const T *rhs, types::size_t n) -> bool {
+                types::size_t i = 0;
+#if defined(DS_SIMD_VECTOR_EXTENSIONS)
+                Register<T, Bytes> lhs_reg;
+                Register<T, Bytes> rhs_reg;
+                for (; i + LANES<T, Bytes> <= n; i += LANES<T, Bytes>) {
+                    load(lhs_reg, lhs + i); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    load(rhs_reg, rhs + i); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    if (any(lhs_reg != rhs_reg)) {
+                        return false;
+                    }
+                }
+#endif
+                return std::equal(lhs + i, lhs + n, rhs + i); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        };
+
+        struct FillKernel {
+            template<int Bytes, typename T>
+            DS_SIMD_ALWAYS_INLINE static void run(T *dest, types::size_t n, T value) {
+                types::size_t i = 0;
+#if defined(DS_SIMD_VECTOR_EXTENSIONS)
+                const Register<T, Bytes> reg = Register<T, Bytes>{} + value;
+                for (; i + LANES<T, Bytes> <= n; i += LANES<T, Bytes>) {
+                    std::memcpy(dest + i, &reg, sizeof(reg)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                }
+#endif
+                std::fill(dest + i, dest + n, value); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        };
+
+        struct FindKernel {
+            template<int Bytes, typename T>
+            DS_SIMD_ALWAYS_INLINE static auto run(const T *values, types::size_t n, T value) -> types::size_t {
+                types::size_t i = 0;
+#if defined(DS_SIMD_VECTOR_EXTENSIONS)
+                const Register<T, Bytes> needle = Register<T, Bytes>{} + value;
+                Register<T, Bytes> reg;
+                for (; i + LANES<T, Bytes> <= n; i += LANES<T, Bytes>) {
+                    load(reg, values + i); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    if (any(reg == needle)) {
+                        break;
+                    }
+                }
+#endif
+                return std::find(values + i, values + n, value) - values; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        };
+
+        struct CountKernel {
+            template<int Bytes, typename T>
+            DS_SIMD_ALWAYS_INLINE static auto run(const T *values, types::size_t n, T value) -> types::size_t {
+                types::size_t i = 0;
+                types::size_t count = 0;
+#if defined(DS_SIMD_VECTOR_EXTENSIONS)
+                // Matching lanes are -1, so subtracting masks counts per lane. Narrow lanes are
+                // flushed before they can overflow.
+                constexpr types::size_t FLUSH_EVERY = sizeof(T) == 1 ? 127 : (sizeof(T) == 2 ? 32767 : ~types::size_t{0});
+                const Register<T, Bytes> needle = Register<T, Bytes>{} + value;
+                Register<T, Bytes> reg;
+                while (i + LANES<T, Bytes> <= n) {
+                    decltype(needle == needle) counters = {};
+                    for (types::size_t iteration = 0; iteration < FLUSH_EVERY and i + LANES<T, Bytes> <= n; iteration++, i += LANES<T, Bytes>) {
+                        load(reg, values + i); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                        counters -= reg == needle;
+                    }
+
+                    for (types::size_t lane = 0; lane < LANES<T, Bytes>; lane++) {
+                        count += static_cast<types::size_t>(counters[lane]);
+                    }
+                }
+#endif
+                return count + std::count(values + i, values + n, value); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        };
+
+        template<bool Min>
+        struct ExtremumKernel {
+            template<int Bytes, typename T>
+            DS_SIMD_ALWAYS_INLINE static auto run(const T *values, types::size_t n) -> T {
+                const auto pick = [](T lhs, T rhs) { return Min ? std::min(lhs, rhs) : std::max(lhs, rhs); };
+
+                T result = values[0];
+                types::size_t i = 0;
+#if defined(DS_SIMD_VECTOR_EXTENSIONS)
+                if (n >= LANES<T, Bytes>) {
+                    Register<T, Bytes> best;
+                    Register<T, Bytes> reg;
+                    load(best, values);
+                    for (i = LANES<T, Bytes>; i + LANES<T, Bytes> <= n; i += LANES<T, Bytes>) {
+                        load(reg, values + i); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                        best = (Min ? reg < best : reg > best) ? reg : best;
+                    }
+
+                    for (types::size_t lane = 0; lane < LANES<T, Bytes>; lane++) {
+                        result = pick(result, best[lane]);
+                    }
+                }
+#endif
+                for (; i < n; i++) {
+                    result = pick(result, values[i]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                }
+
+                return result;
+            }
+        };
+
+        // Integers are added as unsigned, whose overflow wraps around instead of being undefined
+        template<typename T>
+        using accumulator_t = typename std::conditional_t<std::is_integral_v<T>, std::make_unsigned<T>, std::type_identity<T>>::type;
+
+        struct SumKernel {
+            template<int Bytes, typename T>
+            DS_SIMD_ALWAYS_INLINE static auto run(const T *values, types::size_t n) -> T {
+                using Accumulator = accumulator_t<T>;
+                Accumulator result{};
+                types::size_t i = 0;
+#if defined(DS_SIMD_VECTOR_EXTENSIONS)
+                Register<Accumulator, Bytes> partial = {};
+                Register<Accumulator, Bytes> reg;
+                for (; i + LANES<T, Bytes> <= n; i += LANES<T, Bytes>) {
+                    load(reg, values + i); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    partial += reg;
+                }
+
+                for (types::size_t lane = 0; lane < LANES<T, Bytes>; lane++) {
+                    result += partial[lane];
+                }
+#endif
+                for (; i < n; i++) {
+                    result += static_cast<Accumulator>(values[i]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                }
+
+                return static_cast<T>(result);
+            }
+        };
+
+        enum class Isa {
+            generic,
+            avx2,
+            avx512
+        };
+
+#if defined(DS_SIMD_VECTOR_EXTENSIONS) && (defined(__x86_64__) || defined(__i386__))
+        inline auto detect_isa() -> Isa {
+            static const Isa isa = [] {
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512bw")) {
+                    return Isa::avx512;
+                }
+
+                if (__builtin_cpu_supports("avx2")) {
+                    return Isa::avx2;
+                }
+
+                return Isa::generic;
+            }();
+            return isa;
+        }
+
+        template<typename Kernel, typename... Args>
+        __attribute__((target("avx512f,avx512bw"))) auto run_avx512(Args... args) {
+            return Kernel::template run<64>(args...);
+        }
+
+        template<typename Kernel, typename... Args>
+        __attribute__((target("avx2"))) auto run_avx2(Args... args) {
+            return Kernel::template run<32>(args...);
+        }
+#else
+        inline auto detect_isa() -> Isa {
+            return Isa::generic;
+        }
+#endif
+
+        // Runs Kernel compiled for the widest vector registers the CPU supports
+        template<typename Kernel, typename... Args>
+        auto dispatch(Args... args) {
+#if defined(DS_SIMD_VECTOR_EXTENSIONS) && (defined(__x86_64__) || defined(__i386__))
+            switch (detect_isa()) {
+                case Isa::avx512:
+                    return run_avx512<Kernel>(args...);
+                case Isa::avx2:
+                    return run_avx2<Kernel>(args...);
+                case Isa::generic:
+                    break;
+            }
+#endif
+            return Kernel::template run<16>(args...);
+        }
+
+        template<typename Range>
+        using value_t = std::ranges::range_value_t<Range>;
+    } // namespace detail
+
+    template<std::ranges::contiguous_range Range>
+        requires vectorizable<detail::value_t<Range>>
+    auto equal(const Range &lhs, const Range &rhs) -> bool {
+        const auto n = static_cast<types::size_t>(std::ranges::size(lhs));
+        if (n != static_cast<types::size_t>(std::ranges::size(rhs))) {
+            return false;
+        }
+
+        if constexpr (std::integral<detail::value_t<Range>>) {
+            // Integers compare equal iff their bytes do, and memcmp already dispatches to SIMD
+            return n == 0 or std::memcmp(std::ranges::data(lhs), std::ranges::data(rhs), n * sizeof(detail::value_t<Range>)) == 0;
+        } else {
+            return detail::dispatch<detail::EqualKernel>(std::ranges::data(lhs), std::ranges::data(rhs), n);
+        }
+    }
+
+    template<std::ranges::contiguous_range Range>
+        requires vectorizable<detail::value_t<Range>>
+    void fill(Range &&range, detail::value_t<Range> value) {
+        using T = detail::value_t<Range>;
+        const auto n = static_cast<types::size_t>(std::ranges::size(range));
+        if constexpr (sizeof(T) == 1) {
+            if (n > 0) {
+                std::memset(std::ranges::data(range), static_cast<unsigned char>(value), n);
+            }
+        } else {
+            detail::dispatch<detail::FillKernel>(std::ranges::data(range), n, value);
+        }
+    }
+
+    // Index of the first element equal to value, or the size of the range if there is none
+    template<std::ranges::contiguous_range Range>
+        requires vectorizable<detail::value_t<Range>>
+    auto find(const Range &range, detail::value_t<Range> value) -> types::size_t {
+        return detail::dispatch<detail::FindKernel>(std::ranges::data(range), static_cast<types::size_t>(std::ranges::size(range)), value);
+    }
+
+    template<std::ranges::contiguous_range Range>
+        requires vectorizable<detail::value_t<Range>>
+    auto count(const Range &range, detail::value_t<Range> value) -> types::size_t {
+        return detail::dispatch<detail::CountKernel>(std::ranges::data(range), static_cast<types::size_t>(std::ranges::size(range)), value);
+    }
+
+    template<std::ranges::contiguous_range Range>
+        requires vectorizable<detail::value_t<Range>>
+    auto min(const Range &range) -> detail::value_t<Range> {
+        if (std::ranges::empty(range)) {
+            throw std::invalid_argument("Minimum of an empty range");
+        }
+
+        return detail::dispatch<detail::ExtremumKernel<true>>(std::ranges::data(range), static_cast<types::size_t>(std::ranges::size(range)));
+    }
+
+    template<std::ranges::contiguous_range Range>
+        requires vectorizable<detail::value_t<Range>>
+    auto max(const Range &range) -> detail::value_t<Range> {
+        if (std::ranges::empty(range)) {
+            throw std::invalid_argument("Maximum of an empty range");
+        }
+
+        return detail::dispatch<detail::ExtremumKernel<false>>(std::ranges::data(range), static_cast<types::size_t>(std::ranges::size(range)));
+    }
+
+    // Integer sums wrap around modulo 2^N for N-bit T, signed ones included
+    template<std::ranges::contiguous_range Range>
+        requires vectorizable<detail::value_t<Range>>
+    auto sum(const Range &range) -> detail::value_t<Range> {
+        return detail::dispatch<detail::SumKernel>(std::ranges::data(range), static_cast<types::size_t>(std::ranges::size(range)));
+    }
+} // namespace ds::simd
+
+#endif //DS_SIMD_HPP
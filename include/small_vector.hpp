@@ -0,0 +1,20 @@
+//
+// Created by santiago on 18.06.23.
+//
+
+#ifndef DS_SMALL_VECTOR_HPP
+#define DS_SMALL_VECTOR_HPP
+
+#include <memory>
+
+#include "type_definitions.hpp"
+#include "vector.hpp"
+
+namespace ds {
+
+    // Vector that keeps up to N elements inside the object and only allocates once it grows past them
+    template<typename T, types::size_t N, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth<>>
+    using SmallVector = Vector<T, Allocator, N, GrowthPolicy>;
+} // namespace ds
+
+#endif //DS_SMALL_VECTOR_HPP
@@ -0,0 +1,264 @@
+//
+// Created by santiago on 23.07.23.
+//
+
+#ifndef DS_SOA_VECTOR_HPP
+#define DS_SOA_VECTOR_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "growth_policy.hpp"
+#include "type_definitions.hpp"
+#include "vector.hpp"
+
+namespace ds {
+
+    // Structure-of-arrays container: a record of Fields... is stored as one element in each of
+    // sizeof...(Fields) parallel columns, so scanning a single field touches only that column.
+    // Rows are accessed through tuples of references.
+    template<typename... Fields>
+    class SoAVector {
+        static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+    public:
+        using size_type = types::size_t;
+        using difference_type = types::ptrdiff_t;
+        using value_type = std::tuple<Fields...>;
+        using reference = std::tuple<Fields &...>;
+        using const_reference = std::tuple<const Fields &...>;
+
+        template<types::size_t I>
+        using field_type = std::tuple_element_t<I, value_type>;
+
+        // Random access iterator over rows, dereferencing to a tuple of references
+        template<typename Container, typename Reference>
+        struct RowIterator {
+            using iterator_category = std::random_access_iterator_tag;
+            using difference_type = types::ptrdiff_t;
+            using value_type = std::tuple<Fields...>;
+            using reference = Reference;
+
+            RowIterator() = default;
+
+            RowIterator(Container *container, size_type row) : _container(container), _row(row) {}
+
+            reference operator*() const { return (*_container)[_row]; }
+
+            reference operator[](difference_type offset) const { return (*_container)[_row + offset]; }
+
+            RowIterator &operator++() {
+                _row++;
+                return *this;
+            }
+
+            RowIterator operator++(int) {
+                RowIterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+
+            RowIterator &operator--() {
+                _row--;
+                return *this;
+            }
+
+            RowIterator operator--(int) {
+                RowIterator tmp = *this;
+                --(*this);
+                return tmp;
+            }
+
+            RowIterator &operator+=(difference_type offset) {
+                _row += offset;
+                return *this;
+            }
+
+            RowIterator &operator-=(difference_type offset) {
+                _row -= offset;
+                return *this;
+            }
+
+            RowIterator operator+(difference_type offset) const { return RowIterator(_container, _row + offset); }
+
+            friend RowIterator operator+(difference_type offset, const RowIterator &other) { return other + offset; }
+
+            RowIterator operator-(difference_type offset) const { return RowIterator(_container, _row - offset); }
+
+            difference_type operator-(const RowIterator &other) const {
+                return static_cast<difference_type>(_row) - static_cast<difference_type>(other._row);
+            }
+
+            bool operator==(const RowIterator &other) const { return _row == other._row; }
+
+            auto operator<=>(const RowIterator &other) const { return _row <=> other._row; }
+
+        private:
+            Container *_container = nullptr;
+            size_type _row = 0;
+        };
+
+        using iterator = RowIterator<SoAVector, reference>;
+        using const_iterator = RowIterator<const SoAVector, const_reference>;
+
+        SoAVector() = default;
+
+        auto at(size_type pos) -> reference {
+            if (pos >= size()) {
+                throw std::out_of_range("id is out of range");
+            }
+
+            return (*this)[pos];
+        }
+
+        auto begin() {
+            return iterator(this, 0);
+        }
+
+        auto begin() const {
+            return cbegin();
+        }
+
+        [[nodiscard]] auto capacity() const {
+            return std::get<0>(_columns).capacity();
+        }
+
+        auto cbegin() const {
+            return const_iterator(this, 0);
+        }
+
+        auto cend() const {
+            return const_iterator(this, size());
+        }
+
+        void clear() {
+            for_each_column([](auto &column) { column.clear(); });
+        }
+
+        // Contiguous view of field I for every row
+        template<types::size_t I>
+        auto column() -> std::span<field_type<I>> {
+            return std::span(std::get<I>(_columns).data(), size());
+        }
+
+        template<types::size_t I>
+        auto column() const -> std::span<const field_type<I>> {
+            return std::span(std::get<I>(_columns).data(), size());
+        }
+
+        template<types::size_t I>
+        auto column_begin() {
+            return std::get<I>(_columns).begin();
+        }
+
+        template<types::size_t I>
+        auto column_end() {
+            return std::get<I>(_columns).end();
+        }
+
+        template<typename... Args>
+        auto emplace_back(Args &&...args) -> reference {
+            static_assert(sizeof...(Args) == sizeof...(Fields), "emplace_back needs one argument per field");
+            if (size() < capacity()) {
+                push_fields(std::forward<Args>(args)...);
+            } else {
+                // Built before growing, as the arguments may refer to rows that reserve() moves
+                value_type record(std::forward<Args>(args)...);
+                reserve(DoublingGrowth<>::next_capacity(capacity(), size() + 1, 0));
+                std::apply([this](auto &...fields) { push_fields(std::move(fields)...); }, record);
+            }
+
+            return back();
+        }
+
+        [[nodiscard]] auto empty() const {
+            return size() == 0;
+        }
+
+        auto end() {
+            return iterator(this, size());
+        }
+
+        auto end() const {
+            return cend();
+        }
+
+        auto back() -> reference {
+            return (*this)[size() - 1];
+        }
+
+        auto front() -> reference {
+            return (*this)[0];
+        }
+
+        auto operator[](size_type pos) -> reference {
+            return std::apply([pos](auto &...columns) { return reference(columns[pos]...); }, _columns);
+        }
+
+        auto operator[](size_type pos) const -> const_reference {
+            return std::apply([pos](const auto &...columns) { return const_reference(columns[pos]...); }, _columns);
+        }
+
+        void pop_back() {
+            for_each_column([](auto &column) { column.pop_back(); });
+        }
+
+        void push_back(const Fields &...fields) {
+            emplace_back(fields...);
+        }
+
+        void push_back(const value_type &record) {
+            std::apply([this](const auto &...fields) { emplace_back(fields...); }, record);
+        }
+
+        void reserve(size_type new_cap) {
+            for_each_column([new_cap](auto &column) { column.reserve(new_cap); });
+        }
+
+        void shrink_to_fit() {
+            for_each_column([](auto &column) { column.shrink_to_fit(); });
+        }
+
+        [[nodiscard]] auto size() const {
+            return std::get<0>(_columns).size();
+        }
+
+    private:
+        std::tuple<Vector<Fields>...> _columns;
+
+        template<typename Function>
+        void for_each_column(Function function) {
+            std::apply([&function](auto &...columns) { (function(columns), ...); }, _columns);
+        }
+
+        // Capacity is already there, so only a field constructor can throw; undo the fields pushed so
+        // far to keep columns the same length
+        template<typename... Args>
+        void push_fields(Args &&...args) {
+            types::size_t pushed = 0;
+            try {
+                std::apply([&](auto &...columns) { (push_field(columns, std::forward<Args>(args), pushed), ...); }, _columns);
+            } catch (...) {
+                rollback(pushed, std::index_sequence_for<Fields...>{});
+                throw;
+            }
+        }
+
+        template<typename Column, typename Arg>
+        static void push_field(Column &column, Arg &&arg, types::size_t &pushed) {
+            column.emplace_back(std::forward<Arg>(arg));
+            pushed++;
+        }
+
+        template<std::size_t... I>
+        void rollback(types::size_t pushed, std::index_sequence<I...> /*indices*/) {
+            ((I < pushed ? std::get<I>(_columns).pop_back() : void()), ...);
+        }
+    };
+} // namespace ds
+
+#endif //DS_SOA_VECTOR_HPP
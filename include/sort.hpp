@@ -0,0 +1,598 @@
+//
+// Created by santiago on 19.10.23.
+//
+
+#ifndef DS_SORT_HPP
+#define DS_SORT_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "aligned_allocator.hpp"
+#include "type_definitions.hpp"
+#include "vector.hpp"
+
+// Sorting engine for contiguous ranges such as Vector. Integer and IEEE floating point keys compared with
+// std::less or std::greater are sorted with an LSD radix sort, one pass per byte of the key, skipping the
+// bytes all keys share. Other element types and comparators go through pdqsort.
+namespace ds {
+
+    // Element types the radix sort handles. Floats are ordered by their bit patterns, which agrees with <
+    // except that -0.0 goes before 0.0, and NaNs go first or last depending on their sign.
+    template<typename T>
+    concept radix_sortable = (std::integral<T> and not std::same_as<T, bool>) or
+                             (std::floating_point<T> and std::numeric_limits<T>::is_iec559 and (sizeof(T) == 4 or sizeof(T) == 8));
+
+    // Scratch memory for the radix sort, which scatters every pass into a second array as large as the
+    // input. Passing the same buffer to repeated sorts reuses its allocation instead of making a new one.
+    class SortBuffer {
+    public:
+        using size_type = types::size_t;
+
+        // Scratch arrays of count elements of each of Ts, each starting on its own cache line. They stay
+        // valid until the next call, and their contents are indeterminate.
+        template<typename... Ts>
+            requires(std::is_trivially_copyable_v<Ts> and ...)
+        auto acquire(size_type count) -> std::tuple<Ts *...> {
+            std::array<size_type, sizeof...(Ts)> offsets{round_to_line(count * sizeof(Ts))...};
+            std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), size_type{0});
+            const auto total = (round_to_line(count * sizeof(Ts)) + ...);
+            if (total > _bytes.size()) {
+                _bytes.clear();
+                _bytes.resize_for_overwrite(total);
+            }
+
+            return [&]<std::size_t... I>(std::index_sequence<I...>) {
+                return std::tuple<Ts *...>{reinterpret_cast<Ts *>(_bytes.data() + offsets[I])...}; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }(std::index_sequence_for<Ts...>{});
+        }
+
+        // Bytes held
+        [[nodiscard]] auto capacity() const -> size_type {
+            return _bytes.size();
+        }
+
+        void release() {
+            _bytes.clear();
+            _bytes.shrink_to_fit();
+        }
+
+    private:
+        Vector<std::byte, AlignedAllocator<std::byte>> _bytes;
+
+        static auto round_to_line(size_type bytes) -> size_type {
+            return (bytes + CACHE_LINE_BYTES - 1) / CACHE_LINE_BYTES * CACHE_LINE_BYTES;
+        }
+    };
+
+    namespace detail {
+        constexpr types::size_t RADIX_BITS = 8;
+        constexpr types::size_t RADIX_BUCKETS = 1U << RADIX_BITS;
+        // Below this many elements per byte of the key the radix passes cost more than comparing, and
+        // pdqsort runs instead
+        constexpr types::size_t RADIX_SORT_THRESHOLD = 1U << 8U;
+        // Keys up to this size are sorted by LSD passes alone, as they and their scratch stay in cache
+        constexpr types::size_t LSD_RADIX_SORT_BYTES = 1U << 19U;
+
+        enum class RadixOrder { none, ascending, descending };
+
+        // Order a comparator asks for, when the radix sort can produce it for keys of type T
+        template<typename Compare, typename T>
+        inline constexpr RadixOrder radix_order_v = [] {
+            if constexpr (not radix_sortable<T>) {
+                return RadixOrder::none;
+            } else if constexpr (std::same_as<Compare, std::less<>> or std::same_as<Compare, std::less<T>> or std::same_as<Compare, std::ranges::less>) {
+                return RadixOrder::ascending;
+            } else if constexpr (std::same_as<Compare, std::greater<>> or std::same_as<Compare, std::greater<T>> or std::same_as<Compare, std::ranges::greater>) {
+                return RadixOrder::descending;
+            } else {
+                return RadixOrder::none;
+            }
+        }();
+
+        template<radix_sortable T>
+        using radix_bits_t = std::conditional_t<std::integral<T>, std::make_unsigned<T>, std::conditional<sizeof(T) == 4, std::uint32_t, std::uint64_t>>::type;
+
+        // Maps a key to an unsigned integer whose order matches the one asked for: the sign bit of signed
+        // integers and non-negative floats is flipped, and all the bits of negative floats
+        template<RadixOrder Order, radix_sortable T>
+        constexpr auto radix_bits(T key) -> radix_bits_t<T> {
+            using U = radix_bits_t<T>;
+            constexpr auto SIGN_BIT = static_cast<U>(U{1} << (std::numeric_limits<U>::digits - 1));
+
+            auto bits = std::bit_cast<U>(key);
+            if constexpr (std::floating_point<T>) {
+                const U negative = bits >> (std::numeric_limits<U>::digits - 1);
+                bits ^= static_cast<U>(-negative) | SIGN_BIT;
+            } else if constexpr (std::signed_integral<T>) {
+                bits ^= SIGN_BIT;
+            }
+
+            if constexpr (Order == RadixOrder::descending) {
+                bits = static_cast<U>(~bits);
+            }
+            return bits;
+        }
+
+        template<RadixOrder Order, radix_sortable T>
+        constexpr auto radix_digit(T key, types::size_t pass) -> types::size_t {
+            return static_cast<types::size_t>(radix_bits<Order>(key) >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1);
+        }
+
+        // Position i of values, or nullptr when there are no values
+        template<typename V>
+        auto values_at(V *values, types::size_t i) -> V * {
+            if constexpr (std::is_void_v<V>) {
+                return values;
+            } else {
+                return values + i; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        }
+
+        // Stable LSD radix sort of n keys by their lowest bytes, carrying values along unless V is void.
+        // The histograms of all passes are built in a single read of the keys; passes whose byte is the
+        // same in every key are skipped. Each pass scatters into the scratch arrays and swaps them with the
+        // input, so the result is copied back only after an odd number of passes.
+        template<RadixOrder Order, radix_sortable K, typename V>
+        void lsd_radix_sort(K *keys, V *values, K *key_scratch, V *value_scratch, types::size_t n, types::size_t passes) {
+            std::array<std::array<types::size_t, RADIX_BUCKETS>, sizeof(K)> counts{};
+            for (types::size_t i = 0; i < n; i++) {
+                const auto bits = radix_bits<Order>(keys[i]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                for (types::size_t pass = 0; pass < passes; pass++) {
+                    counts[pass][static_cast<types::size_t>(bits >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+                }
+            }
+
+            auto *src = keys;
+            auto *dst = key_scratch;
+            auto *value_src = values;
+            auto *value_dst = value_scratch;
+            for (types::size_t pass = 0; pass < passes; pass++) {
+                auto &offsets = counts[pass];
+                if (offsets[radix_digit<Order>(src[0], pass)] == n) {
+                    continue;
+                }
+
+                auto sum = types::size_t{0};
+                for (auto &offset: offsets) {
+                    sum += std::exchange(offset, sum);
+                }
+                for (types::size_t i = 0; i < n; i++) {
+                    const auto position = offsets[radix_digit<Order>(src[i], pass)]++; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    dst[position] = src[i];                                          // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    if constexpr (not std::is_void_v<V>) {
+                        value_dst[position] = value_src[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    }
+                }
+                std::swap(src, dst);
+                std::swap(value_src, value_dst);
+            }
+
+            if (src != keys) {
+                std::copy(src, src + n, keys); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                if constexpr (not std::is_void_v<V>) {
+                    std::copy(value_src, value_src + n, values); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                }
+            }
+        }
+
+        // Stable radix sort of n keys by their lowest bytes. Once the keys outgrow the cache, every LSD
+        // pass would scatter them across memory, so they are first split in buckets by the highest byte
+        // that differs among them, which are then sorted on their own while they are cache resident.
+        template<RadixOrder Order, radix_sortable K, typename V>
+        void radix_sort(K *keys, V *values, K *key_scratch, V *value_scratch, types::size_t n, types::size_t passes = sizeof(K)) {
+            if (n < 2 or passes == 0) {
+                return;
+            }
+            if (n * sizeof(K) <= LSD_RADIX_SORT_BYTES) {
+                lsd_radix_sort<Order>(keys, values, key_scratch, value_scratch, n, passes);
+                return;
+            }
+
+            using U = radix_bits_t<K>;
+            const auto first = radix_bits<Order>(keys[0]);
+            auto differing = U{0};
+            for (types::size_t i = 1; i < n; i++) {
+                differing |= radix_bits<Order>(keys[i]) ^ first; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+            if (passes < sizeof(K)) {
+                differing &= static_cast<U>((U{1} << (passes * RADIX_BITS)) - 1);
+            }
+            if (differing == 0) {
+                return;
+            }
+
+            const auto pass = static_cast<types::size_t>(std::bit_width(differing) - 1) / RADIX_BITS;
+            std::array<types::size_t, RADIX_BUCKETS + 1> bucket_begin{};
+            for (types::size_t i = 0; i < n; i++) {
+                bucket_begin[radix_digit<Order>(keys[i], pass) + 1]++; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+            std::partial_sum(bucket_begin.begin(), bucket_begin.end(), bucket_begin.begin());
+
+            auto offsets = bucket_begin;
+            for (types::size_t i = 0; i < n; i++) {
+                const auto position = offsets[radix_digit<Order>(keys[i], pass)]++; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                key_scratch[position] = keys[i];                                    // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                if constexpr (not std::is_void_v<V>) {
+                    value_scratch[position] = values[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                }
+            }
+
+            // Each bucket is sorted in the scratch arrays, with its range of the input as scratch, and then
+            // copied back while it is still in cache
+            for (types::size_t bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+                const auto begin = bucket_begin[bucket];
+                const auto size = bucket_begin[bucket + 1] - begin;
+                auto *bucket_keys = key_scratch + begin; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                radix_sort<Order>(bucket_keys, values_at(value_scratch, begin), keys + begin, values_at(values, begin), size, pass); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                std::copy(bucket_keys, bucket_keys + size, keys + begin);                                                          // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                if constexpr (not std::is_void_v<V>) {
+                    std::copy(value_scratch + begin, value_scratch + begin + size, values + begin); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                }
+            }
+        }
+
+        template<RadixOrder Order, radix_sortable K>
+        void radix_sort(K *keys, types::size_t n, SortBuffer &buffer) {
+            const auto [scratch] = buffer.acquire<K>(n);
+            radix_sort<Order, K, void>(keys, nullptr, scratch, nullptr, n);
+        }
+
+        // Pattern-defeating quicksort (Orson Peters): quicksort on a median-of-3 pivot, or a pseudo-median
+        // of 9 for large ranges. Runs that a partition leaves in order are finished by an insertion sort
+        // that gives up after a few moves, ranges with many equal elements are split in a single partition,
+        // and after log2(n) badly unbalanced partitions the range is heapsorted, bounding it to O(n log n).
+        namespace pdq {
+            constexpr types::ptrdiff_t INSERTION_SORT_THRESHOLD = 24;
+            constexpr types::ptrdiff_t NINTHER_THRESHOLD = 128;
+            constexpr types::ptrdiff_t PARTIAL_INSERTION_SORT_LIMIT = 8;
+
+            template<typename It, typename Compare>
+            void insertion_sort(It begin, It end, Compare &comp) {
+                if (begin == end) {
+                    return;
+                }
+
+                for (auto current = std::next(begin); current != end; ++current) {
+                    auto sift = current;
+                    auto sift_1 = std::prev(current);
+                    if (comp(*sift, *sift_1)) {
+                        auto tmp = std::move(*sift);
+                        do {
+                            *sift-- = std::move(*sift_1);
+                        } while (sift != begin and comp(tmp, *--sift_1));
+                        *sift = std::move(tmp);
+                    }
+                }
+            }
+
+            // The element before begin must not be greater than any in the range
+            template<typename It, typename Compare>
+            void unguarded_insertion_sort(It begin, It end, Compare &comp) {
+                if (begin == end) {
+                    return;
+                }
+
+                for (auto current = std::next(begin); current != end; ++current) {
+                    auto sift = current;
+                    auto sift_1 = std::prev(current);
+                    if (comp(*sift, *sift_1)) {
+                        auto tmp = std::move(*sift);
+                        do {
+                            *sift-- = std::move(*sift_1);
+                        } while (comp(tmp, *--sift_1));
+                        *sift = std::move(tmp);
+                    }
+                }
+            }
+
+            // Returns false, leaving the range partly sorted, once more than PARTIAL_INSERTION_SORT_LIMIT
+            // elements have been moved
+            template<typename It, typename Compare>
+            auto partial_insertion_sort(It begin, It end, Compare &comp) -> bool {
+                if (begin == end) {
+                    return true;
+                }
+
+                auto moves = std::iter_difference_t<It>{0};
+                for (auto current = std::next(begin); current != end; ++current) {
+                    auto sift = current;
+                    auto sift_1 = std::prev(current);
+                    if (comp(*sift, *sift_1)) {
+                        auto tmp = std::move(*sift);
+                        do {
+                            *sift-- = std::move(*sift_1);
+                        } while (sift != begin and comp(tmp, *--sift_1));
+                        *sift = std::move(tmp);
+                        moves += current - sift;
+                    }
+
+                    if (moves > PARTIAL_INSERTION_SORT_LIMIT) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            template<typename It, typename Compare>
+            void sort2(It a, It b, Compare &comp) {
+                if (comp(*b, *a)) {
+                    std::iter_swap(a, b);
+                }
+            }
+
+            template<typename It, typename Compare>
+            void sort3(It a, It b, It c, Compare &comp) {
+                sort2(a, b, comp);
+                sort2(b, c, comp);
+                sort2(a, b, comp);
+            }
+
+            // Partitions around the pivot at begin, elements equal to it going right. Returns the final
+            // position of the pivot and whether the range was already partitioned.
+            template<typename It, typename Compare>
+            auto partition_right(It begin, It end, Compare &comp) -> std::pair<It, bool> {
+                auto pivot = std::move(*begin);
+                auto first = begin;
+                auto last = end;
+
+                // The median-of-3 guarantees an element not below the pivot on the right
+                while (comp(*++first, pivot)) {
+                }
+                if (std::prev(first) == begin) {
+                    while (first < last and not comp(*--last, pivot)) {
+                    }
+                } else {
+                    while (not comp(*--last, pivot)) {
+                    }
+                }
+
+                const auto already_partitioned = first >= last;
+                while (first < last) {
+                    std::iter_swap(first, last);
+                    while (comp(*++first, pivot)) {
+                    }
+                    while (not comp(*--last, pivot)) {
+                    }
+                }
+
+                auto pivot_position = std::prev(first);
+                *begin = std::move(*pivot_position);
+                *pivot_position = std::move(pivot);
+                return {pivot_position, already_partitioned};
+            }
+
+            // Partitions around the pivot at begin, elements equal to it going left. Used when the pivot
+            // equals the element before the range, so that none of those is ever partitioned again.
+            template<typename It, typename Compare>
+            auto partition_left(It begin, It end, Compare &comp) -> It {
+                auto pivot = std::move(*begin);
+                auto first = begin;
+                auto last = end;
+
+                while (comp(pivot, *--last)) {
+                }
+                if (std::next(last) == end) {
+                    while (first < last and not comp(pivot, *++first)) {
+                    }
+                } else {
+                    while (not comp(pivot, *++first)) {
+                    }
+                }
+
+                while (first < last) {
+                    std::iter_swap(first, last);
+                    while (comp(pivot, *--last)) {
+                    }
+                    while (not comp(pivot, *++first)) {
+                    }
+                }
+
+                *begin = std::move(*last);
+                *last = std::move(pivot);
+                return last;
+            }
+
+            // Breaks up the patterns behind an unbalanced partition by swapping a few elements of a side
+            template<typename It>
+            void shuffle_side(It begin, It end) {
+                const auto size = end - begin;
+                if (size < INSERTION_SORT_THRESHOLD) {
+                    return;
+                }
+
+                const auto quarter = size / 4;
+                std::iter_swap(begin, begin + quarter);
+                std::iter_swap(end - 1, end - quarter);
+                if (size > NINTHER_THRESHOLD) {
+                    std::iter_swap(begin + 1, begin + (quarter + 1));
+                    std::iter_swap(begin + 2, begin + (quarter + 2));
+                    std::iter_swap(end - 2, end - (quarter + 1));
+                    std::iter_swap(end - 3, end - (quarter + 2));
+                }
+            }
+
+            template<typename It, typename Compare>
+            void loop(It begin, It end, Compare &comp, int bad_allowed, bool leftmost) {
+                while (true) {
+                    const auto size = end - begin;
+                    if (size < INSERTION_SORT_THRESHOLD) {
+                        if (leftmost) {
+                            insertion_sort(begin, end, comp);
+                        } else {
+                            unguarded_insertion_sort(begin, end, comp);
+                        }
+                        return;
+                    }
+
+                    // The pivot ends up at begin
+                    const auto half = size / 2;
+                    if (size > NINTHER_THRESHOLD) {
+                        sort3(begin, begin + half, end - 1, comp);
+                        sort3(begin + 1, begin + (half - 1), end - 2, comp);
+                        sort3(begin + 2, begin + (half + 1), end - 3, comp);
+                        sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+                        std::iter_swap(begin, begin + half);
+                    } else {
+                        sort3(begin + half, begin, end - 1, comp);
+                    }
+
+                    // A pivot equal to the element before the range is its minimum: skip all its copies
+                    if (not leftmost and not comp(*std::prev(begin), *begin)) {
+                        begin = std::next(partition_left(begin, end, comp));
+                        continue;
+                    }
+
+                    const auto [pivot_position, already_partitioned] = partition_right(begin, end, comp);
+                    const auto left_size = pivot_position - begin;
+                    const auto right_size = end - std::next(pivot_position);
+                    if (left_size < size / 8 or right_size < size / 8) {
+                        if (--bad_allowed == 0) {
+                            std::make_heap(begin, end, comp);
+                            std::sort_heap(begin, end, comp);
+                            return;
+                        }
+                        shuffle_side(begin, pivot_position);
+                        shuffle_side(std::next(pivot_position), end);
+                    } else if (already_partitioned and partial_insertion_sort(begin, pivot_position, comp) and
+                               partial_insertion_sort(std::next(pivot_position), end, comp)) {
+                        return;
+                    }
+
+                    // Recursing into the left side only keeps the stack depth logarithmic
+                    loop(begin, pivot_position, comp, bad_allowed, leftmost);
+                    begin = std::next(pivot_position);
+                    leftmost = false;
+                }
+            }
+        } // namespace pdq
+
+        template<std::random_access_iterator It, typename Compare>
+        void pdqsort(It begin, It end, Compare &comp) {
+            if (end - begin < 2) {
+                return;
+            }
+
+            const auto size = static_cast<types::size_t>(end - begin);
+            pdq::loop(begin, end, comp, std::bit_width(size), true);
+        }
+
+        template<typename Range>
+        auto sort_size(const Range &range) {
+            return static_cast<types::size_t>(std::ranges::size(range));
+        }
+    } // namespace detail
+
+    // Contiguous ranges of radix_sortable elements ordered by std::less or std::greater are radix sorted once
+    // they are long enough, with scratch memory taken from buffer; everything else goes through pdqsort.
+    // Not stable.
+    template<std::ranges::random_access_range Range, typename Compare = std::less<>>
+        requires std::ranges::sized_range<Range>
+    void sort(Range &&range, SortBuffer &buffer, Compare comp = {}) {
+        using T = std::ranges::range_value_t<Range>;
+        constexpr auto ORDER = detail::radix_order_v<Compare, T>;
+        const auto n = detail::sort_size(range);
+        if constexpr (ORDER != detail::RadixOrder::none and std::ranges::contiguous_range<Range>) {
+            if (n >= detail::RADIX_SORT_THRESHOLD * sizeof(T)) {
+                detail::radix_sort<ORDER>(std::ranges::data(range), n, buffer);
+                return;
+            }
+        }
+
+        detail::pdqsort(std::ranges::begin(range), std::ranges::end(range), comp);
+    }
+
+    // Allocates the radix sort scratch for this call only; see SortBuffer to reuse it
+    template<std::ranges::random_access_range Range, typename Compare = std::less<>>
+        requires std::ranges::sized_range<Range>
+    void sort(Range &&range, Compare comp = {}) {
+        SortBuffer buffer;
+        ds::sort(range, buffer, comp);
+    }
+
+    template<std::random_access_iterator It, typename Compare = std::less<>>
+    void sort(It first, It last, Compare comp = {}) {
+        if constexpr (std::contiguous_iterator<It>) {
+            ds::sort(std::span(std::to_address(first), static_cast<types::size_t>(last - first)), comp);
+        } else {
+            detail::pdqsort(first, last, comp);
+        }
+    }
+
+    // Sorts keys and reorders values, a range of the same size, along with them, so that values[i]
+    // stays paired with keys[i]. Stable. Radix sortable keys carry values through the passes when they
+    // are trivially copyable and contiguous, and otherwise an index per element from which values are
+    // then gathered; other keys sort indices with pdqsort, ties broken by the index.
+    template<std::ranges::random_access_range Keys, std::ranges::random_access_range Values, typename Compare = std::less<>>
+        requires std::ranges::sized_range<Keys> and std::ranges::sized_range<Values>
+    void sort_by_key(Keys &&keys, Values &&values, SortBuffer &buffer, Compare comp = {}) {
+        using K = std::ranges::range_value_t<Keys>;
+        using V = std::ranges::range_value_t<Values>;
+        constexpr auto ORDER = detail::radix_order_v<Compare, K>;
+        const auto n = detail::sort_size(keys);
+        if (n != detail::sort_size(values)) {
+            throw std::invalid_argument("Keys and values differ in size");
+        }
+
+        auto key = std::ranges::begin(keys);
+        auto value = std::ranges::begin(values);
+        const auto gather = [n](auto first, const auto &order) {
+            Vector<std::iter_value_t<decltype(first)>> sorted;
+            sorted.reserve(n);
+            for (types::size_t i = 0; i < n; i++) {
+                sorted.push_back(std::move(first[static_cast<std::iter_difference_t<decltype(first)>>(order[i])]));
+            }
+            std::move(sorted.begin(), sorted.end(), first);
+        };
+
+        if constexpr (ORDER != detail::RadixOrder::none and std::ranges::contiguous_range<Keys>) {
+            if constexpr (std::is_trivially_copyable_v<V> and std::ranges::contiguous_range<Values>) {
+                const auto [key_scratch, value_scratch] = buffer.acquire<K, V>(n);
+                detail::radix_sort<ORDER>(std::ranges::data(keys), std::ranges::data(values), key_scratch, value_scratch, n);
+            } else {
+                using size_type = types::size_t;
+                const auto [key_scratch, order, order_scratch] = buffer.acquire<K, size_type, size_type>(n);
+                std::iota(order, order + n, size_type{0}); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                detail::radix_sort<ORDER>(std::ranges::data(keys), order, key_scratch, order_scratch, n);
+                gather(value, order);
+            }
+        } else {
+            Vector<types::size_t> order;
+            order.reserve(n);
+            for (types::size_t i = 0; i < n; i++) {
+                order.push_back(i);
+            }
+            auto by_key = [&](types::size_t lhs, types::size_t rhs) {
+                const auto &lhs_key = key[static_cast<std::iter_difference_t<decltype(key)>>(lhs)];
+                const auto &rhs_key = key[static_cast<std::iter_difference_t<decltype(key)>>(rhs)];
+                return comp(lhs_key, rhs_key) or (not comp(rhs_key, lhs_key) and lhs < rhs);
+            };
+            detail::pdqsort(order.begin(), order.end(), by_key);
+            gather(key, order);
+            gather(value, order);
+        }
+    }
+
+    template<std::ranges::random_access_range Keys, std::ranges::random_access_range Values, typename Compare = std::less<>>
+        requires std::ranges::sized_range<Keys> and std::ranges::sized_range<Values>
+    void sort_by_key(Keys &&keys, Values &&values, Compare comp = {}) {
+        SortBuffer buffer;
+        ds::sort_by_key(keys, values, buffer, comp);
+    }
+} // namespace ds
+
+#endif //DS_SORT_HPP
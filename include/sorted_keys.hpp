@@ -0,0 +1,208 @@
+//
+// Created by santiago on 10.09.23.
+//
+
+#ifndef DS_SORTED_KEYS_HPP
+#define DS_SORTED_KEYS_HPP
+
+#include <algorithm>
+#include <bit>
+#include <type_traits>
+#include <utility>
+
+#include "type_definitions.hpp"
+#include "vector.hpp"
+
+namespace ds {
+
+    // How FlatMap and FlatSet search their keys.
+    // sorted: branchless binary search over the sorted keys.
+    // eytzinger: lookups run on a second copy of the keys in breadth-first order of the implicit
+    // search tree, where the nodes of the first levels share cache lines and the next ones can be
+    // prefetched. It costs a copy of the keys plus an index per key and an O(n) rebuild on every
+    // insert or erase, so it pays off for tables that are built once and then only queried.
+    enum class SearchLayout { sorted, eytzinger };
+
+    namespace detail {
+
+        // Sorted, duplicate-free keys shared by FlatMap and FlatSet. Positions are indices in sorted order.
+        template<typename Key, typename Compare, SearchLayout Layout>
+        class SortedKeys {
+            static_assert(Layout == SearchLayout::sorted or std::is_copy_constructible_v<Key>,
+                          "The Eytzinger layout keeps a copy of the keys");
+
+        public:
+            using size_type = types::size_t;
+
+            explicit SortedKeys(const Compare &compare) : _compare(compare) {}
+
+            // Indices of keys in sorted order, keeping only the first of each run of equivalent keys
+            [[nodiscard]] static auto sorted_unique_order(const Vector<Key> &keys, const Compare &compare) -> Vector<size_type> {
+                Vector<size_type> order;
+                order.reserve(keys.size());
+                for (size_type i = 0; i < keys.size(); i++) {
+                    order.push_back(i);
+                }
+
+                std::stable_sort(order.begin(), order.end(), [&](size_type lhs, size_type rhs) { return compare(keys[lhs], keys[rhs]); });
+                const auto last = std::unique(order.begin(), order.end(), [&](size_type lhs, size_type rhs) {
+                    return not compare(keys[lhs], keys[rhs]);
+                });
+                order.erase(last, order.end());
+                return order;
+            }
+
+            // keys must be sorted and free of duplicates
+            void assign_sorted(Vector<Key> &&keys) {
+                _keys = std::move(keys);
+                rebuild_tree();
+            }
+
+            void clear() {
+                _keys.clear();
+                rebuild_tree();
+            }
+
+            [[nodiscard]] auto compare() const -> const Compare & {
+                return _compare;
+            }
+
+            template<typename... Args>
+            void emplace(size_type pos, Args &&...args) {
+                _keys.emplace(_keys.cbegin() + static_cast<types::ptrdiff_t>(pos), std::forward<Args>(args)...);
+                rebuild_tree();
+            }
+
+            void erase(size_type pos) {
+                _keys.erase(_keys.cbegin() + static_cast<types::ptrdiff_t>(pos));
+                rebuild_tree();
+            }
+
+            // Position of the key equivalent to key, or size() if there is none
+            template<typename Q>
+            [[nodiscard]] auto find(const Q &key) const -> size_type {
+                if constexpr (Layout == SearchLayout::eytzinger) {
+                    // The node the search ended on is still in cache, its rank may not be, so a miss
+                    // is decided without looking it up
+                    const auto k = eytzinger_node(key);
+                    return k != 0 and not _compare(key, _tree[k]) ? _rank[k] : size();
+                } else {
+                    const auto pos = sorted_lower_bound(key);
+                    return pos < size() and not _compare(key, _keys[pos]) ? pos : size();
+                }
+            }
+
+            [[nodiscard]] auto keys() const -> const Vector<Key> & {
+                return _keys;
+            }
+
+            // Position of the first key not ordered before key
+            template<typename Q>
+            [[nodiscard]] auto lower_bound(const Q &key) const -> size_type {
+                if constexpr (Layout == SearchLayout::eytzinger) {
+                    const auto k = eytzinger_node(key);
+                    return k == 0 ? size() : _rank[k];
+                } else {
+                    return sorted_lower_bound(key);
+                }
+            }
+
+            void reserve(size_type new_cap) {
+                _keys.reserve(new_cap);
+            }
+
+            void shrink_to_fit() {
+                _keys.shrink_to_fit();
+                if constexpr (Layout == SearchLayout::eytzinger) {
+                    _tree.shrink_to_fit();
+                    _rank.shrink_to_fit();
+                }
+            }
+
+            [[nodiscard]] auto size() const -> size_type {
+                return _keys.size();
+            }
+
+        private:
+            struct Empty {};
+            using Tree = std::conditional_t<Layout == SearchLayout::eytzinger, Vector<Key>, Empty>;
+            using Rank = std::conditional_t<Layout == SearchLayout::eytzinger, Vector<size_type>, Empty>;
+
+            [[no_unique_address]] Compare _compare;
+            Vector<Key> _keys;
+            // Node k (1-based) has children 2k and 2k + 1; node 0 is padding. _rank[k] is the
+            // position of _tree[k] in _keys.
+            [[no_unique_address]] Tree _tree;
+            [[no_unique_address]] Rank _rank;
+
+            // Halves the range with a conditional add instead of a branch, so the loop runs exactly
+            // log2(n) times and there are no mispredictions for the CPU to recover from
+            template<typename Q>
+            auto sorted_lower_bound(const Q &key) const -> size_type {
+                auto n = size();
+                if (n == 0) {
+                    return 0;
+                }
+
+                const Key *base = _keys.data();
+                while (n > 1) {
+                    const auto half = n / 2;
+                    base += static_cast<size_type>(_compare(base[half], key)) * half; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    n -= half;
+                }
+                return static_cast<size_type>(base - _keys.data()) + static_cast<size_type>(_compare(*base, key));
+            }
+
+            // Node holding the first key not ordered before key, or 0 if there is none
+            template<typename Q>
+            auto eytzinger_node(const Q &key) const -> size_type {
+                const auto n = size();
+                const Key *tree = _tree.data();
+                size_type k = 1;
+                while (k <= n) {
+#if defined(__GNUC__)
+                    // The 16 descendants four levels down are adjacent, so for small keys this fetches
+                    // the line the search will reach next while the current comparisons run
+                    __builtin_prefetch(tree + std::min(16 * k, n)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+#endif
+                    k = 2 * k + static_cast<size_type>(_compare(tree[k], key)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                }
+                // Every right turn appended a 1; dropping the trailing ones and the last left turn
+                // leaves the last node whose key was not ordered before key
+                return k >> (std::countr_one(k) + 1);
+            }
+
+            void rebuild_tree() {
+                if constexpr (Layout == SearchLayout::eytzinger) {
+                    const auto n = size();
+                    _tree.clear();
+                    _rank.clear();
+                    if (n == 0) {
+                        return;
+                    }
+
+                    // An in-order walk of the implicit tree visits the nodes in sorted order
+                    _rank.assign(n + 1, 0);
+                    size_type next = 0;
+                    const auto visit = [&](const auto &self, size_type k) -> void {
+                        if (k > n) {
+                            return;
+                        }
+                        self(self, 2 * k);
+                        _rank[k] = next++;
+                        self(self, 2 * k + 1);
+                    };
+                    visit(visit, 1);
+
+                    _tree.reserve(n + 1);
+                    _tree.push_back(_keys[0]);
+                    for (size_type i = 1; i <= n; i++) {
+                        _tree.push_back(_keys[_rank[i]]);
+                    }
+                }
+            }
+        };
+    } // namespace detail
+} // namespace ds
+
+#endif //DS_SORTED_KEYS_HPP
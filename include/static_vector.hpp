@@ -0,0 +1,407 @@
+//
+// Created by santiago on 01.10.23.
+//
+
+#ifndef DS_STATIC_VECTOR_HPP
+#define DS_STATIC_VECTOR_HPP
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "contiguous_iterator.hpp"
+#include "simd.hpp"
+#include "type_definitions.hpp"
+
+namespace ds {
+
+    namespace detail {
+        // Room for N elements of T. Trivial elements live in a plain array, which constant evaluation can
+        // read and write; it is zeroed there, as a constexpr object may not hold indeterminate values.
+        template<typename T, types::size_t N, bool = std::is_trivial_v<T>>
+        struct StaticStorage {
+            constexpr StaticStorage() {
+                if (std::is_constant_evaluated()) {
+                    std::fill_n(_values, N, T{});
+                }
+            }
+
+            constexpr auto data() -> T * {
+                return _values;
+            }
+
+            constexpr auto data() const -> const T * {
+                return _values;
+            }
+
+            T _values[N]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+        };
+
+        // Other elements live in a union, so that they are only constructed when the vector grows
+        template<typename T, types::size_t N>
+        struct StaticStorage<T, N, false> {
+            constexpr StaticStorage() {} // NOLINT(modernize-use-equals-default)
+
+            constexpr ~StaticStorage() {} // NOLINT(modernize-use-equals-default)
+
+            StaticStorage(const StaticStorage &) = delete;
+            auto operator=(const StaticStorage &) -> StaticStorage & = delete;
+
+            constexpr auto data() -> T * {
+                return _values;
+            }
+
+            constexpr auto data() const -> const T * {
+                return _values;
+            }
+
+            union {
+                T _values[N]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+            };
+        };
+    } // namespace detail
+
+    // Vector whose elements live inside the object, up to a capacity of N fixed at compile time. It never
+    // allocates, and growing past N throws std::length_error instead. With trivial elements it can be
+    // built and kept in constant expressions, e.g. as a lookup table computed at compile time.
+    template<typename T, types::size_t N>
+    class StaticVector {
+        static_assert(N > 0, "Capacity must be positive");
+
+    public:
+        using size_type = types::size_t;
+        using value_type = T;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using difference_type = types::ptrdiff_t;
+        using pointer = T *;
+        using iterator = it::ContiguousIterator<T, reference>;
+        using const_iterator = it::ContiguousIterator<T, const_reference>;
+
+        constexpr StaticVector() noexcept = default;
+
+        constexpr explicit StaticVector(size_type size) {
+            resize(size);
+        }
+
+        constexpr StaticVector(size_type size, const T &value) {
+            resize(size, value);
+        }
+
+        constexpr StaticVector(std::initializer_list<T> init) : StaticVector(init.begin(), init.end()) {}
+
+        template<std::input_iterator InputIt>
+        constexpr StaticVector(InputIt first, InputIt last) {
+            assign(first, last);
+        }
+
+        constexpr StaticVector(const StaticVector &other) : StaticVector(other.cbegin(), other.cend()) {}
+
+        // Elements are moved one by one, and other is left empty
+        constexpr StaticVector(StaticVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            for (auto &value: other) {
+                std::construct_at(data() + _size, std::move(value)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                _size++;
+            }
+            other.clear();
+        }
+
+        constexpr ~StaticVector()
+            requires std::is_trivially_destructible_v<T>
+        = default;
+
+        constexpr ~StaticVector() {
+            clear();
+        }
+
+        constexpr void assign(size_type count, const T &value) {
+            check_capacity(count);
+            const T copy(value);
+            clear();
+            resize(count, copy);
+        }
+
+        template<std::input_iterator InputIt>
+        constexpr void assign(InputIt first, InputIt last) {
+            if constexpr (std::forward_iterator<InputIt>) {
+                check_capacity(static_cast<size_type>(std::distance(first, last)));
+            }
+
+            auto out = begin();
+            for (; first != last and out != end(); ++first, ++out) {
+                *out = *first;
+            }
+            destroy_at_end(static_cast<size_type>(out - begin()));
+
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+
+        constexpr void assign(std::initializer_list<T> ilist) {
+            assign(ilist.begin(), ilist.end());
+        }
+
+        constexpr auto at(size_type pos) -> reference {
+            if (pos >= _size) {
+                throw std::out_of_range("id is out of range");
+            }
+
+            return data()[pos]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        constexpr auto at(size_type pos) const -> const_reference {
+            if (pos >= _size) {
+                throw std::out_of_range("id is out of range");
+            }
+
+            return data()[pos]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        constexpr auto back() -> reference {
+            return data()[_size - 1]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        constexpr auto back() const -> const_reference {
+            return data()[_size - 1]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        constexpr auto begin() {
+            return iterator(data());
+        }
+
+        constexpr auto begin() const {
+            return cbegin();
+        }
+
+        [[nodiscard]] static constexpr auto capacity() -> size_type {
+            return N;
+        }
+
+        // The iterator holds a plain pointer; const_iterator never writes through it
+        constexpr auto cbegin() const {
+            return const_iterator(const_cast<T *>(data())); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+        }
+
+        constexpr auto cend() const {
+            return cbegin() + static_cast<difference_type>(_size);
+        }
+
+        constexpr void clear() {
+            destroy_at_end(0);
+        }
+
+        constexpr auto data() -> T * {
+            return _storage.data();
+        }
+
+        constexpr auto data() const -> const T * {
+            return _storage.data();
+        }
+
+        template<typename... Args>
+        constexpr auto emplace(const_iterator pos, Args &&...args) -> iterator {
+            const auto index = pos - cbegin();
+            emplace_back(std::forward<Args>(args)...);
+            std::rotate(begin() + index, end() - 1, end());
+            return begin() + index;
+        }
+
+        // Throws std::length_error if the vector is full
+        template<typename... Args>
+        constexpr auto emplace_back(Args &&...args) -> reference {
+            check_capacity(_size + 1);
+            std::construct_at(data() + _size, std::forward<Args>(args)...); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            return data()[_size++];                                          // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        [[nodiscard]] constexpr auto empty() const {
+            return _size == 0;
+        }
+
+        constexpr auto end() {
+            return iterator(data() + _size); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        constexpr auto end() const {
+            return cend();
+        }
+
+        constexpr auto erase(const_iterator pos) -> iterator {
+            return erase(pos, pos + 1);
+        }
+
+        constexpr auto erase(const_iterator first, const_iterator last) -> iterator {
+            const auto index = first - cbegin();
+            const auto count = static_cast<size_type>(last - first);
+            std::move(begin() + (last - cbegin()), end(), begin() + index);
+            destroy_at_end(_size - count);
+            return begin() + index;
+        }
+
+        constexpr auto front() -> reference {
+            return data()[0]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        constexpr auto front() const -> const_reference {
+            return data()[0]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        constexpr auto insert(const_iterator pos, const T &value) -> iterator {
+            return emplace(pos, value);
+        }
+
+        constexpr auto insert(const_iterator pos, T &&value) -> iterator {
+            return emplace(pos, std::move(value));
+        }
+
+        constexpr auto insert(const_iterator pos, size_type count, const T &value) -> iterator {
+            check_capacity(_size + count);
+            const auto index = pos - cbegin();
+            const auto old_size = static_cast<difference_type>(_size);
+            resize(_size + count, value);
+            std::rotate(begin() + index, begin() + old_size, end());
+            return begin() + index;
+        }
+
+        // New elements are appended and then rotated into place
+        template<std::input_iterator InputIt>
+        constexpr auto insert(const_iterator pos, InputIt first, InputIt last) -> iterator {
+            if constexpr (std::forward_iterator<InputIt>) {
+                check_capacity(_size + static_cast<size_type>(std::distance(first, last)));
+            }
+
+            const auto index = pos - cbegin();
+            const auto old_size = _size;
+            try {
+                for (; first != last; ++first) {
+                    emplace_back(*first);
+                }
+            } catch (...) {
+                destroy_at_end(old_size);
+                throw;
+            }
+
+            std::rotate(begin() + index, begin() + static_cast<difference_type>(old_size), end());
+            return begin() + index;
+        }
+
+        constexpr auto insert(const_iterator pos, std::initializer_list<T> ilist) -> iterator {
+            return insert(pos, ilist.begin(), ilist.end());
+        }
+
+        [[nodiscard]] static constexpr auto max_size() -> size_type {
+            return N;
+        }
+
+        constexpr auto operator[](size_type pos) -> reference {
+            return data()[pos]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        constexpr auto operator[](size_type pos) const -> const_reference {
+            return data()[pos]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        constexpr auto operator=(const StaticVector &other) -> StaticVector & {
+            if (this != &other) {
+                assign(other.cbegin(), other.cend());
+            }
+
+            return *this;
+        }
+
+        constexpr auto operator=(StaticVector &&other) noexcept(std::is_nothrow_move_assignable_v<T> and std::is_nothrow_move_constructible_v<T>) -> StaticVector & {
+            if (this != &other) {
+                assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                other.clear();
+            }
+
+            return *this;
+        }
+
+        constexpr auto operator=(std::initializer_list<T> list) -> StaticVector & {
+            assign(list.begin(), list.end());
+
+            return *this;
+        }
+
+        constexpr void pop_back() {
+            if (_size == 0) {
+                return;
+            }
+
+            destroy_at_end(_size - 1);
+        }
+
+        constexpr void push_back(const T &value) {
+            emplace_back(value);
+        }
+
+        constexpr void push_back(T &&value) {
+            emplace_back(std::move(value));
+        }
+
+        // Nothing to reserve, but asking for more than N is an error as in any other vector
+        constexpr void reserve(size_type new_cap) {
+            check_capacity(new_cap);
+        }
+
+        // Value-initializes the elements added when growing
+        constexpr void resize(size_type count) {
+            check_capacity(count);
+            destroy_at_end(std::min(count, _size));
+            for (; _size < count; _size++) {
+                std::construct_at(data() + _size); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        }
+
+        constexpr void resize(size_type count, const T &value) {
+            check_capacity(count);
+            destroy_at_end(std::min(count, _size));
+            for (; _size < count; _size++) {
+                std::construct_at(data() + _size, value); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        }
+
+        [[nodiscard]] constexpr auto size() const {
+            return _size;
+        }
+
+    private:
+        detail::StaticStorage<T, N> _storage;
+        size_type _size = 0;
+
+        static constexpr void check_capacity(size_type count) {
+            if (count > N) {
+                throw std::length_error("StaticVector capacity exceeded");
+            }
+        }
+
+        constexpr void destroy_at_end(size_type new_size) {
+            if constexpr (not std::is_trivially_destructible_v<T>) {
+                std::destroy(data() + new_size, data() + _size); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+            _size = new_size;
+        }
+    };
+
+    template<typename T, types::size_t N>
+    constexpr auto operator==(const StaticVector<T, N> &lhs, const StaticVector<T, N> &rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+
+        if constexpr (simd::vectorizable<T>) {
+            if (not std::is_constant_evaluated()) {
+                return simd::equal(lhs, rhs);
+            }
+        }
+        return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+    }
+} // namespace ds
+
+#endif //DS_STATIC_VECTOR_HPP
@@ -0,0 +1,160 @@
+//
+// Created by santiago on 06.08.23.
+//
+
+#ifndef DS_THREAD_POOL_HPP
+#define DS_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "type_definitions.hpp"
+
+namespace ds {
+
+    // Fixed set of worker threads with one task queue each. Workers pop their own queue from the back
+    // and, once it is empty, steal from the front of the others. Tasks submitted by a worker go to its
+    // own queue, so the work a task spawns tends to stay on the same core.
+    class ThreadPool {
+    public:
+        using size_type = types::size_t;
+        using Task = std::function<void()>;
+
+        explicit ThreadPool(size_type num_threads = default_thread_count());
+
+        ThreadPool(const ThreadPool &) = delete;
+
+        ThreadPool(ThreadPool &&) = delete;
+
+        // Runs the tasks still queued before joining the workers
+        ~ThreadPool();
+
+        auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+
+        auto operator=(ThreadPool &&) -> ThreadPool & = delete;
+
+        static auto default_thread_count() -> size_type;
+
+        // Pool shared by the parallel algorithms when none is given, with default_thread_count() workers
+        static auto global() -> ThreadPool &;
+
+        // Calls fn(begin, end) over consecutive chunks of [0, count) holding at least grain indices each.
+        // The calling thread runs queued tasks until every chunk is done, so it is safe to call from a
+        // task. The first exception thrown by fn is rethrown once all chunks have finished.
+        template<typename Fn>
+        void parallel_for(size_type count, size_type grain, Fn &&fn) {
+            const auto chunk = std::max({grain, size_type{1}, (count + max_chunks() - 1) / max_chunks()});
+            if (count <= chunk) {
+                if (count > 0) {
+                    fn(size_type{0}, count);
+                }
+                return;
+            }
+
+            const auto num_chunks = (count + chunk - 1) / chunk;
+            auto state = std::make_shared<ForState>(num_chunks, _pending);
+            const auto run_chunk = [state, &fn, chunk, count](size_type i) {
+                state->run([&] { fn(i * chunk, std::min(count, (i + 1) * chunk)); });
+            };
+            // Chunks are handed out in reverse, leaving the first one to the calling thread
+            for (auto i = num_chunks - 1; i > 0; i--) {
+                try {
+                    submit([run_chunk, i] { run_chunk(i); });
+                } catch (...) {
+                    // Out of memory for the task: the chunk still has to run for the wait to finish
+                    run_chunk(i);
+                }
+            }
+            run_chunk(0);
+            wait(*state);
+        }
+
+        // Runs one queued task on the calling thread, if any; returns whether it did
+        auto run_pending_task() -> bool;
+
+        [[nodiscard]] auto size() const -> size_type {
+            return _workers.size();
+        }
+
+        // Tasks must not throw: as with std::thread, an exception escaping one calls std::terminate.
+        // parallel_for catches the exceptions of its chunks and rethrows them to the caller instead.
+        void submit(Task task);
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        // Completion state of a parallel_for, shared with its tasks so it outlives the last notify.
+        // Finishing the last chunk bumps the pool's wakeup counter, which the caller sleeps on
+        // between queued tasks.
+        class ForState {
+        public:
+            ForState(size_type num_chunks, std::atomic<types::ptrdiff_t> &wakeup) : _remaining(num_chunks), _wakeup(wakeup) {}
+
+            template<typename Fn>
+            void run(Fn &&fn) noexcept {
+                try {
+                    fn();
+                } catch (...) {
+                    const std::lock_guard lock(_error_mutex);
+                    if (not _error) {
+                        _error = std::current_exception();
+                    }
+                }
+
+                if (_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    _wakeup.fetch_add(1, std::memory_order_release);
+                    _wakeup.notify_all();
+                }
+            }
+
+            auto remaining() const {
+                return _remaining.load(std::memory_order_acquire);
+            }
+
+            void rethrow_error() const {
+                if (_error) {
+                    std::rethrow_exception(_error);
+                }
+            }
+
+        private:
+            std::atomic<size_type> _remaining;
+            std::atomic<types::ptrdiff_t> &_wakeup;
+            std::mutex _error_mutex;
+            std::exception_ptr _error;
+        };
+
+        std::vector<std::unique_ptr<Queue>> _queues;
+        std::vector<std::thread> _workers;
+        std::atomic<size_type> _next_queue = 0;
+        // Bumped on every submit and when a parallel_for finishes, and waited on by idle workers and
+        // by callers of parallel_for. It may count tasks that were already popped, so it is only a
+        // hint for sleeping; the queues are the real state.
+        std::atomic<types::ptrdiff_t> _pending = 0;
+        std::atomic<bool> _stopping = false;
+
+        // Enough chunks per thread to balance uneven work without drowning in tasks
+        [[nodiscard]] auto max_chunks() const -> size_type {
+            return 4 * (size() + 1);
+        }
+
+        auto try_pop(size_type first_queue, Task &task) -> bool;
+
+        void wait(const ForState &state);
+
+        void worker_loop(size_type index);
+    };
+
+} // namespace ds
+
+#endif //DS_THREAD_POOL_HPP
@@ -6,21 +6,37 @@
 #define DS_VECTOR_HPP
 
 #include <algorithm>
+#include <cstring>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
+#include "aligned_allocator.hpp"
 #include "contiguous_iterator.hpp"
+#include "growth_policy.hpp"
+#include "inline_buffer.hpp"
+#include "relocation.hpp"
+#include "simd.hpp"
 #include "type_definitions.hpp"
 
 namespace ds {
 
-    template<typename T>
+    // InlineCapacity elements are stored inside the vector itself; see SmallVector. GrowthPolicy picks
+    // the new capacity whenever an insertion runs out of space; see growth_policy.hpp.
+    // Usable in constant expressions when InlineCapacity is 0, as inline storage is raw bytes; like
+    // std::vector, a Vector created during constant evaluation has to be destroyed before it ends.
+    template<typename T, typename Allocator = std::allocator<T>, types::size_t InlineCapacity = 0, typename GrowthPolicy = DoublingGrowth<>>
     class Vector {
+        using alloc_traits = std::allocator_traits<Allocator>;
+
     public:
         using size_type = types::size_t;
         using value_type = T;
+        using allocator_type = Allocator;
         using reference = value_type &;
         using const_reference = const value_type &;
         using difference_type = types::ptrdiff_t;
@@ -29,70 +45,110 @@ namespace ds {
         using const_iterator = it::ContiguousIterator<T, const_reference>;
 
 
-        Vector() : _size(0), _capacity(0), _values(nullptr) {}
+        constexpr Vector() noexcept(noexcept(Allocator())) : Vector(Allocator()) {}
+
+        constexpr explicit Vector(const Allocator &alloc) noexcept : _allocator(alloc), _size(0), _capacity(InlineCapacity), _values(nullptr) {
+            _values = _buffer.data();
+        }
 
-        explicit Vector(size_type size, const T &value = T()) : _size(size), _capacity(size), _values(nullptr) {
+        constexpr explicit Vector(size_type size, const Allocator &alloc = Allocator()) : Vector(alloc) {
             // TODO: Look for a cleaner way of doing this; otherwise we cannot use all values.
             // Also, this requires knowledge of what size_t is, which creates coupling.
             if (static_cast<long long>(size) < 0) {
                 throw std::length_error("Creating vector with negative number");
             }
 
-            _values = new T[_size]; // NOLINT(cppcoreguidelines-owning-memory)
-            std::fill(begin(), end(), value);
+            allocate_storage(size);
+            construct_at_end(size);
         }
 
-        Vector(std::initializer_list<T> init) : Vector(init.size()) { // NOLINT(cppcoreguidelines-pro-type-member-init)
-            std::copy(init.begin(), init.end(), begin());
+        constexpr Vector(size_type size, const T &value, const Allocator &alloc = Allocator()) : Vector(alloc) {
+            if (static_cast<long long>(size) < 0) {
+                throw std::length_error("Creating vector with negative number");
+            }
+
+            allocate_storage(size);
+            construct_at_end(size, value);
         }
 
+        constexpr Vector(std::initializer_list<T> init, const Allocator &alloc = Allocator()) : Vector(init.begin(), init.end(), alloc) {}
+
         template<std::input_iterator InputIt>
-        Vector(InputIt first, InputIt last) : Vector(std::distance(first, last)) { // NOLINT(cppcoreguidelines-pro-type-member-init)
-            std::copy(first, last, begin());
+        constexpr Vector(InputIt first, InputIt last, const Allocator &alloc = Allocator()) : Vector(alloc) {
+            const auto count = static_cast<size_type>(std::distance(first, last));
+            allocate_storage(count);
+            copy_construct_at_end(first, last);
         }
 
-        Vector(const Vector &other) : Vector(other.size()) { // NOLINT(cppcoreguidelines-pro-type-member-init)
-            std::copy(other.cbegin(), other.cend(), begin());
+        constexpr Vector(const Vector &other) : Vector(other, alloc_traits::select_on_container_copy_construction(other._allocator)) {}
+
+        constexpr Vector(const Vector &other, const Allocator &alloc) : Vector(alloc) {
+            allocate_storage(other.size());
+            copy_construct_at_end(other.cbegin(), other.cend());
         }
 
-        Vector(Vector &&other) noexcept : _size(std::move(other._size)), _capacity(std::move(other._capacity)), _values(other._values) {
-            other._values = nullptr;
+        constexpr Vector(Vector &&other) noexcept(InlineCapacity == 0 or std::is_nothrow_move_constructible_v<T>)
+            : _allocator(std::move(other._allocator)), _size(0), _capacity(InlineCapacity), _values(nullptr) {
+            _values = _buffer.data();
+            take_storage(other);
         }
 
-        ~Vector() {
-            delete[] _values;
+        constexpr ~Vector() {
+            release();
         }
 
-        void assign(size_type count, const T &value) {
+        constexpr void assign(size_type count, const T &value) {
             if (not can_store(count)) {
-                resize(count);
+                release();
+                allocate_storage(count);
+                construct_at_end(count, value);
+                return;
             }
 
-            _size = count;
-            std::fill(begin(), end(), value);
+            const auto common = std::min(count, _size);
+            if constexpr (simd::vectorizable<T>) {
+                if (not std::is_constant_evaluated()) {
+                    simd::fill(std::span(_values, common), value);
+                } else {
+                    std::fill(_values, _values + common, value); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                }
+            } else {
+                std::fill(_values, _values + common, value); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+            if (count > _size) {
+                construct_at_end(count - _size, value);
+            } else {
+                destroy_at_end(count);
+            }
         }
 
         template<std::input_iterator InputIt>
-        void assign(InputIt first, InputIt last) {
-            const size_type count = std::distance(first, last);
+        constexpr void assign(InputIt first, InputIt last) {
+            const auto count = static_cast<size_type>(std::distance(first, last));
             if (not can_store(count)) {
-                resize(count);
+                release();
+                allocate_storage(count);
+                copy_construct_at_end(first, last);
+                return;
             }
 
-            _size = count;
-            std::copy(first, last, begin());
-        }
+            auto out = _values;
+            for (; first != last and out != _values + _size; ++first, ++out) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                *out = *first;
+            }
 
-        void assign(std::initializer_list<T> ilist) {
-            if (not can_store(ilist.size())) {
-                resize(ilist.size());
+            if (count > _size) {
+                copy_construct_at_end(first, last);
+            } else {
+                destroy_at_end(count);
             }
+        }
 
-            _size = ilist.size();
-            std::copy(ilist.begin(), ilist.end(), begin());
+        constexpr void assign(std::initializer_list<T> ilist) {
+            assign(ilist.begin(), ilist.end());
         }
 
-        auto at(size_type pos) {
+        constexpr auto at(size_type pos) {
             if (pos >= _size) {
                 throw std::out_of_range("id is out of range");
             }
@@ -100,112 +156,240 @@ namespace ds {
             return _values[pos]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
         }
 
-        auto back() {
+        constexpr auto back() {
             return _values[_size - 1]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
         }
 
-        auto begin() {
-            return iterator(&_values[0]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        constexpr auto begin() {
+            return iterator(_values);
         }
 
-        [[nodiscard]] auto capacity() const {
+        constexpr auto begin() const {
+            return cbegin();
+        }
+
+        [[nodiscard]] constexpr auto capacity() const {
             return _capacity;
         }
 
-        auto cbegin() const {
-            return const_iterator(&_values[0]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        constexpr auto cbegin() const {
+            return const_iterator(_values);
         }
 
-        auto cend() const {
-            return const_iterator(&_values[_size]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        constexpr auto cend() const {
+            return const_iterator(_values + _size); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
         }
 
-        void clear() {
-            _size = 0;
+        constexpr void clear() {
+            destroy_at_end(0);
         }
 
-        auto data() {
+        constexpr auto data() {
             return _values;
         }
 
-        auto empty() {
-            return begin() == end();
+        constexpr auto data() const -> const T * {
+            return _values;
+        }
+
+        template<typename... Args>
+        constexpr auto emplace(const_iterator pos, Args &&...args) -> iterator {
+            const auto index = static_cast<size_type>(pos - cbegin());
+            if (index == _size) {
+                emplace_back(std::forward<Args>(args)...);
+                return begin() + index;
+            }
+
+            // Built up front, as args may refer to elements that are about to move
+            T value(std::forward<Args>(args)...);
+            return insert_n(index, 1, [&](T *dest) { alloc_traits::construct(_allocator, dest, std::move(value)); });
+        }
+
+        template<typename... Args>
+        constexpr auto emplace_back(Args &&...args) -> reference {
+            if (can_store_more_elements()) {
+                alloc_traits::construct(_allocator, _values + _size, std::forward<Args>(args)...); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            } else {
+                T value(std::forward<Args>(args)...);
+                expand(_size + 1);
+                alloc_traits::construct(_allocator, _values + _size, std::move(value)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+
+            return _values[_size++]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        [[nodiscard]] constexpr auto empty() const {
+            return _size == 0;
+        }
+
+        constexpr auto end() {
+            return iterator(_values + _size); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
         }
 
-        auto end() {
-            return iterator(&_values[_size]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        constexpr auto end() const {
+            return cend();
         }
 
-        auto front() {
+        constexpr auto erase(const_iterator pos) -> iterator {
+            return erase(pos, pos + 1);
+        }
+
+        constexpr auto erase(const_iterator first, const_iterator last) -> iterator {
+            const auto index = static_cast<size_type>(first - cbegin());
+            const auto count = static_cast<size_type>(last - first);
+            if (count == 0) {
+                return begin() + index;
+            }
+
+            T *gap = _values + index; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            T *tail = gap + count; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            T *old_end = _values + _size; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            if (relocates_bitwise()) {
+                destroy(gap, tail);
+                std::memmove(static_cast<void *>(gap), static_cast<const void *>(tail), (old_end - tail) * sizeof(T));
+                _size -= count;
+            } else {
+                std::move(tail, old_end, gap);
+                destroy_at_end(_size - count);
+            }
+
+            return begin() + index;
+        }
+
+        constexpr auto front() {
             return _values[0]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
         }
 
-        [[nodiscard]] auto max_size() const {
-            return std::numeric_limits<difference_type>::max() / sizeof(T);
+        [[nodiscard]] constexpr auto get_allocator() const {
+            return _allocator;
+        }
+
+        constexpr auto insert(const_iterator pos, const T &value) -> iterator {
+            return emplace(pos, value);
+        }
+
+        constexpr auto insert(const_iterator pos, T &&value) -> iterator {
+            return emplace(pos, std::move(value));
+        }
+
+        constexpr auto insert(const_iterator pos, size_type count, const T &value) -> iterator {
+            const T copy(value);
+            return insert_n(static_cast<size_type>(pos - cbegin()), count, [&](T *dest) { alloc_traits::construct(_allocator, dest, copy); });
+        }
+
+        template<std::input_iterator InputIt>
+        constexpr auto insert(const_iterator pos, InputIt first, InputIt last) -> iterator {
+            const auto index = static_cast<size_type>(pos - cbegin());
+            if constexpr (std::forward_iterator<InputIt>) {
+                const auto count = static_cast<size_type>(std::distance(first, last));
+                return insert_n(index, count, [&](T *dest) {
+                    alloc_traits::construct(_allocator, dest, *first);
+                    ++first;
+                });
+            } else {
+                const auto old_size = _size;
+                try {
+                    for (; first != last; ++first) {
+                        emplace_back(*first);
+                    }
+                } catch (...) {
+                    destroy_at_end(old_size);
+                    throw;
+                }
+
+                std::rotate(_values + index, _values + old_size, _values + _size); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                return begin() + index;
+            }
+        }
+
+        constexpr auto insert(const_iterator pos, std::initializer_list<T> ilist) -> iterator {
+            return insert(pos, ilist.begin(), ilist.end());
+        }
+
+        [[nodiscard]] constexpr auto max_size() const {
+            return std::min<size_type>(std::numeric_limits<difference_type>::max() / sizeof(T), alloc_traits::max_size(_allocator));
         }
 
-        auto operator[](size_type pos) -> reference {
+        constexpr auto operator[](size_type pos) -> reference {
             return _values[pos]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
         }
 
-        auto operator[](size_type pos) const -> const_reference {
+        constexpr auto operator[](size_type pos) const -> const_reference {
             return _values[pos]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
         }
 
-        auto operator=(const Vector<T> &other) -> Vector<T> & {
+        constexpr auto operator=(const Vector &other) -> Vector & {
             if (this == &other) {
                 return *this;
             }
 
-            if (not can_store(other.size())) {
-                resize(other.size());
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                if (_allocator != other._allocator) {
+                    release();
+                }
+                _allocator = other._allocator;
             }
 
-            _size = other.size();
-            // TODO: Once we have cbegin() and cend(), replace by std::copy
-            std::copy(other.cbegin(), other.cend(), begin());
+            assign(other.cbegin(), other.cend());
 
             return *this;
         }
 
-        auto operator=(Vector<T> &&other) noexcept -> Vector<T> & {
-            _size = std::move(other._size);
-            _capacity = std::move(other._capacity);
-            _values = other._values;
-            other._values = nullptr;
-            return *this;
-        }
+        constexpr auto operator=(Vector &&other) noexcept((alloc_traits::propagate_on_container_move_assignment::value or
+                                                 alloc_traits::is_always_equal::value) and
+                                                (InlineCapacity == 0 or std::is_nothrow_move_constructible_v<T>)) -> Vector & {
+            if (this == &other) {
+                return *this;
+            }
 
-        auto operator=(std::initializer_list<T> list) -> Vector<T> & {
-            if (_capacity < list.size()) {
-                resize(list.size());
+            if constexpr (not alloc_traits::propagate_on_container_move_assignment::value and
+                          not alloc_traits::is_always_equal::value) {
+                if (_allocator != other._allocator) {
+                    assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                    return *this;
+                }
             }
 
+            release();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                _allocator = std::move(other._allocator);
+            }
+
+            take_storage(other);
+            return *this;
+        }
 
-            _size = list.size();
-            std::copy(list.begin(), list.end(), begin());
+        constexpr auto operator=(std::initializer_list<T> list) -> Vector & {
+            assign(list.begin(), list.end());
 
             return *this;
         }
 
-        void pop_back() {
+        // Number of elements from data() on that lie within the storage: size() rounded up to the
+        // alignment of the allocator (see AlignedAllocator), but at most capacity(). The ones past
+        // size() hold no elements, but SIMD loops over trivial types may load and store them, so that
+        // they finish with a whole vector instead of a scalar remainder.
+        [[nodiscard]] constexpr auto padded_size() const {
+            return std::min(_capacity, round_to_alignment(_size));
+        }
+
+        constexpr void pop_back() {
             if (_size == 0) {
                 return;
             }
 
-            _size--;
+            destroy_at_end(_size - 1);
         }
 
-        void push_back(const T &value) {
-            if (not can_store_more_elements()) {
-                expand();
-            }
+        constexpr void push_back(const T &value) {
+            emplace_back(value);
+        }
 
-            _values[_size] = value; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-            _size++;
+        constexpr void push_back(T &&value) {
+            emplace_back(std::move(value));
         }
 
-        void reserve(size_type new_cap) {
+        constexpr void reserve(size_type new_cap) {
             // TODO: Look for a cleaner way of doing this; otherwise we cannot use all values.
             // Also, this requires knowledge of what size_t is, which creates coupling.
             if (static_cast<long long>(new_cap) < 0) {
@@ -218,70 +402,305 @@ namespace ds {
                 return;
             }
 
-            resize(new_cap);
+            reallocate(new_cap);
         }
 
-        void shrink_to_fit() {
-            resize(_size);
+        // Value-initializes the elements added when growing
+        constexpr void resize(size_type count) {
+            if (count <= _size) {
+                destroy_at_end(count);
+                return;
+            }
+
+            if (not can_store(count)) {
+                expand(count);
+            }
+            construct_at_end(count - _size);
         }
 
-        [[nodiscard]] auto size() const {
+        constexpr void resize(size_type count, const T &value) {
+            if (count <= _size) {
+                destroy_at_end(count);
+                return;
+            }
+
+            // Copied first, as value may be an element that growing is about to move
+            const T copy(value);
+            if (not can_store(count)) {
+                expand(count);
+            }
+            construct_at_end(count - _size, copy);
+        }
+
+        // Sets the size to count without initializing new elements, so that they can be written later;
+        // e.g. by parallel_fill, whose worker threads then first-touch the pages they fill
+        constexpr void resize_for_overwrite(size_type count)
+            requires std::is_trivially_default_constructible_v<T> and std::is_trivially_destructible_v<T>
+        {
+            reserve(count);
+            _size = count;
+        }
+
+        constexpr void shrink_to_fit() {
+            reallocate(_size);
+        }
+
+        [[nodiscard]] constexpr auto size() const {
             return _size;
         }
 
+        [[nodiscard]] constexpr auto uses_inline_storage() const {
+            return InlineCapacity > 0 and _values == _buffer.data();
+        }
+
     private:
-        size_type _capacity;
+        // Arithmetic elements built by an allocator without its own construct() can be written directly
+        static constexpr bool FILLS_RAW_STORAGE = simd::vectorizable<T> and not requires(Allocator &alloc, T *ptr, const T &value) {
+            alloc.construct(ptr, value);
+        };
+
+        static constexpr size_type ALIGNMENT = allocation_alignment_v<Allocator, T>;
+
+        [[no_unique_address]] Allocator _allocator;
+        [[no_unique_address]] detail::InlineBuffer<T, InlineCapacity> _buffer;
         size_type _size;
+        size_type _capacity;
         T *_values;
 
-        inline auto can_store_more_elements() {
+        // memcpy and memmove cannot run during constant evaluation, so elements are moved one by one there
+        static constexpr auto relocates_bitwise() -> bool {
+            return is_trivially_relocatable_v<T> and not std::is_constant_evaluated();
+        }
+
+        // Smallest number of elements at least count whose bytes fill whole alignment units
+        static constexpr auto round_to_alignment(size_type count) -> size_type {
+            if constexpr (ALIGNMENT == alignof(T)) {
+                return count;
+            } else {
+                return (count * sizeof(T) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT / sizeof(T);
+            }
+        }
+
+        // Capacities of allocated storage are rounded to whole alignment units, as the allocator
+        // hands those out anyway
+        static constexpr auto storage_capacity(size_type count) -> size_type {
+            return count <= InlineCapacity ? InlineCapacity : round_to_alignment(count);
+        }
+
+        constexpr auto can_store_more_elements() {
             return _capacity > _size;
         }
 
-        inline auto can_store(size_type num_elements) {
+        constexpr auto can_store(size_type num_elements) {
             return _capacity >= num_elements;
         }
 
-        void expand() {
-            const size_type new_capacity = _capacity > 0 ? _capacity * 2 : 1;
-            resize(new_capacity);
+        // Requests that fit in the inline buffer (always the case for 0 elements) never reach the allocator
+        constexpr auto allocate(size_type num_elements) -> T * {
+            if (num_elements <= InlineCapacity) {
+                return _buffer.data();
+            }
+
+            return alloc_traits::allocate(_allocator, num_elements);
+        }
+
+        constexpr void deallocate(T *storage, size_type num_elements) {
+            if (storage != _buffer.data()) {
+                alloc_traits::deallocate(_allocator, storage, num_elements);
+            }
+        }
+
+        // Only valid on a vector without elements and storage of its own
+        constexpr void allocate_storage(size_type num_elements) {
+            _capacity = storage_capacity(num_elements);
+            _values = allocate(_capacity);
+        }
+
+        // Only valid on a vector without elements and storage of its own. Inline elements cannot be
+        // stolen, so they are relocated one by one.
+        constexpr void take_storage(Vector &other) {
+            if (other.uses_inline_storage()) {
+                relocate(other._values, other._values + other._size, _values); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                _size = std::exchange(other._size, 0);
+                return;
+            }
+
+            _size = std::exchange(other._size, 0);
+            _capacity = std::exchange(other._capacity, InlineCapacity);
+            _values = std::exchange(other._values, other._buffer.data());
+        }
+
+        constexpr void destroy(T *first, T *last) {
+            if constexpr (not std::is_trivially_destructible_v<T>) {
+                for (; first != last; ++first) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    alloc_traits::destroy(_allocator, first);
+                }
+            }
+        }
+
+        // Destroys the elements in [new_size, size()) and shrinks size() accordingly
+        constexpr void destroy_at_end(size_type new_size) {
+            destroy(_values + new_size, _values + _size); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            _size = new_size;
+        }
+
+        template<typename... Args>
+        constexpr void construct_at_end(size_type count, const Args &...args) {
+            if constexpr (sizeof...(Args) == 1 and FILLS_RAW_STORAGE) {
+                if (not std::is_constant_evaluated()) {
+                    simd::fill(std::span(_values + _size, count), args...); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    _size += count;
+                    return;
+                }
+            }
+
+            for (size_type i = 0; i < count; i++) {
+                alloc_traits::construct(_allocator, _values + _size, args...); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                _size++;
+            }
+        }
+
+        template<std::input_iterator InputIt>
+        constexpr void copy_construct_at_end(InputIt first, InputIt last) {
+            for (; first != last; ++first) {
+                alloc_traits::construct(_allocator, _values + _size, *first); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                _size++;
+            }
+        }
+
+        // Moves [first, last) into the uninitialized storage at dest and ends the lifetime of the
+        // source elements. Falls back to copying when moving could throw, so a failure leaves the
+        // source untouched and dest empty.
+        constexpr void relocate(T *first, T *last, T *dest) {
+            if (relocates_bitwise()) {
+                if (first != last) {
+                    std::memcpy(static_cast<void *>(dest), static_cast<const void *>(first), (last - first) * sizeof(T));
+                }
+            } else {
+                T *out = dest;
+                try {
+                    for (T *in = first; in != last; ++in, ++out) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                        alloc_traits::construct(_allocator, out, std::move_if_noexcept(*in));
+                    }
+                } catch (...) {
+                    destroy(dest, out);
+                    throw;
+                }
+
+                destroy(first, last);
+            }
+        }
+
+        constexpr void release() {
+            destroy_at_end(0);
+            deallocate(_values, _capacity);
+            _values = _buffer.data();
+            _capacity = InlineCapacity;
+        }
+
+        constexpr void expand(size_type required_capacity) {
+            reallocate(GrowthPolicy::next_capacity(_capacity, required_capacity, sizeof(T)));
+        }
+
+        // Opens a gap of count elements at index and fills it calling construct_one once per slot, in
+        // order. Trivially relocatable elements are shifted with memmove; others are appended and
+        // rotated into place, so a throwing constructor never leaves holes behind.
+        template<typename ConstructOne>
+        constexpr auto insert_n(size_type index, size_type count, ConstructOne construct_one) -> iterator {
+            if (count == 0) {
+                return begin() + index;
+            }
+
+            if (not can_store(_size + count)) {
+                expand(_size + count);
+            }
+
+            if (relocates_bitwise()) {
+                T *gap = _values + index; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                const auto tail_bytes = (_size - index) * sizeof(T);
+                std::memmove(static_cast<void *>(gap + count), static_cast<const void *>(gap), tail_bytes); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+                size_type constructed = 0;
+                try {
+                    for (; constructed < count; constructed++) {
+                        construct_one(gap + constructed); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    }
+                } catch (...) {
+                    destroy(gap, gap + constructed); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    std::memmove(static_cast<void *>(gap), static_cast<const void *>(gap + count), tail_bytes); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    throw;
+                }
+                _size += count;
+            } else {
+                const auto old_size = _size;
+                try {
+                    for (size_type i = 0; i < count; i++) {
+                        construct_one(_values + _size); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                        _size++;
+                    }
+                } catch (...) {
+                    destroy_at_end(old_size);
+                    throw;
+                }
+
+                std::rotate(_values + index, _values + old_size, _values + _size); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+
+            return begin() + index;
         }
 
-        void resize(size_type new_capacity) {
+        constexpr void reallocate(size_type new_capacity) {
             if (new_capacity < _size) {
                 throw std::length_error("New capacity must be larger than current _size");
             }
 
+            new_capacity = storage_capacity(new_capacity);
+
             if (new_capacity == _capacity) {
                 return;
             }
 
-            T *new_storage = new T[new_capacity]; // NOLINT(cppcoreguidelines-owning-memory)
+            if constexpr (extending_allocator<Allocator, T>) {
+                if (not std::is_constant_evaluated() and _values != _buffer.data() and new_capacity > InlineCapacity and _allocator.try_extend(_values, _capacity, new_capacity)) {
+                    _capacity = new_capacity;
+                    return;
+                }
+            }
 
-            for (size_type i = 0; i < _size; i++) {
-                new_storage[i] = _values[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            if constexpr (is_trivially_relocatable_v<T> and reallocating_allocator<Allocator, T>) {
+                if (not std::is_constant_evaluated() and _values != _buffer.data() and new_capacity > InlineCapacity) {
+                    _values = _allocator.reallocate(_values, _capacity, new_capacity);
+                    _capacity = new_capacity;
+                    return;
+                }
             }
 
-            std::swap(_values, new_storage);
-            _capacity = new_capacity;
+            T *new_storage = allocate(new_capacity);
+            try {
+                relocate(_values, _values + _size, new_storage); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            } catch (...) {
+                deallocate(new_storage, new_capacity);
+                throw;
+            }
+            deallocate(_values, _capacity);
 
-            delete[] new_storage; // NOLINT(cppcoreguidelines-owning-memory)
+            _values = new_storage;
+            _capacity = new_capacity;
         }
     };
 
-    template<typename T>
-    auto operator==(const Vector<T> &lhs, const Vector<T> &rhs) {
+    template<typename T, typename Allocator, types::size_t InlineCapacity, typename GrowthPolicy>
+    constexpr auto operator==(const Vector<T, Allocator, InlineCapacity, GrowthPolicy> &lhs, const Vector<T, Allocator, InlineCapacity, GrowthPolicy> &rhs) {
         if (lhs.size() != rhs.size()) {
             return false;
         }
 
-        for (int i = 0; i < lhs.size(); i++) {
-            if (lhs[i] != rhs[i]) {
-                return false;
+        if constexpr (simd::vectorizable<T>) {
+            if (not std::is_constant_evaluated()) {
+                return simd::equal(lhs, rhs);
             }
         }
-
-        return true;
+        return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
     }
 } // namespace ds
 
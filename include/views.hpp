@@ -0,0 +1,628 @@
+//
+// Created by santiago on 15.10.23.
+//
+
+#ifndef DS_VIEWS_HPP
+#define DS_VIEWS_HPP
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "type_definitions.hpp"
+#include "vector.hpp"
+
+namespace ds::views::detail {
+    // Element type of views whose elements are tuples of references. C++20 gives a std::tuple of
+    // references no common reference with the matching tuple of values, which ranges require of
+    // iterators; this tuple declares one below.
+    template<typename... Ts>
+    struct ReferenceTuple : std::tuple<Ts...> {
+        using std::tuple<Ts...>::tuple;
+
+        // Refers to the elements of values, which std::tuple only does from C++23 on
+        template<typename... Us>
+            requires(sizeof...(Us) == sizeof...(Ts) and (std::is_constructible_v<Ts, Us &> and ...))
+        constexpr ReferenceTuple(std::tuple<Us...> &values) // NOLINT(google-explicit-constructor)
+            : ReferenceTuple(values, std::index_sequence_for<Us...>()) {}
+
+    private:
+        template<typename Values, std::size_t... I>
+        constexpr ReferenceTuple(Values &values, std::index_sequence<I...>) : std::tuple<Ts...>(std::get<I>(values)...) {}
+    };
+} // namespace ds::views::detail
+
+template<typename... Ts>
+struct std::tuple_size<ds::views::detail::ReferenceTuple<Ts...>> : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template<std::size_t I, typename... Ts>
+struct std::tuple_element<I, ds::views::detail::ReferenceTuple<Ts...>> : std::tuple_element<I, std::tuple<Ts...>> {};
+
+template<typename... Ts, typename... Us, template<typename> typename TQual, template<typename> typename UQual>
+    requires(sizeof...(Ts) == sizeof...(Us))
+struct std::basic_common_reference<ds::views::detail::ReferenceTuple<Ts...>, std::tuple<Us...>, TQual, UQual> {
+    using type = ds::views::detail::ReferenceTuple<std::common_reference_t<TQual<Ts>, UQual<Us>>...>;
+};
+
+template<typename... Ts, typename... Us, template<typename> typename TQual, template<typename> typename UQual>
+    requires(sizeof...(Ts) == sizeof...(Us))
+struct std::basic_common_reference<std::tuple<Us...>, ds::views::detail::ReferenceTuple<Ts...>, UQual, TQual> {
+    using type = ds::views::detail::ReferenceTuple<std::common_reference_t<TQual<Ts>, UQual<Us>>...>;
+};
+
+// Lazy adaptors over ranges such as Vector. A pipeline like
+//     v | views::filter(p) | views::map(f) | views::collect()
+// runs every stage for one element before moving to the next, so it makes a single pass over v and
+// allocates nothing but the result. Adaptors take any std::ranges range and give std::ranges views,
+// so they can be mixed with std::views ones.
+namespace ds::views {
+
+    namespace detail {
+        template<bool Const, typename T>
+        using maybe_const = std::conditional_t<Const, const T, T>;
+
+        // Adaptor that still misses its range, such as chunk(4). It is applied with | or by calling it.
+        template<typename Apply>
+        struct Closure {
+            Apply apply;
+
+            template<std::ranges::viewable_range Range>
+            constexpr auto operator()(Range &&range) const {
+                return apply(std::forward<Range>(range));
+            }
+
+            template<std::ranges::viewable_range Range>
+            friend constexpr auto operator|(Range &&range, const Closure &closure) {
+                return closure(std::forward<Range>(range));
+            }
+        };
+
+        // Strongest iterator concept modelled by all of Ranges, capped at random access
+        template<typename... Ranges>
+        constexpr auto common_iterator_concept() {
+            if constexpr ((std::ranges::random_access_range<Ranges> and ...)) {
+                return std::random_access_iterator_tag{};
+            } else if constexpr ((std::ranges::bidirectional_range<Ranges> and ...)) {
+                return std::bidirectional_iterator_tag{};
+            } else {
+                return std::forward_iterator_tag{};
+            }
+        }
+
+        template<typename... Ranges>
+        using iterator_concept_t = decltype(common_iterator_concept<Ranges...>());
+
+        // Pushes every element of range into a new Container, reserving first if the size is known
+        template<typename Container, typename Range>
+        constexpr auto collect_into(Range &&range) -> Container {
+            Container values;
+            if constexpr (std::ranges::sized_range<Range> and requires { values.reserve(0); }) {
+                values.reserve(static_cast<typename Container::size_type>(std::ranges::size(range)));
+            }
+
+            for (auto &&value: range) {
+                values.emplace_back(std::forward<decltype(value)>(value));
+            }
+            return values;
+        }
+    } // namespace detail
+
+    // Tuples of the elements at the same position of each range, up to the end of the shortest one
+    template<std::ranges::view... Views>
+        requires(sizeof...(Views) > 0 and (std::ranges::forward_range<Views> and ...))
+    class ZipView : public std::ranges::view_interface<ZipView<Views...>> {
+        template<bool Const>
+        static constexpr bool bidirectional = (std::ranges::bidirectional_range<detail::maybe_const<Const, Views>> and ...);
+
+        template<bool Const>
+        static constexpr bool random_access = (std::ranges::random_access_range<detail::maybe_const<Const, Views>> and ...);
+
+        template<bool Const>
+        static constexpr bool sized = (std::ranges::sized_range<detail::maybe_const<Const, Views>> and ...);
+
+    public:
+        template<bool Const>
+        class Sentinel;
+
+        template<bool Const>
+        class Iterator {
+        public:
+            using iterator_concept = detail::iterator_concept_t<detail::maybe_const<Const, Views>...>;
+            // Elements are tuples built on the fly, which the classic categories only allow for input
+            using iterator_category = std::input_iterator_tag;
+            using value_type = std::tuple<std::ranges::range_value_t<detail::maybe_const<Const, Views>>...>;
+            using difference_type = std::common_type_t<std::ranges::range_difference_t<detail::maybe_const<Const, Views>>...>;
+
+            Iterator() = default;
+
+            constexpr explicit Iterator(std::tuple<std::ranges::iterator_t<detail::maybe_const<Const, Views>>...> current)
+                : _current(std::move(current)) {}
+
+            constexpr auto operator*() const {
+                return std::apply([](const auto &...it) { return detail::ReferenceTuple<std::iter_reference_t<std::remove_cvref_t<decltype(it)>>...>(*it...); }, _current);
+            }
+
+            constexpr auto operator[](difference_type offset) const
+                requires random_access<Const>
+            {
+                return *(*this + offset);
+            }
+
+            constexpr auto operator++() -> Iterator & {
+                std::apply([](auto &...it) { (++it, ...); }, _current);
+                return *this;
+            }
+
+            constexpr auto operator++(int) -> Iterator {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            constexpr auto operator--() -> Iterator &
+                requires bidirectional<Const>
+            {
+                std::apply([](auto &...it) { (--it, ...); }, _current);
+                return *this;
+            }
+
+            constexpr auto operator--(int) -> Iterator
+                requires bidirectional<Const>
+            {
+                auto tmp = *this;
+                --*this;
+                return tmp;
+            }
+
+            constexpr auto operator+=(difference_type offset) -> Iterator &
+                requires random_access<Const>
+            {
+                std::apply([offset](auto &...it) { ((it += static_cast<std::iter_difference_t<std::remove_cvref_t<decltype(it)>>>(offset)), ...); }, _current);
+                return *this;
+            }
+
+            constexpr auto operator-=(difference_type offset) -> Iterator &
+                requires random_access<Const>
+            {
+                return *this += -offset;
+            }
+
+            constexpr auto operator+(difference_type offset) const -> Iterator
+                requires random_access<Const>
+            {
+                auto tmp = *this;
+                return tmp += offset;
+            }
+
+            friend constexpr auto operator+(difference_type offset, const Iterator &it) -> Iterator
+                requires random_access<Const>
+            {
+                return it + offset;
+            }
+
+            constexpr auto operator-(difference_type offset) const -> Iterator
+                requires random_access<Const>
+            {
+                auto tmp = *this;
+                return tmp -= offset;
+            }
+
+            // Iterators of one view always move in lockstep, so the first range tells for all of them
+            constexpr auto operator-(const Iterator &other) const -> difference_type
+                requires random_access<Const>
+            {
+                return static_cast<difference_type>(std::get<0>(_current) - std::get<0>(other._current));
+            }
+
+            constexpr auto operator==(const Iterator &other) const -> bool {
+                return std::get<0>(_current) == std::get<0>(other._current);
+            }
+
+            constexpr auto operator<=>(const Iterator &other) const
+                requires random_access<Const>
+            {
+                return std::get<0>(_current) <=> std::get<0>(other._current);
+            }
+
+        private:
+            template<bool>
+            friend class Sentinel;
+
+            std::tuple<std::ranges::iterator_t<detail::maybe_const<Const, Views>>...> _current;
+        };
+
+        // End of a view whose ranges can end at different positions: reached once any of them ends
+        template<bool Const>
+        class Sentinel {
+        public:
+            Sentinel() = default;
+
+            constexpr explicit Sentinel(std::tuple<std::ranges::sentinel_t<detail::maybe_const<Const, Views>>...> end)
+                : _end(std::move(end)) {}
+
+            friend constexpr auto operator==(const Iterator<Const> &it, const Sentinel &sentinel) -> bool {
+                return [&]<types::size_t... I>(std::index_sequence<I...>) {
+                    return ((std::get<I>(it._current) == std::get<I>(sentinel._end)) or ...);
+                }(std::index_sequence_for<Views...>());
+            }
+
+        private:
+            std::tuple<std::ranges::sentinel_t<detail::maybe_const<Const, Views>>...> _end;
+        };
+
+        ZipView() = default;
+
+        constexpr explicit ZipView(Views... views) : _views(std::move(views)...) {}
+
+        constexpr auto begin() {
+            return begin_of<false>(*this);
+        }
+
+        constexpr auto begin() const
+            requires(std::ranges::forward_range<const Views> and ...)
+        {
+            return begin_of<true>(*this);
+        }
+
+        constexpr auto end() {
+            return end_of<false>(*this);
+        }
+
+        constexpr auto end() const
+            requires(std::ranges::forward_range<const Views> and ...)
+        {
+            return end_of<true>(*this);
+        }
+
+        constexpr auto size()
+            requires sized<false>
+        {
+            return size_of(*this);
+        }
+
+        constexpr auto size() const
+            requires sized<true>
+        {
+            return size_of(*this);
+        }
+
+    private:
+        std::tuple<Views...> _views;
+
+        template<bool Const, typename Self>
+        static constexpr auto begin_of(Self &self) {
+            return Iterator<Const>(std::apply([](auto &...views) { return std::tuple(std::ranges::begin(views)...); }, self._views));
+        }
+
+        // Views of sized random access ranges are common, which std algorithms expecting a common range need
+        template<bool Const, typename Self>
+        static constexpr auto end_of(Self &self) {
+            if constexpr (random_access<Const> and sized<Const>) {
+                return begin_of<Const>(self) + static_cast<typename Iterator<Const>::difference_type>(size_of(self));
+            } else {
+                return Sentinel<Const>(std::apply([](auto &...views) { return std::tuple(std::ranges::end(views)...); }, self._views));
+            }
+        }
+
+        template<typename Self>
+        static constexpr auto size_of(Self &self) -> types::size_t {
+            return std::apply([](auto &...views) { return std::min({static_cast<types::size_t>(std::ranges::size(views))...}); }, self._views);
+        }
+    };
+
+    template<typename... Ranges>
+    ZipView(Ranges &&...) -> ZipView<std::views::all_t<Ranges>...>;
+
+    // Tuples of the position of every element and the element itself
+    template<std::ranges::view View>
+        requires std::ranges::forward_range<View>
+    class EnumerateView : public std::ranges::view_interface<EnumerateView<View>> {
+    public:
+        template<bool Const>
+        class Iterator {
+            using Base = detail::maybe_const<Const, View>;
+
+        public:
+            using iterator_concept = detail::iterator_concept_t<Base>;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = std::tuple<types::size_t, std::ranges::range_value_t<Base>>;
+            using difference_type = std::ranges::range_difference_t<Base>;
+
+            Iterator() = default;
+
+            constexpr Iterator(std::ranges::iterator_t<Base> current, types::size_t index) : _current(std::move(current)), _index(index) {}
+
+            constexpr auto base() const -> const std::ranges::iterator_t<Base> & {
+                return _current;
+            }
+
+            constexpr auto operator*() const {
+                return detail::ReferenceTuple<types::size_t, std::ranges::range_reference_t<Base>>(_index, *_current);
+            }
+
+            constexpr auto operator[](difference_type offset) const
+                requires std::ranges::random_access_range<Base>
+            {
+                return *(*this + offset);
+            }
+
+            constexpr auto operator++() -> Iterator & {
+                ++_current;
+                _index++;
+                return *this;
+            }
+
+            constexpr auto operator++(int) -> Iterator {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            constexpr auto operator--() -> Iterator &
+                requires std::ranges::bidirectional_range<Base>
+            {
+                --_current;
+                _index--;
+                return *this;
+            }
+
+            constexpr auto operator--(int) -> Iterator
+                requires std::ranges::bidirectional_range<Base>
+            {
+                auto tmp = *this;
+                --*this;
+                return tmp;
+            }
+
+            constexpr auto operator+=(difference_type offset) -> Iterator &
+                requires std::ranges::random_access_range<Base>
+            {
+                _current += offset;
+                _index += static_cast<types::size_t>(offset);
+                return *this;
+            }
+
+            constexpr auto operator-=(difference_type offset) -> Iterator &
+                requires std::ranges::random_access_range<Base>
+            {
+                return *this += -offset;
+            }
+
+            constexpr auto operator+(difference_type offset) const -> Iterator
+                requires std::ranges::random_access_range<Base>
+            {
+                auto tmp = *this;
+                return tmp += offset;
+            }
+
+            friend constexpr auto operator+(difference_type offset, const Iterator &it) -> Iterator
+                requires std::ranges::random_access_range<Base>
+            {
+                return it + offset;
+            }
+
+            constexpr auto operator-(difference_type offset) const -> Iterator
+                requires std::ranges::random_access_range<Base>
+            {
+                auto tmp = *this;
+                return tmp -= offset;
+            }
+
+            constexpr auto operator-(const Iterator &other) const -> difference_type
+                requires std::ranges::random_access_range<Base>
+            {
+                return _current - other._current;
+            }
+
+            constexpr auto operator==(const Iterator &other) const -> bool {
+                return _current == other._current;
+            }
+
+            constexpr auto operator<=>(const Iterator &other) const
+                requires std::ranges::random_access_range<Base>
+            {
+                return _current <=> other._current;
+            }
+
+        private:
+            std::ranges::iterator_t<Base> _current{};
+            types::size_t _index = 0;
+        };
+
+        template<bool Const>
+        class Sentinel {
+        public:
+            Sentinel() = default;
+
+            constexpr explicit Sentinel(std::ranges::sentinel_t<detail::maybe_const<Const, View>> end) : _end(std::move(end)) {}
+
+            friend constexpr auto operator==(const Iterator<Const> &it, const Sentinel &sentinel) -> bool {
+                return it.base() == sentinel._end;
+            }
+
+        private:
+            std::ranges::sentinel_t<detail::maybe_const<Const, View>> _end{};
+        };
+
+        EnumerateView() = default;
+
+        constexpr explicit EnumerateView(View base) : _base(std::move(base)) {}
+
+        constexpr auto begin() {
+            return Iterator<false>(std::ranges::begin(_base), 0);
+        }
+
+        constexpr auto begin() const
+            requires std::ranges::forward_range<const View>
+        {
+            return Iterator<true>(std::ranges::begin(_base), 0);
+        }
+
+        constexpr auto end() {
+            return end_of<false>(_base);
+        }
+
+        constexpr auto end() const
+            requires std::ranges::forward_range<const View>
+        {
+            return end_of<true>(_base);
+        }
+
+        constexpr auto size()
+            requires std::ranges::sized_range<View>
+        {
+            return std::ranges::size(_base);
+        }
+
+        constexpr auto size() const
+            requires std::ranges::sized_range<const View>
+        {
+            return std::ranges::size(_base);
+        }
+
+    private:
+        View _base;
+
+        template<bool Const, typename Base>
+        static constexpr auto end_of(Base &base) {
+            if constexpr (std::ranges::common_range<Base> and std::ranges::sized_range<Base>) {
+                return Iterator<Const>(std::ranges::end(base), static_cast<types::size_t>(std::ranges::size(base)));
+            } else {
+                return Sentinel<Const>(std::ranges::end(base));
+            }
+        }
+    };
+
+    template<typename Range>
+    EnumerateView(Range &&) -> EnumerateView<std::views::all_t<Range>>;
+
+    // Consecutive subranges of size elements; the last one holds whatever is left
+    template<std::ranges::view View>
+        requires std::ranges::forward_range<View>
+    class ChunkView : public std::ranges::view_interface<ChunkView<View>> {
+    public:
+        template<bool Const>
+        class Iterator {
+            using Base = detail::maybe_const<Const, View>;
+
+        public:
+            using iterator_concept = std::forward_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = std::ranges::subrange<std::ranges::iterator_t<Base>>;
+            using difference_type = std::ranges::range_difference_t<Base>;
+
+            Iterator() = default;
+
+            constexpr Iterator(std::ranges::iterator_t<Base> current, std::ranges::sentinel_t<Base> end, difference_type size)
+                : _current(std::move(current)), _next(std::ranges::next(_current, size, end)), _end(std::move(end)), _size(size) {}
+
+            constexpr auto operator*() const {
+                return value_type(_current, _next);
+            }
+
+            constexpr auto operator++() -> Iterator & {
+                _current = _next;
+                _next = std::ranges::next(_current, _size, _end);
+                return *this;
+            }
+
+            constexpr auto operator++(int) -> Iterator {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            constexpr auto operator==(const Iterator &other) const -> bool {
+                return _current == other._current;
+            }
+
+            friend constexpr auto operator==(const Iterator &it, std::default_sentinel_t) -> bool {
+                return it._current == it._end;
+            }
+
+        private:
+            std::ranges::iterator_t<Base> _current{};
+            std::ranges::iterator_t<Base> _next{};
+            std::ranges::sentinel_t<Base> _end{};
+            difference_type _size = 0;
+        };
+
+        ChunkView() = default;
+
+        // Throws std::invalid_argument if size is 0
+        constexpr ChunkView(View base, types::size_t size) : _base(std::move(base)), _size(size) {
+            if (size == 0) {
+                throw std::invalid_argument("Chunks must hold at least one element");
+            }
+        }
+
+        constexpr auto begin() {
+            return Iterator<false>(std::ranges::begin(_base), std::ranges::end(_base), static_cast<std::ranges::range_difference_t<View>>(_size));
+        }
+
+        constexpr auto begin() const
+            requires std::ranges::forward_range<const View>
+        {
+            return Iterator<true>(std::ranges::begin(_base), std::ranges::end(_base), static_cast<std::ranges::range_difference_t<const View>>(_size));
+        }
+
+        constexpr auto end() const {
+            return std::default_sentinel;
+        }
+
+        constexpr auto size()
+            requires std::ranges::sized_range<View>
+        {
+            return (static_cast<types::size_t>(std::ranges::size(_base)) + _size - 1) / _size;
+        }
+
+        constexpr auto size() const
+            requires std::ranges::sized_range<const View>
+        {
+            return (static_cast<types::size_t>(std::ranges::size(_base)) + _size - 1) / _size;
+        }
+
+    private:
+        View _base;
+        types::size_t _size = 1;
+    };
+
+    template<typename Range>
+    ChunkView(Range &&, types::size_t) -> ChunkView<std::views::all_t<Range>>;
+
+    // Element-wise adaptors that the standard library already has, under the names used here
+    inline constexpr auto map = std::views::transform;
+    inline constexpr auto filter = std::views::filter;
+    inline constexpr auto take = std::views::take;
+    inline constexpr auto drop = std::views::drop;
+
+    template<std::ranges::viewable_range... Ranges>
+    constexpr auto zip(Ranges &&...ranges) {
+        return ZipView(std::views::all(std::forward<Ranges>(ranges))...);
+    }
+
+    inline constexpr detail::Closure enumerate{[](auto &&range) { return EnumerateView(std::views::all(std::forward<decltype(range)>(range))); }};
+
+    constexpr auto chunk(types::size_t size) {
+        return detail::Closure{[size](auto &&range) { return ChunkView(std::views::all(std::forward<decltype(range)>(range)), size); }};
+    }
+
+    // Ends a pipeline by storing its elements in a Container, by default a Vector of them. The
+    // container is reserved once up front when the size of the range is known.
+    template<typename Container = void>
+    constexpr auto collect() {
+        return detail::Closure{[](auto &&range) {
+            using Range = decltype(range);
+            using Result = std::conditional_t<std::is_void_v<Container>, Vector<std::ranges::range_value_t<Range>>, Container>;
+            return detail::collect_into<Result>(std::forward<Range>(range));
+        }};
+    }
+} // namespace ds::views
+
+#endif //DS_VIEWS_HPP
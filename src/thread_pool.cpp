@@ -0,0 +1,132 @@
+//
+// Created by santiago on 06.08.23.
+//
+
+#include "thread_pool.hpp"
+
+namespace ds {
+
+    namespace {
+        // Pool and queue of the worker running on this thread, if any
+        thread_local const ThreadPool *current_pool = nullptr; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+        thread_local ThreadPool::size_type current_queue = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    } // namespace
+
+    ThreadPool::ThreadPool(size_type num_threads) {
+        num_threads = std::max(num_threads, size_type{1});
+        _queues.reserve(num_threads);
+        for (size_type i = 0; i < num_threads; i++) {
+            _queues.push_back(std::make_unique<Queue>());
+        }
+
+        _workers.reserve(num_threads);
+        for (size_type i = 0; i < num_threads; i++) {
+            _workers.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        _stopping.store(true, std::memory_order_relaxed);
+        _pending.fetch_add(1, std::memory_order_release);
+        _pending.notify_all();
+
+        for (auto &worker: _workers) {
+            worker.join();
+        }
+    }
+
+    auto ThreadPool::default_thread_count() -> size_type {
+        return std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    auto ThreadPool::global() -> ThreadPool & {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    auto ThreadPool::run_pending_task() -> bool {
+        const auto first_queue = current_pool == this ? current_queue : _next_queue.load(std::memory_order_relaxed);
+        Task task;
+        if (not try_pop(first_queue, task)) {
+            return false;
+        }
+
+        _pending.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        return true;
+    }
+
+    void ThreadPool::submit(Task task) {
+        const auto index = current_pool == this ? current_queue : _next_queue.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+        {
+            auto &queue = *_queues[index];
+            const std::lock_guard lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+
+        // After the push, so that a worker which saw the old value and no task does not go to sleep
+        _pending.fetch_add(1, std::memory_order_release);
+        _pending.notify_one();
+    }
+
+    auto ThreadPool::try_pop(size_type first_queue, Task &task) -> bool {
+        first_queue %= _queues.size();
+        {
+            auto &own = *_queues[first_queue];
+            const std::lock_guard lock(own.mutex);
+            if (not own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+
+        for (size_type offset = 1; offset < _queues.size(); offset++) {
+            auto &victim = *_queues[(first_queue + offset) % _queues.size()];
+            const std::lock_guard lock(victim.mutex);
+            if (not victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ThreadPool::wait(const ForState &state) {
+        while (state.remaining() > 0) {
+            // Read before looking for work, so that a task submitted or the last chunk finishing
+            // afterwards changes it
+            const auto pending = _pending.load(std::memory_order_acquire);
+            if (run_pending_task()) {
+                continue;
+            }
+
+            // Chunks still running elsewhere may queue nested work, which wakes us up as well
+            if (state.remaining() > 0) {
+                _pending.wait(pending, std::memory_order_acquire);
+            }
+        }
+        state.rethrow_error();
+    }
+
+    void ThreadPool::worker_loop(size_type index) {
+        current_pool = this;
+        current_queue = index;
+
+        while (true) {
+            // Read before looking for work, so that a task submitted afterwards changes it
+            const auto pending = _pending.load(std::memory_order_acquire);
+            if (run_pending_task()) {
+                continue;
+            }
+
+            if (_stopping.load(std::memory_order_relaxed)) {
+                return;
+            }
+            _pending.wait(pending, std::memory_order_acquire);
+        }
+    }
+
+} // namespace ds
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+#include <aligned_allocator.hpp>
+#include <small_vector.hpp>
+#include <vector.hpp>
+
+namespace {
+    template<typename T>
+    auto is_aligned(const T *ptr, types::size_t alignment) {
+        return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    template<types::size_t Alignment>
+    void check_vector_alignment() {
+        constexpr types::size_t PER_UNIT = Alignment / sizeof(float);
+
+        ds::Vector<float, ds::AlignedAllocator<float, Alignment>> v;
+        v.reserve(3);
+        EXPECT_TRUE(is_aligned(v.data(), Alignment));
+        EXPECT_EQ(v.capacity(), PER_UNIT) << "Capacity should fill whole alignment units";
+
+        for (int i = 0; i < 1000; i++) {
+            v.push_back(static_cast<float>(i));
+            ASSERT_TRUE(is_aligned(v.data(), Alignment)) << "Growth should keep the alignment";
+            ASSERT_EQ(v.capacity() % PER_UNIT, 0);
+        }
+
+        v.erase(v.begin() + 10, v.end());
+        v.shrink_to_fit();
+        EXPECT_TRUE(is_aligned(v.data(), Alignment));
+        EXPECT_EQ(v.capacity(), PER_UNIT);
+        EXPECT_EQ(v.padded_size(), PER_UNIT);
+        for (int i = 0; i < 10; i++) {
+            EXPECT_EQ(v[i], static_cast<float>(i));
+        }
+    }
+} // namespace
+
+TEST(AlignedAllocatorTest, Allocate) {
+    ds::AlignedAllocator<char, ds::PAGE_BYTES> allocator;
+    for (std::size_t n: {1, 100, 5000}) {
+        char *ptr = allocator.allocate(n);
+        EXPECT_TRUE(is_aligned(ptr, ds::PAGE_BYTES));
+        allocator.deallocate(ptr, n);
+    }
+
+    ds::AlignedAllocator<double, ds::HUGE_PAGE_BYTES> huge;
+    double *ptr = huge.allocate(10);
+    EXPECT_TRUE(is_aligned(ptr, ds::HUGE_PAGE_BYTES));
+    huge.deallocate(ptr, 10);
+
+    EXPECT_EQ(ds::AlignedAllocator<int>(ds::AlignedAllocator<double>()), ds::AlignedAllocator<int>());
+}
+
+TEST(AlignedAllocatorTest, VectorKeepsAlignment) {
+    check_vector_alignment<ds::CACHE_LINE_BYTES>();
+    check_vector_alignment<ds::PAGE_BYTES>();
+}
+
+TEST(AlignedAllocatorTest, PaddedSize) {
+    ds::Vector<int, ds::AlignedAllocator<int>> v = {1, 2, 3};
+    EXPECT_EQ(v.padded_size(), ds::CACHE_LINE_BYTES / sizeof(int));
+    EXPECT_GE(v.capacity(), v.padded_size());
+
+    // Writing the whole padded range must stay within the block
+    for (types::size_t i = 0; i < v.padded_size(); i++) {
+        v.data()[i] = 0; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    ds::Vector<int> plain = {1, 2, 3};
+    EXPECT_EQ(plain.padded_size(), plain.size()) << "Plain allocators should expose no padding";
+
+    ds::SmallVector<int, 4, ds::AlignedAllocator<int>> small = {1, 2, 3};
+    EXPECT_EQ(small.padded_size(), 4) << "Inline storage should only expose the inline capacity";
+
+    ds::Vector<std::string, ds::AlignedAllocator<std::string>> strings(3, "x");
+    EXPECT_TRUE(is_aligned(strings.data(), ds::CACHE_LINE_BYTES));
+    EXPECT_EQ(strings.padded_size(), 2 * ds::CACHE_LINE_BYTES / sizeof(std::string));
+}
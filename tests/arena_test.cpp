@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+#include <arena.hpp>
+#include <vector.hpp>
+
+TEST(ArenaTest, BumpAllocation) {
+    ds::Arena arena(4096);
+    auto *first = static_cast<std::byte *>(arena.allocate(10, 1));
+    auto *second = static_cast<std::byte *>(arena.allocate(10, 1));
+    EXPECT_EQ(second, first + 10) << "Allocations should be consecutive";
+
+    auto *aligned = arena.allocate(8, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 64, 0);
+
+    EXPECT_GE(arena.stats().bytes_used, 28);
+    EXPECT_GE(arena.stats().bytes_reserved, 4096);
+    EXPECT_EQ(arena.stats().high_water_mark, arena.stats().bytes_used);
+}
+
+TEST(ArenaTest, LastAllocationGrowsInPlace) {
+    ds::Arena arena(4096);
+    auto *block = arena.allocate(100, 1);
+    EXPECT_TRUE(arena.try_extend(block, 100, 200));
+    EXPECT_EQ(arena.stats().bytes_used, 200);
+
+    auto *other = arena.allocate(10, 1);
+    EXPECT_FALSE(arena.try_extend(block, 200, 300)) << "Only the most recent allocation can grow";
+    EXPECT_TRUE(arena.try_extend(block, 200, 100)) << "Shrinking never needs to move";
+    EXPECT_FALSE(arena.try_extend(other, 10, 1 << 20)) << "Growing past the end of the block needs a move";
+
+    arena.deallocate(other, 10);
+    EXPECT_EQ(arena.stats().bytes_used, 200);
+}
+
+TEST(ArenaTest, DeallocateReclaimsPadding) {
+    ds::Arena arena(4096);
+    auto *first = arena.allocate(1, 1);
+    for (int i = 0; i < 100; i++) {
+        auto *aligned = arena.allocate(8, 64);
+        EXPECT_GT(arena.stats().bytes_used, 9) << "Padding counts as used";
+        arena.deallocate(aligned, 8);
+        ASSERT_EQ(arena.stats().bytes_used, 1) << "Padding should be given back along with the allocation";
+    }
+
+    auto *next = static_cast<std::byte *>(arena.allocate(1, 1));
+    EXPECT_EQ(next, static_cast<std::byte *>(first) + 1) << "The cursor should rewind to before the padding";
+    EXPECT_EQ(arena.stats().bytes_reserved, 4096);
+}
+
+TEST(ArenaTest, ReleaseKeepsHighWaterMark) {
+    ds::Arena arena(4096);
+    for (int i = 0; i < 100; i++) {
+        (void) arena.allocate(1000, 8);
+    }
+    const auto peak = arena.stats().bytes_used;
+    EXPECT_GE(peak, 100000);
+
+    arena.release();
+    EXPECT_EQ(arena.stats().bytes_used, 0);
+    EXPECT_EQ(arena.stats().high_water_mark, peak);
+    EXPECT_GT(arena.stats().bytes_reserved, 0) << "The newest block should be kept for reuse";
+
+    arena.reset_high_water_mark();
+    EXPECT_EQ(arena.stats().high_water_mark, 0);
+}
+
+TEST(ArenaTest, VectorGrowsInPlace) {
+    constexpr int NUM_PUSHS = 1000;
+
+    ds::Arena arena;
+    ds::Vector<std::string, ds::ArenaAllocator<std::string>> v{ds::ArenaAllocator<std::string>(arena)};
+    v.push_back("first");
+    const auto *first = v.data();
+    for (int i = 1; i < NUM_PUSHS; i++) {
+        v.push_back(std::to_string(i));
+    }
+
+    EXPECT_EQ(v.data(), first) << "The only allocation of the arena should grow without moving";
+    EXPECT_EQ(v[0], "first");
+    EXPECT_EQ(v[NUM_PUSHS - 1], std::to_string(NUM_PUSHS - 1));
+    EXPECT_EQ(arena.stats().bytes_used, v.capacity() * sizeof(std::string));
+
+    ds::Vector<int, ds::ArenaAllocator<int>> other{ds::ArenaAllocator<int>(arena)};
+    other.assign(10, 1);
+    while (v.size() < v.capacity()) {
+        v.push_back("filler");
+    }
+    v.push_back("moved");
+    EXPECT_NE(v.data(), first) << "Growing an allocation that is no longer the last one moves it";
+    EXPECT_EQ(v[0], "first");
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include <bit_vector.hpp>
+
+namespace {
+    auto random_bits(types::size_t size, unsigned one_in, unsigned seed) {
+        std::mt19937 generator(seed);
+        ds::BitVector bits;
+        for (types::size_t i = 0; i < size; i++) {
+            bits.push_back(generator() % one_in == 0);
+        }
+        return bits;
+    }
+} // namespace
+
+TEST(BitVectorTest, StoresOneBitPerElement) {
+    ds::BitVector bits(1000);
+    EXPECT_EQ(bits.size(), 1000);
+    EXPECT_EQ(bits.words().size(), 16);
+    EXPECT_TRUE(bits.none());
+
+    bits[3] = true;
+    bits.set(64);
+    bits[999] = bits[3];
+    EXPECT_TRUE(bits[3]);
+    EXPECT_TRUE(bits.test(64));
+    EXPECT_TRUE(bits[999]);
+    EXPECT_FALSE(bits[4]);
+    EXPECT_EQ(bits.count(), 3);
+    EXPECT_THROW(static_cast<void>(bits.test(1000)), std::out_of_range);
+
+    bits.reset(3);
+    bits.flip(4);
+    bits[64].flip();
+    EXPECT_FALSE(bits[3]);
+    EXPECT_TRUE(bits[4]);
+    EXPECT_FALSE(bits[64]);
+}
+
+TEST(BitVectorTest, PushPopAndResize) {
+    ds::BitVector bits{true, false, true};
+    for (int i = 0; i < 130; i++) {
+        bits.push_back(i % 2 == 0);
+    }
+    EXPECT_EQ(bits.size(), 133);
+    EXPECT_EQ(bits.count(), 67);
+
+    while (bits.size() > 64) {
+        bits.pop_back();
+    }
+    EXPECT_EQ(bits.words().size(), 1);
+    EXPECT_EQ(bits.count(), 33);
+
+    bits.resize(70, true);
+    EXPECT_EQ(bits.count(), 39);
+    EXPECT_TRUE(bits[69]);
+    bits.resize(10);
+    bits.resize(20);
+    EXPECT_EQ(bits.count(), 6) << "Growing again should not bring back bits past the old size";
+}
+
+TEST(BitVectorTest, WholeVectorOperationsKeepTheTailClear) {
+    ds::BitVector bits(70);
+    bits.set();
+    EXPECT_TRUE(bits.all());
+    EXPECT_EQ(bits.count(), 70);
+
+    bits.flip();
+    EXPECT_TRUE(bits.none());
+    EXPECT_EQ((~bits).count(), 70);
+    EXPECT_EQ(bits.words()[1], 0);
+}
+
+TEST(BitVectorTest, BitwiseOperators) {
+    const auto lhs = random_bits(1000, 2, 1);
+    const auto rhs = random_bits(1000, 3, 2);
+
+    const auto both = lhs & rhs;
+    const auto either = lhs | rhs;
+    const auto one = lhs ^ rhs;
+    for (types::size_t i = 0; i < lhs.size(); i++) {
+        EXPECT_EQ(both[i], lhs[i] and rhs[i]);
+        EXPECT_EQ(either[i], lhs[i] or rhs[i]);
+        EXPECT_EQ(one[i], lhs[i] != rhs[i]);
+    }
+    EXPECT_EQ(both.count() + either.count(), lhs.count() + rhs.count());
+    EXPECT_EQ((one ^ rhs), lhs);
+
+    EXPECT_THROW(ds::BitVector(10) &= ds::BitVector(11), std::invalid_argument);
+}
+
+TEST(BitVectorTest, FindSetBits) {
+    const auto bits = random_bits(3000, 50, 3);
+    std::vector<types::size_t> expected;
+    for (types::size_t i = 0; i < bits.size(); i++) {
+        if (bits[i]) {
+            expected.push_back(i);
+        }
+    }
+
+    std::vector<types::size_t> found;
+    for (auto pos = bits.find_first(); pos != bits.size(); pos = bits.find_next(pos)) {
+        found.push_back(pos);
+    }
+    EXPECT_EQ(found, expected);
+    EXPECT_EQ(ds::BitVector(100).find_first(), 100);
+}
+
+TEST(RankSelectTest, MatchesNaiveRankAndSelect) {
+    // Dense, sparse and all-ones vectors, with sizes that end inside a word and inside a block
+    for (const auto one_in: {1U, 2U, 7U, 1000U}) {
+        for (const types::size_t size: {0ULL, 1ULL, 511ULL, 512ULL, 20000ULL, 100001ULL}) {
+            const auto bits = random_bits(size, one_in, one_in);
+            const ds::RankSelect rank_select(bits);
+
+            types::size_t ones = 0;
+            for (types::size_t pos = 0; pos < size; pos++) {
+                ASSERT_EQ(rank_select.rank(pos), ones) << "size = " << size << ", pos = " << pos;
+                if (bits[pos]) {
+                    ASSERT_EQ(rank_select.select(ones), pos) << "size = " << size << ", rank = " << ones;
+                    ones++;
+                }
+            }
+            EXPECT_EQ(rank_select.rank(size), ones);
+            EXPECT_EQ(rank_select.rank0(size), size - ones);
+            EXPECT_EQ(rank_select.ones(), ones);
+            EXPECT_THROW(static_cast<void>(rank_select.select(ones)), std::out_of_range);
+        }
+    }
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <concurrent_vector.hpp>
+
+TEST(ConcurrentVectorTest, PushAndRead) {
+    constexpr int NUM_PUSHS = 1000;
+
+    ds::ConcurrentVector<std::string, 4> v;
+    EXPECT_TRUE(v.empty());
+    for (int i = 0; i < NUM_PUSHS; i++) {
+        EXPECT_EQ(v.push_back(std::to_string(i)), i) << "push_back should return the element index";
+    }
+
+    EXPECT_EQ(v.size(), NUM_PUSHS);
+    EXPECT_GE(v.capacity(), NUM_PUSHS);
+    for (int i = 0; i < NUM_PUSHS; i++) {
+        EXPECT_EQ(v[i], std::to_string(i));
+    }
+    EXPECT_EQ(v.try_get(NUM_PUSHS), nullptr);
+    EXPECT_THROW(v.at(NUM_PUSHS), std::out_of_range);
+
+    v.clear();
+    EXPECT_TRUE(v.empty());
+    EXPECT_GE(v.capacity(), NUM_PUSHS) << "clear should keep the segments";
+}
+
+TEST(ConcurrentVectorTest, ReferencesAreStable) {
+    constexpr int NUM_PUSHS = 10000;
+
+    ds::ConcurrentVector<int> v;
+    v.push_back(42);
+    const int *first = &v[0];
+    for (int i = 1; i < NUM_PUSHS; i++) {
+        v.push_back(i);
+    }
+    EXPECT_EQ(first, &v[0]) << "Growing should never move elements";
+    EXPECT_EQ(*first, 42);
+
+    ds::ConcurrentVector<int> reserved;
+    reserved.reserve(NUM_PUSHS);
+    EXPECT_GE(reserved.capacity(), NUM_PUSHS);
+    EXPECT_TRUE(reserved.empty());
+}
+
+TEST(ConcurrentVectorTest, ThrowingConstructorLeavesHole) {
+    struct Checked {
+        explicit Checked(int value) : value(value) {
+            if (value < 0) {
+                throw std::invalid_argument("negative");
+            }
+        }
+
+        int value;
+    };
+
+    ds::ConcurrentVector<Checked> v;
+    v.emplace_back(1);
+    EXPECT_THROW(v.emplace_back(-1), std::invalid_argument);
+    v.emplace_back(3);
+
+    EXPECT_EQ(v.size(), 3) << "The slot claimed by the failed emplace stays counted";
+    EXPECT_EQ(v.try_get(1), nullptr);
+    EXPECT_THROW(v.at(1), std::out_of_range);
+    EXPECT_EQ(v[2].value, 3);
+
+    const auto &const_v = v;
+    static_assert(std::is_same_v<decltype(const_v.try_get(0)), const Checked *>, "A const vector hands out const elements");
+    EXPECT_EQ(const_v.try_get(0)->value, 1);
+    EXPECT_EQ(const_v.at(2).value, 3);
+}
+
+TEST(ConcurrentVectorTest, ConcurrentPushes) {
+    constexpr int NUM_THREADS = 8;
+    constexpr int PUSHS_PER_THREAD = 20000;
+
+    ds::ConcurrentVector<int> v;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; t++) {
+        threads.emplace_back([&v, t] {
+            for (int i = 0; i < PUSHS_PER_THREAD; i++) {
+                const auto index = v.push_back(t * PUSHS_PER_THREAD + i);
+                ASSERT_NE(v.try_get(index), nullptr) << "Own elements should be readable right away";
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(v.size(), NUM_THREADS * PUSHS_PER_THREAD);
+    std::vector<int> values;
+    for (ds::ConcurrentVector<int>::size_type i = 0; i < v.size(); i++) {
+        values.push_back(v[i]);
+    }
+    std::sort(values.begin(), values.end());
+    for (int i = 0; i < NUM_THREADS * PUSHS_PER_THREAD; i++) {
+        ASSERT_EQ(values[i], i) << "Every pushed value should be stored exactly once";
+    }
+}
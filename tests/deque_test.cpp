@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <ranges>
+#include <string>
+#include <type_traits>
+
+#include <deque.hpp>
+
+namespace {
+    // Small blocks, so that tests cross block boundaries often
+    using SmallBlockDeque = ds::Deque<std::string, std::allocator<std::string>, 4>;
+
+    // Counts live instances and throws on the copy that would exceed a limit
+    struct LimitedCopies {
+        static inline int live = 0;
+        static inline int limit = 0;
+
+        LimitedCopies() {
+            live++;
+        }
+
+        LimitedCopies(const LimitedCopies & /*other*/) {
+            if (live == limit) {
+                throw std::runtime_error("copy limit reached");
+            }
+            live++;
+        }
+
+        LimitedCopies(LimitedCopies &&) = delete;
+
+        ~LimitedCopies() {
+            live--;
+        }
+
+        auto operator=(const LimitedCopies &) -> LimitedCopies & = default;
+
+        auto operator=(LimitedCopies &&) -> LimitedCopies & = delete;
+    };
+} // namespace
+
+TEST(DequeTest, IsRandomAccessRange) {
+    static_assert(std::random_access_iterator<ds::Deque<int>::iterator>);
+    static_assert(std::random_access_iterator<ds::Deque<int>::const_iterator>);
+    static_assert(std::ranges::random_access_range<ds::Deque<int>>);
+    static_assert(std::is_convertible_v<ds::Deque<int>::iterator, ds::Deque<int>::const_iterator>);
+    static_assert(not std::is_convertible_v<ds::Deque<int>::const_iterator, ds::Deque<int>::iterator>);
+}
+
+TEST(DequeTest, PushAndPopBothEnds) {
+    SmallBlockDeque d;
+    std::deque<std::string> expected;
+    std::mt19937 generator(7); // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    for (int i = 0; i < 10000; i++) {
+        const auto value = std::to_string(i);
+        switch (generator() % 4) {
+            case 0:
+                d.push_back(value);
+                expected.push_back(value);
+                break;
+            case 1:
+                d.push_front(value);
+                expected.push_front(value);
+                break;
+            case 2:
+                if (not expected.empty()) {
+                    EXPECT_EQ(d.back(), expected.back());
+                    d.pop_back();
+                    expected.pop_back();
+                }
+                break;
+            default:
+                if (not expected.empty()) {
+                    EXPECT_EQ(d.front(), expected.front());
+                    d.pop_front();
+                    expected.pop_front();
+                }
+                break;
+        }
+        ASSERT_EQ(d.size(), expected.size());
+    }
+
+    EXPECT_TRUE(std::equal(d.cbegin(), d.cend(), expected.cbegin(), expected.cend()));
+    for (ds::Deque<int>::size_type i = 0; i < d.size(); i++) {
+        ASSERT_EQ(d[i], expected[i]);
+    }
+    EXPECT_THROW(d.at(d.size()), std::out_of_range);
+}
+
+TEST(DequeTest, ReferencesAndIteratorsAreStable) {
+    SmallBlockDeque d{"a", "b", "c"};
+    auto &b = d[1];
+    const auto it = d.begin() + 1;
+
+    for (int i = 0; i < 100; i++) {
+        d.push_front(std::to_string(i));
+        d.push_back(std::to_string(i));
+    }
+    d.pop_front();
+    d.pop_back();
+
+    EXPECT_EQ(&b, &*it) << "Growing at either end should never move elements";
+    EXPECT_EQ(*it, "b");
+    EXPECT_EQ(it - d.begin(), 100);
+}
+
+TEST(DequeTest, SlidingWindowReusesBlocks) {
+    constexpr int WINDOW = 1000;
+
+    ds::Deque<long long> window;
+    for (long long i = 0; i < WINDOW; i++) {
+        window.push_back(i);
+    }
+    const auto segments = window.segment_count();
+    for (long long i = WINDOW; i < 100 * WINDOW; i++) {
+        window.pop_front();
+        window.push_back(i);
+    }
+
+    EXPECT_EQ(window.size(), WINDOW);
+    EXPECT_LE(window.segment_count(), segments + 1);
+    EXPECT_EQ(window.front(), 99 * WINDOW);
+    EXPECT_EQ(window.back(), 100 * WINDOW - 1);
+}
+
+TEST(DequeTest, Segments) {
+    ds::Deque<int, std::allocator<int>, 16> d;
+    for (int i = 0; i < 40; i++) {
+        d.push_back(i);
+    }
+    for (int i = 1; i <= 5; i++) {
+        d.push_front(-i);
+    }
+
+    ASSERT_EQ(d.segment_count(), 4);
+    EXPECT_EQ(d.segment(0).size(), 5);
+    EXPECT_EQ(d.segment(3).size(), 8);
+
+    int expected = -5;
+    for (ds::Deque<int>::size_type s = 0; s < d.segment_count(); s++) {
+        for (const auto value: d.segment(s)) {
+            ASSERT_EQ(value, expected++);
+        }
+    }
+    EXPECT_EQ(expected, 40);
+
+    // Segments are contiguous ranges, so whole blocks can be handed to pointer-based code
+    auto first = d.segment(1);
+    static_assert(std::ranges::contiguous_range<decltype(first)>);
+    static_assert(std::is_same_v<decltype(first.begin()), ds::Deque<int, std::allocator<int>, 16>::segment_iterator>);
+    EXPECT_EQ(std::to_address(first.end()), std::to_address(first.begin()) + 16);
+    std::fill(first.begin(), first.end(), 7);
+    EXPECT_EQ(d[5], 7);
+    EXPECT_EQ(d[20], 7);
+    EXPECT_EQ(d[21], 16);
+
+    const auto &constant = d;
+    static_assert(std::is_same_v<std::ranges::range_reference_t<decltype(constant.segment(0))>, const int &>);
+}
+
+TEST(DequeTest, ThrowingConstructionFreesElements) {
+    const LimitedCopies value;
+    LimitedCopies::limit = 10;
+    EXPECT_THROW((ds::Deque<LimitedCopies, std::allocator<LimitedCopies>, 4>(20, value)), std::runtime_error);
+    EXPECT_EQ(LimitedCopies::live, 1) << "Elements built before the throw should be destroyed";
+
+    LimitedCopies::limit = 100;
+    const ds::Deque<LimitedCopies, std::allocator<LimitedCopies>, 4> d(20, value);
+    EXPECT_EQ(LimitedCopies::live, 21);
+    LimitedCopies::limit = 30;
+    EXPECT_THROW(auto copy = d, std::runtime_error);
+    EXPECT_EQ(LimitedCopies::live, 21);
+}
+
+TEST(DequeTest, SortAndCopy) {
+    ds::Deque<int, std::allocator<int>, 16> d;
+    for (int i = 0; i < 1000; i++) {
+        d.push_front(i % 97);
+    }
+    std::sort(d.begin(), d.end());
+    EXPECT_TRUE(std::is_sorted(d.cbegin(), d.cend()));
+
+    auto copy = d;
+    EXPECT_EQ(copy, d);
+    copy.push_back(-1);
+    EXPECT_FALSE(copy == d);
+
+    auto moved = std::move(copy);
+    EXPECT_EQ(moved.size(), 1001);
+    EXPECT_TRUE(copy.empty()); // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    copy.push_front(3);
+    EXPECT_EQ(copy.front(), 3);
+
+    copy = moved;
+    EXPECT_EQ(copy, moved);
+    d = std::move(moved);
+    EXPECT_EQ(d.back(), -1);
+
+    d.clear();
+    d.shrink_to_fit();
+    EXPECT_TRUE(d.empty());
+    EXPECT_EQ(d.segment_count(), 0);
+}
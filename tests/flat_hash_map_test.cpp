@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <flat_hash_map.hpp>
+
+namespace {
+    // Sends every key to the same home slot, so that every element ends up in one long cluster
+    struct CollidingHash {
+        auto operator()(int) const -> std::size_t {
+            return 0;
+        }
+    };
+} // namespace
+
+TEST(FlatHashMapTest, InsertFindErase) {
+    ds::FlatHashMap<int, std::string> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(1), map.end());
+
+    EXPECT_TRUE(map.insert({1, "one"}).second);
+    EXPECT_FALSE(map.insert({1, "uno"}).second) << "Inserting an existing key should keep the old value";
+    EXPECT_TRUE(map.try_emplace(2, 3, 'x').second);
+    map[3] = "three";
+    EXPECT_FALSE(map.insert_or_assign(3, "drei").second);
+
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map.at(1), "one");
+    EXPECT_EQ(map.at(2), "xxx");
+    EXPECT_EQ(map[3], "drei");
+    EXPECT_THROW(map.at(4), std::out_of_range);
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_EQ(map.count(4), 0);
+
+    EXPECT_EQ(map.erase(2), 1);
+    EXPECT_EQ(map.erase(2), 0);
+    EXPECT_FALSE(map.contains(2));
+    EXPECT_EQ(map.size(), 2);
+}
+
+TEST(FlatHashMapTest, MatchesUnorderedMap) {
+    ds::FlatHashMap<int, int> map;
+    std::unordered_map<int, int> expected;
+    std::mt19937 generator(3); // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    for (int i = 0; i < 200000; i++) {
+        const auto key = static_cast<int>(generator() % 5000);
+        if (generator() % 3 == 0) {
+            EXPECT_EQ(map.erase(key), expected.erase(key));
+        } else {
+            map[key] += i;
+            expected[key] += i;
+        }
+    }
+
+    ASSERT_EQ(map.size(), expected.size());
+    EXPECT_LE(map.load_factor(), 0.875F);
+    for (const auto &[key, value]: expected) {
+        ASSERT_EQ(map.at(key), value);
+    }
+    ds::FlatHashMap<int, int>::size_type visited = 0;
+    for (const auto &[key, value]: map) {
+        ASSERT_EQ(expected.at(key), value);
+        visited++;
+    }
+    EXPECT_EQ(visited, expected.size());
+}
+
+TEST(FlatHashMapTest, ErasingShiftsClustersBack) {
+    ds::FlatHashMap<int, int, CollidingHash> map;
+    for (int i = 0; i < 10; i++) {
+        map[i] = i;
+    }
+    for (int i = 0; i < 10; i += 2) {
+        map.erase(i);
+    }
+
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(map.contains(i), i % 2 == 1) << "Keys behind an erased one should still be found";
+    }
+    EXPECT_EQ(map.size(), 5);
+}
+
+TEST(FlatHashMapTest, EraseIf) {
+    ds::FlatHashMap<int, int> map;
+    for (int i = 0; i < 10000; i++) {
+        map[i] = i;
+    }
+
+    int checks = 0;
+    const auto erased = erase_if(map, [&checks](const auto &entry) {
+        checks++;
+        return entry.first % 3 == 0;
+    });
+    EXPECT_EQ(erased, 3334);
+    EXPECT_EQ(checks, 10000) << "Every element should be checked exactly once";
+    EXPECT_EQ(map.size(), 6666);
+    for (int i = 0; i < 10000; i++) {
+        ASSERT_EQ(map.contains(i), i % 3 != 0);
+    }
+}
+
+TEST(FlatHashMapTest, HeterogeneousLookup) {
+    ds::FlatHashMap<std::string, int, ds::StringHash, std::equal_to<>> map;
+    map["apple"] = 1;
+    map[std::string("banana")] = 2;
+
+    constexpr std::string_view key = "banana";
+    EXPECT_EQ(map.at(key), 2);
+    EXPECT_TRUE(map.contains("apple"));
+    EXPECT_EQ(map.find("cherry"), map.end());
+    EXPECT_EQ(map.erase(std::string_view("apple")), 1);
+}
+
+TEST(FlatHashMapTest, ReserveCopyAndMove) {
+    ds::FlatHashMap<int, std::string> map;
+    map.reserve(1000);
+    const auto capacity = map.capacity();
+    EXPECT_GE(capacity * 7 / 8, 1000);
+    for (int i = 0; i < 1000; i++) {
+        map[i] = std::to_string(i);
+    }
+    EXPECT_EQ(map.capacity(), capacity) << "Reserved maps should not rehash";
+
+    auto copy = map;
+    EXPECT_EQ(copy, map);
+    copy[5] = "five";
+    EXPECT_FALSE(copy == map);
+
+    auto moved = std::move(copy);
+    EXPECT_TRUE(copy.empty()); // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+    EXPECT_EQ(moved.at(5), "five");
+
+    copy = moved;
+    EXPECT_EQ(copy, moved);
+    map = std::move(moved);
+    EXPECT_EQ(map.at(5), "five");
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <flat_map.hpp>
+
+template<typename Map>
+class FlatMapTest : public testing::Test {};
+
+using FlatMapTypes = testing::Types<ds::FlatMap<int, std::string>,
+                                    ds::FlatMap<int, std::string, std::less<int>, ds::SearchLayout::eytzinger>>;
+TYPED_TEST_SUITE(FlatMapTest, FlatMapTypes);
+
+TYPED_TEST(FlatMapTest, InsertFindErase) {
+    TypeParam map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(1), map.end());
+
+    EXPECT_TRUE(map.insert({5, "five"}).second);
+    EXPECT_FALSE(map.insert({5, "fuenf"}).second) << "Inserting an existing key should keep the old value";
+    EXPECT_TRUE(map.try_emplace(2, 3, 'x').second);
+    map[9] = "nine";
+    EXPECT_FALSE(map.insert_or_assign(9, "neun").second);
+
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map.at(5), "five");
+    EXPECT_EQ(map.at(2), "xxx");
+    EXPECT_EQ(map[9], "neun");
+    EXPECT_THROW(map.at(4), std::out_of_range);
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_EQ(map.count(4), 0);
+    EXPECT_EQ(map.find(5)->second, "five");
+    EXPECT_EQ(map.lower_bound(3)->first, 5);
+    EXPECT_EQ(map.lower_bound(10), map.end());
+    map.find(5)->second = "FIVE";
+    EXPECT_EQ(map.at(5), "FIVE") << "operator-> should give access to the stored value";
+    EXPECT_EQ(std::as_const(map).find(9)->second, "neun");
+
+    EXPECT_EQ(map.erase(2), 1);
+    EXPECT_EQ(map.erase(2), 0);
+    EXPECT_FALSE(map.contains(2));
+    EXPECT_EQ(map.size(), 2);
+}
+
+TYPED_TEST(FlatMapTest, KeepsKeysAndValuesSortedInSeparateVectors) {
+    TypeParam map;
+    for (const auto key: {7, 3, 9, 1, 5}) {
+        map[key] = std::to_string(key);
+    }
+
+    EXPECT_TRUE(std::ranges::equal(map.keys(), std::vector{1, 3, 5, 7, 9}));
+    EXPECT_TRUE(std::ranges::equal(map.values(), std::vector<std::string>{"1", "3", "5", "7", "9"}));
+
+    for (auto [key, value]: map) {
+        value += "!";
+    }
+    EXPECT_EQ(map.at(7), "7!");
+
+    map.erase(map.begin() + 1);
+    EXPECT_TRUE(std::ranges::equal(map.keys(), std::vector{1, 5, 7, 9}));
+}
+
+TYPED_TEST(FlatMapTest, BulkConstructionSortsAndKeepsFirstDuplicate) {
+    const TypeParam map{{4, "a"}, {1, "b"}, {4, "c"}, {3, "d"}, {1, "e"}};
+
+    EXPECT_TRUE(std::ranges::equal(map.keys(), std::vector{1, 3, 4}));
+    EXPECT_EQ(map.at(1), "b");
+    EXPECT_EQ(map.at(4), "a");
+
+    EXPECT_THROW(TypeParam(ds::Vector<int>{1, 2}, ds::Vector<std::string>{"one"}), std::invalid_argument);
+}
+
+TYPED_TEST(FlatMapTest, LowerBoundMatchesStdLowerBound) {
+    // Every size up to a few full levels of the Eytzinger tree, probing between and past all keys
+    for (int n = 0; n < 70; n++) {
+        ds::Vector<int> keys;
+        ds::Vector<std::string> values;
+        for (int i = 0; i < n; i++) {
+            keys.push_back(2 * i);
+            values.emplace_back();
+        }
+        const TypeParam map(keys, values);
+
+        for (int probe = -1; probe <= 2 * n; probe++) {
+            const auto expected = std::ranges::lower_bound(keys, probe) - keys.begin();
+            EXPECT_EQ(map.lower_bound(probe) - map.begin(), expected) << "n = " << n << ", probe = " << probe;
+            EXPECT_EQ(map.contains(probe), probe >= 0 and probe % 2 == 0 and probe < 2 * n);
+        }
+    }
+}
+
+TYPED_TEST(FlatMapTest, MatchesStdMap) {
+    TypeParam map;
+    std::map<int, std::string> expected;
+    std::mt19937 generator(5); // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    for (int i = 0; i < 5000; i++) {
+        const auto key = static_cast<int>(generator() % 500);
+        if (generator() % 3 == 0) {
+            EXPECT_EQ(map.erase(key), expected.erase(key));
+        } else {
+            map[key] += "x";
+            expected[key] += "x";
+        }
+    }
+
+    ASSERT_EQ(map.size(), expected.size());
+    auto it = map.begin();
+    for (const auto &[key, value]: expected) {
+        EXPECT_EQ(it->first, key);
+        EXPECT_EQ(it->second, value);
+        ++it;
+    }
+}
+
+TEST(FlatMapTest, HeterogeneousLookup) {
+    const ds::FlatMap<std::string, int, std::less<>> map{{"apple", 1}, {"pear", 2}};
+
+    EXPECT_TRUE(map.contains("pear"));
+    EXPECT_EQ(map.find(std::string_view("apple"))->second, 1);
+    EXPECT_EQ(map.find("plum"), map.end());
+    EXPECT_EQ(map.at(std::string_view("pear")), 2);
+    EXPECT_THROW(map.at("plum"), std::out_of_range);
+}
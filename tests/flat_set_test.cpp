@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <flat_set.hpp>
+
+template<typename Set>
+class FlatSetTest : public testing::Test {};
+
+using FlatSetTypes = testing::Types<ds::FlatSet<int>, ds::FlatSet<int, std::less<int>, ds::SearchLayout::eytzinger>>;
+TYPED_TEST_SUITE(FlatSetTest, FlatSetTypes);
+
+TYPED_TEST(FlatSetTest, InsertFindErase) {
+    TypeParam set;
+    EXPECT_TRUE(set.insert(4).second);
+    EXPECT_TRUE(set.insert(1).second);
+    EXPECT_FALSE(set.insert(4).second);
+    EXPECT_EQ(*set.insert(4).first, 4);
+
+    EXPECT_EQ(set.size(), 2);
+    EXPECT_TRUE(set.contains(1));
+    EXPECT_EQ(set.count(2), 0);
+    EXPECT_EQ(*set.lower_bound(2), 4);
+    EXPECT_EQ(set.find(3), set.end());
+
+    EXPECT_EQ(set.erase(1), 1);
+    EXPECT_EQ(set.erase(1), 0);
+    const auto next = set.erase(set.begin());
+    EXPECT_EQ(next, set.end()) << "Erasing the last key should return end()";
+    EXPECT_TRUE(set.empty());
+}
+
+TYPED_TEST(FlatSetTest, BulkConstructionSortsAndDeduplicates) {
+    const TypeParam set{5, 3, 5, 9, 1, 3};
+    EXPECT_TRUE(std::ranges::equal(set, std::vector{1, 3, 5, 9}));
+    EXPECT_TRUE(std::ranges::equal(set.keys(), std::vector{1, 3, 5, 9}));
+}
+
+TYPED_TEST(FlatSetTest, MatchesStdSet) {
+    std::vector<int> input;
+    std::mt19937 generator(7); // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    for (int i = 0; i < 3000; i++) {
+        input.push_back(static_cast<int>(generator() % 2000));
+    }
+
+    const TypeParam set(input.begin(), input.end());
+    const std::set<int> expected(input.begin(), input.end());
+    EXPECT_TRUE(std::ranges::equal(set, expected));
+    for (int key = -1; key <= 2000; key++) {
+        EXPECT_EQ(set.contains(key), expected.contains(key));
+    }
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <growth_policy.hpp>
+#include <vector.hpp>
+
+TEST(GrowthPolicyTest, Factor) {
+    EXPECT_EQ(ds::DoublingGrowth<>::next_capacity(0, 1, sizeof(int)), 1);
+    EXPECT_EQ(ds::DoublingGrowth<>::next_capacity(1, 2, sizeof(int)), 2);
+    EXPECT_EQ(ds::DoublingGrowth<>::next_capacity(64, 65, sizeof(int)), 128);
+    EXPECT_EQ(ds::DoublingGrowth<>::next_capacity(64, 500, sizeof(int)), 500) << "Required capacity should win";
+
+    EXPECT_EQ(ds::OneAndAHalfGrowth<>::next_capacity(1, 2, sizeof(int)), 2) << "Should always grow by at least 1";
+    EXPECT_EQ(ds::OneAndAHalfGrowth<>::next_capacity(100, 101, sizeof(int)), 150);
+
+    EXPECT_EQ(ds::DoublingGrowth<16>::next_capacity(0, 1, sizeof(int)), 16) << "Should start at the minimum capacity";
+}
+
+TEST(GrowthPolicyTest, SizeClass) {
+    using Policy = ds::SizeClassGrowth<>;
+
+    EXPECT_EQ(Policy::round_to_size_class(1), 16);
+    EXPECT_EQ(Policy::round_to_size_class(17), 20);
+    EXPECT_EQ(Policy::round_to_size_class(100), 112);
+    EXPECT_EQ(Policy::round_to_size_class(1024), 1024);
+    EXPECT_EQ(Policy::round_to_size_class(1025), 1280);
+
+    EXPECT_EQ(Policy::next_capacity(0, 1, sizeof(int)), 4) << "A single int still gets the smallest size class";
+    EXPECT_EQ(Policy::next_capacity(160, 161, sizeof(int)), 320);
+    EXPECT_EQ(Policy::next_capacity(200, 201, sizeof(int)), 448);
+}
+
+TEST(GrowthPolicyTest, Page) {
+    constexpr types::size_t PAGE_SIZE = 4096;
+    using Policy = ds::PageGrowth<PAGE_SIZE>;
+
+    EXPECT_EQ(Policy::next_capacity(100, 101, 1), 150) << "Small blocks should not be rounded";
+    EXPECT_EQ(Policy::next_capacity(4000, 4001, 1), 2 * PAGE_SIZE);
+    EXPECT_EQ(Policy::next_capacity(4000, 4001, sizeof(double)) * sizeof(double) % PAGE_SIZE, 0);
+}
+
+TEST(GrowthPolicyTest, VectorUsesPolicy) {
+    constexpr int NUM_PUSHS = 100;
+    constexpr int MIN_CAPACITY = 32;
+
+    ds::Vector<int, std::allocator<int>, 0, ds::OneAndAHalfGrowth<MIN_CAPACITY>> v;
+    v.push_back(0);
+    EXPECT_EQ(v.capacity(), MIN_CAPACITY) << "First allocation should use the minimum capacity";
+
+    for (int i = 1; i < NUM_PUSHS; i++) {
+        const auto previous_capacity = v.capacity();
+        v.push_back(i);
+        if (previous_capacity != v.capacity()) {
+            EXPECT_EQ(v.capacity(), previous_capacity + previous_capacity / 2) << "Capacity should grow by 1.5x";
+        }
+    }
+
+    for (int i = 0; i < NUM_PUSHS; i++) {
+        EXPECT_EQ(v[i], i);
+    }
+}
@@ -4,4 +4,14 @@
 
 TEST(ContiguousIterator, IsContiguousIterator) {
     static_assert(std::contiguous_iterator<it::ContiguousIterator<int, int &>>);
-}
\ No newline at end of file
+}
+
+TEST(ContiguousIterator, ConvertsToConstIterator) {
+    int values[] = {1, 2, 3};
+
+    it::ContiguousIterator<int, int &> mutable_it(values);
+    it::ContiguousIterator<int, const int &> const_it = mutable_it;
+    EXPECT_EQ(*const_it, values[0]);
+
+    static_assert(not std::is_convertible_v<it::ContiguousIterator<int, const int &>, it::ContiguousIterator<int, int &>>);
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <type_traits>
+
+#include <mapped_vector.hpp>
+
+namespace {
+    class MappedVectorTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            const auto *test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+            path = std::filesystem::temp_directory_path() / (std::string("ds_mapped_vector_") + test_name);
+            std::filesystem::remove(path);
+        }
+
+        void TearDown() override {
+            std::filesystem::remove(path);
+        }
+
+        std::filesystem::path path;
+    };
+
+    struct Point {
+        double x;
+        double y;
+    };
+
+    template<typename Vector>
+    concept writable = requires(Vector &v) {
+        v.push_back(Point{});
+        v.reserve(4);
+        v.clear();
+    };
+
+    // Several pages per element, so that growing the file moves the mapping
+    struct Page {
+        std::array<std::uint64_t, 1024> values;
+    };
+} // namespace
+
+TEST_F(MappedVectorTest, PersistsElements) {
+    constexpr std::uint64_t NUM_PUSHS = 10000;
+
+    {
+        ds::MappedVector<std::uint64_t> v(path);
+        EXPECT_TRUE(v.empty()) << "A new file should hold an empty vector";
+        for (std::uint64_t i = 0; i < NUM_PUSHS; i++) {
+            v.push_back(i);
+        }
+        EXPECT_EQ(v.size(), NUM_PUSHS);
+        v.sync();
+    }
+
+    {
+        const ds::MappedVectorView<std::uint64_t> v(path);
+        ASSERT_EQ(v.size(), NUM_PUSHS) << "Size should survive reopening the file";
+        for (std::uint64_t i = 0; i < NUM_PUSHS; i++) {
+            ASSERT_EQ(v[i], i) << "Value should be " << i;
+        }
+        EXPECT_TRUE(std::is_sorted(v.cbegin(), v.cend()));
+    }
+}
+
+TEST_F(MappedVectorTest, AppendsAfterReopen) {
+    {
+        ds::MappedVector<Point> v(path);
+        v.push_back({1.0, 2.0});
+    }
+
+    {
+        ds::MappedVector<Point> v(path);
+        v.emplace_back(3.0, 4.0);
+        v.shrink_to_fit();
+        EXPECT_EQ(v.capacity(), 2);
+        EXPECT_EQ(std::filesystem::file_size(path), sizeof(ds::MappedVectorHeader) + 2 * sizeof(Point));
+    }
+
+    ds::MappedVectorView<Point> v(path);
+    ASSERT_EQ(v.size(), 2);
+    EXPECT_EQ(v.back().x, 3.0);
+    EXPECT_EQ(v.at(0).y, 2.0);
+    EXPECT_EQ(v[1].y, 4.0) << "Non-const read-only vectors should still be readable";
+    double total = 0;
+    for (const auto &point: v) {
+        total += point.x;
+    }
+    EXPECT_EQ(total, 4.0);
+
+    // The mapping is not writable, so neither is anything handed out by a read-only vector
+    static_assert(std::is_same_v<decltype(v[0]), const Point &>);
+    static_assert(std::is_same_v<decltype(v.data()), const Point *>);
+    static_assert(writable<ds::MappedVector<Point>>);
+    static_assert(not writable<ds::MappedVectorView<Point>>);
+}
+
+TEST_F(MappedVectorTest, PushesOwnElementsAcrossGrowth) {
+    ds::MappedVector<Page> v(path);
+    Page page{};
+    page.values.fill(7);
+    v.push_back(page);
+    for (int i = 0; i < 64; i++) {
+        v.push_back(v[0]);
+        v.emplace_back(v.back());
+    }
+
+    ASSERT_EQ(v.size(), 129);
+    EXPECT_TRUE(std::all_of(v.cbegin(), v.cend(), [](const Page &element) { return element.values.back() == 7; }));
+}
+
+TEST_F(MappedVectorTest, RejectsMismatchedLayout) {
+    {
+        ds::MappedVector<std::uint32_t> v(path);
+        v.push_back(1);
+    }
+
+    EXPECT_THROW(ds::MappedVector<std::uint64_t> v(path), std::runtime_error) << "Element size mismatch should be detected";
+    EXPECT_THROW(ds::MappedVectorView<std::uint32_t> v(path.string() + ".missing"), std::system_error);
+
+    const auto empty = path.string() + ".empty";
+    std::ofstream(empty).close();
+    EXPECT_THROW(ds::MappedVectorView<std::uint32_t> v(empty), std::runtime_error) << "An empty file holds no header";
+    std::filesystem::remove(empty);
+}
+
+TEST_F(MappedVectorTest, RejectsCorruptCapacity) {
+    {
+        ds::MappedVector<std::uint64_t> v(path);
+        v.push_back(1);
+    }
+
+    // Enough elements for their bytes to wrap around to 0
+    const std::uint64_t capacity = std::uint64_t{1} << 61U;
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(offsetof(ds::MappedVectorHeader, capacity));
+    file.write(reinterpret_cast<const char *>(&capacity), sizeof(capacity)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    file.close();
+
+    EXPECT_THROW(ds::MappedVectorView<std::uint64_t> v(path), std::runtime_error);
+}
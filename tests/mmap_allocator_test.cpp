@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <growth_policy.hpp>
+#include <mmap_allocator.hpp>
+#include <vector.hpp>
+
+namespace {
+    constexpr types::size_t MIN_MAPPED_BYTES = 4096;
+
+    template<bool HugePages>
+    using MappedVector = ds::Vector<std::uint64_t, ds::MmapAllocator<std::uint64_t, HugePages, MIN_MAPPED_BYTES>, 0, ds::PageGrowth<>>;
+} // namespace
+
+TEST(MmapAllocatorTest, GrowsAcrossThreshold) {
+    constexpr std::uint64_t NUM_PUSHS = 1 << 20;
+
+    MappedVector<false> v;
+    for (std::uint64_t i = 0; i < NUM_PUSHS; i++) {
+        v.push_back(i);
+    }
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.data()) % MIN_MAPPED_BYTES, 0) << "Large buffers should be page aligned mappings";
+    EXPECT_EQ(v.capacity() * sizeof(std::uint64_t) % MIN_MAPPED_BYTES, 0) << "Large buffers should span whole pages";
+
+    for (std::uint64_t i = 0; i < NUM_PUSHS; i++) {
+        ASSERT_EQ(v[i], i) << "mremap should preserve values";
+    }
+
+    v.erase(v.begin() + 10, v.end());
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 10);
+    for (std::uint64_t i = 0; i < 10; i++) {
+        EXPECT_EQ(v[i], i) << "Moving back below the threshold should preserve values";
+    }
+}
+
+TEST(MmapAllocatorTest, HugePages) {
+    constexpr std::uint64_t SIZE = 1 << 20;
+    constexpr std::uint64_t VALUE = 42;
+
+    MappedVector<true> v(SIZE, VALUE);
+    v.reserve(SIZE * 4);
+    EXPECT_EQ(v.size(), SIZE);
+    for (const auto &val: v) {
+        ASSERT_EQ(val, VALUE);
+    }
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <packed_int_vector.hpp>
+
+namespace {
+    template<typename Packed>
+    auto fill_random(Packed &packed, types::size_t count, unsigned seed) {
+        std::mt19937_64 generator(seed);
+        std::vector<typename Packed::value_type> expected;
+        for (types::size_t i = 0; i < count; i++) {
+            const auto value = static_cast<typename Packed::value_type>(generator() & packed.max_value());
+            packed.push_back(value);
+            expected.push_back(value);
+        }
+        return expected;
+    }
+} // namespace
+
+TEST(PackedIntVectorTest, RandomAccessAtEveryWidth) {
+    for (unsigned width = 1; width <= 32; width++) {
+        ds::PackedIntVector<std::uint32_t> packed(width);
+        const auto expected = fill_random(packed, 1500, width);
+
+        ASSERT_EQ(packed.size(), expected.size());
+        for (types::size_t i = 0; i < expected.size(); i++) {
+            ASSERT_EQ(packed[i], expected[i]) << "width = " << width << ", i = " << i;
+        }
+    }
+}
+
+TEST(PackedIntVectorTest, DecodeMatchesElementAccess) {
+    for (const unsigned width: {1U, 5U, 7U, 13U, 17U, 31U, 32U}) {
+        ds::PackedIntVector<std::uint32_t> packed(width);
+        const auto expected = fill_random(packed, 3000, width);
+
+        const auto all = packed.decode();
+        EXPECT_TRUE(std::ranges::equal(all, expected)) << "width = " << width;
+
+        // Starting inside a block, and asking for more than is left
+        std::vector<std::uint32_t> out(2000);
+        EXPECT_EQ(packed.decode(out, 1234), 1766);
+        EXPECT_TRUE(std::equal(expected.begin() + 1234, expected.end(), out.begin())) << "width = " << width;
+        EXPECT_EQ(packed.decode(out, 3000), 0);
+    }
+}
+
+TEST(PackedIntVectorTest, CompileTimeWidthAndWideTypes) {
+    ds::PackedIntVector<std::uint16_t, 11> narrow;
+    EXPECT_EQ(narrow.width(), 11);
+    const auto narrow_expected = fill_random(narrow, 1100, 1);
+    EXPECT_TRUE(std::ranges::equal(narrow.decode(), narrow_expected));
+
+    ds::PackedIntVector<std::uint64_t> wide(64);
+    const auto wide_expected = fill_random(wide, 600, 2);
+    EXPECT_TRUE(std::ranges::equal(wide.decode(), wide_expected));
+
+    ds::PackedIntVector<std::uint64_t, 33> odd;
+    const auto odd_expected = fill_random(odd, 700, 3);
+    EXPECT_TRUE(std::ranges::equal(odd.decode(), odd_expected));
+}
+
+TEST(PackedIntVectorTest, SetAndPopBack) {
+    ds::PackedIntVector<std::uint32_t> packed(9);
+    auto expected = fill_random(packed, 1030, 4);
+
+    for (types::size_t i = 0; i < expected.size(); i += 7) {
+        expected[i] = static_cast<std::uint32_t>(i % 512);
+        packed.set(i, expected[i]);
+    }
+    EXPECT_TRUE(std::ranges::equal(packed.decode(), expected));
+
+    while (packed.size() > 500) {
+        packed.pop_back();
+        expected.pop_back();
+    }
+    EXPECT_EQ(packed.words().size(), (9 + 1) * 8) << "Blocks left empty should be freed";
+    fill_random(packed, 100, 5);
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), packed.decode().begin()));
+}
+
+TEST(PackedIntVectorTest, RejectsValuesAndWidthsThatDoNotFit) {
+    EXPECT_THROW(ds::PackedIntVector<std::uint32_t>(0), std::invalid_argument);
+    EXPECT_THROW(ds::PackedIntVector<std::uint32_t>(33), std::invalid_argument);
+
+    ds::PackedIntVector<std::uint32_t> packed(5);
+    EXPECT_EQ(packed.max_value(), 31);
+    EXPECT_THROW(packed.push_back(32), std::out_of_range);
+    packed.push_back(31);
+    EXPECT_THROW(packed.set(0, 40), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(packed.at(1)), std::out_of_range);
+    EXPECT_EQ(packed.at(0), 31);
+}
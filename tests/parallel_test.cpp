@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+
+#include <parallel.hpp>
+#include <vector.hpp>
+
+namespace {
+    // Large enough to be split into several chunks
+    constexpr int SIZE = 1 << 18;
+
+    auto pool() -> ds::ThreadPool & {
+        static ds::ThreadPool pool(4);
+        return pool;
+    }
+} // namespace
+
+TEST(ParallelTest, FillResizedForOverwrite) {
+    ds::Vector<int> v;
+    v.resize_for_overwrite(SIZE);
+    EXPECT_EQ(v.size(), SIZE);
+    EXPECT_GE(v.capacity(), SIZE);
+
+    ds::parallel_fill(v, 7, pool());
+    EXPECT_TRUE(std::all_of(v.cbegin(), v.cend(), [](int x) { return x == 7; }));
+
+    ds::Vector<std::string> strings(1000);
+    ds::parallel_fill(strings, std::string("value"), pool());
+    EXPECT_TRUE(std::all_of(strings.cbegin(), strings.cend(), [](const std::string &s) { return s == "value"; }));
+}
+
+TEST(ParallelTest, CopyAndTransform) {
+    ds::Vector<long long> src(SIZE);
+    std::iota(src.begin(), src.end(), 0);
+
+    ds::Vector<long long> copy;
+    copy.resize_for_overwrite(SIZE);
+    ds::parallel_copy(src, copy, pool());
+    EXPECT_EQ(copy, src);
+
+    ds::Vector<long long> doubled(SIZE);
+    ds::parallel_transform(src, doubled, [](long long x) { return 2 * x; }, pool());
+    for (int i = 0; i < SIZE; i++) {
+        ASSERT_EQ(doubled[i], 2LL * i);
+    }
+
+    ds::Vector<long long> small(10);
+    EXPECT_THROW(ds::parallel_copy(src, small, pool()), std::invalid_argument);
+}
+
+TEST(ParallelTest, Reduce) {
+    ds::Vector<long long> v(SIZE);
+    std::iota(v.begin(), v.end(), 1);
+    EXPECT_EQ(ds::parallel_reduce(v, 10LL, std::plus<>(), pool()), 10LL + static_cast<long long>(SIZE) * (SIZE + 1) / 2);
+
+    ds::Vector<long long> empty;
+    EXPECT_EQ(ds::parallel_reduce(empty, 5LL, std::plus<>(), pool()), 5);
+
+    // Concatenation is associative but not commutative, so the order has to be kept
+    ds::Vector<std::string> letters;
+    for (int i = 0; i < SIZE; i++) {
+        letters.push_back(std::string(1, static_cast<char>('a' + i % 26)));
+    }
+    const auto joined = ds::parallel_reduce(letters, std::string(">"), std::plus<>(), pool());
+    ASSERT_EQ(joined.size(), SIZE + 1);
+    for (int i = 0; i < SIZE; i++) {
+        ASSERT_EQ(joined[i + 1], 'a' + i % 26);
+    }
+}
+
+TEST(ParallelTest, Sort) {
+    std::mt19937 generator(42); // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    ds::Vector<int> v(SIZE + 123);
+    std::generate(v.begin(), v.end(), [&generator] { return static_cast<int>(generator() % 1000); });
+
+    auto expected = v;
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+    ds::parallel_sort(v, std::greater<>(), pool());
+    EXPECT_EQ(v, expected);
+}
+
+TEST(ParallelTest, RadixSort) {
+    std::mt19937_64 generator(42); // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::normal_distribution<float> distribution(0.0F, 1000.0F);
+    ds::Vector<float> v(SIZE + 123);
+    std::generate(v.begin(), v.end(), [&] { return distribution(generator); });
+
+    auto expected = v;
+    std::sort(expected.begin(), expected.end());
+    ds::SortBuffer buffer;
+    ds::parallel_sort(v, buffer, std::less<>(), pool());
+    EXPECT_EQ(v, expected);
+
+    ds::Vector<types::size_t> keys(SIZE);
+    std::generate(keys.begin(), keys.end(), [&] { return generator() >> 8U; });
+    auto expected_keys = keys;
+    std::sort(expected_keys.begin(), expected_keys.end());
+    ds::parallel_sort(keys, buffer, std::less<>(), pool());
+    EXPECT_EQ(keys, expected_keys);
+}
+
+TEST(ParallelTest, SortStrings) {
+    ds::Vector<std::string> v;
+    for (int i = 0; i < SIZE; i++) {
+        v.push_back(std::to_string((i * 7919) % SIZE));
+    }
+
+    auto expected = v;
+    std::sort(expected.begin(), expected.end());
+    ds::parallel_sort(v, std::less<>(), pool());
+    EXPECT_EQ(v, expected);
+}
+
+TEST(ParallelTest, Equal) {
+    ds::Vector<double> lhs(SIZE, 1.5);
+    ds::Vector<double> rhs(SIZE, 1.5);
+    EXPECT_TRUE(ds::parallel_equal(lhs, rhs, pool()));
+
+    rhs[SIZE - 1] = 2.5;
+    EXPECT_FALSE(ds::parallel_equal(lhs, rhs, pool()));
+
+    rhs.pop_back();
+    EXPECT_FALSE(ds::parallel_equal(lhs, rhs, pool())) << "Ranges of different size are never equal";
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <persistent_vector.hpp>
+#include <vector.hpp>
+
+TEST(PersistentVectorTest, PushBackKeepsOldVersions) {
+    // Enough elements for three levels of inner nodes
+    constexpr int NUM_PUSHS = 40000;
+
+    std::vector<ds::PersistentVector<int>> versions(1);
+    for (int i = 0; i < NUM_PUSHS; i++) {
+        versions.push_back(versions.back().push_back(i));
+    }
+
+    for (int size = 0; size <= NUM_PUSHS; size += 997) {
+        const auto &version = versions[size];
+        ASSERT_EQ(version.size(), size);
+        for (int i = 0; i < size; i++) {
+            ASSERT_EQ(version[i], i) << "Version " << size << " should be unchanged at " << i;
+        }
+    }
+
+    EXPECT_TRUE(versions.front().empty());
+    EXPECT_EQ(versions.back().front(), 0);
+    EXPECT_EQ(versions.back().back(), NUM_PUSHS - 1);
+    EXPECT_THROW(versions.back().at(NUM_PUSHS), std::out_of_range);
+}
+
+TEST(PersistentVectorTest, SetKeepsOldVersions) {
+    constexpr int SIZE = 5000;
+
+    ds::Vector<int> values(SIZE);
+    std::iota(values.begin(), values.end(), 0);
+    const ds::PersistentVector<int> original(values);
+
+    auto updated = original;
+    for (int i = 0; i < SIZE; i += 7) {
+        updated = updated.set(i, -i);
+    }
+
+    for (int i = 0; i < SIZE; i++) {
+        ASSERT_EQ(original[i], i);
+        ASSERT_EQ(updated[i], i % 7 == 0 ? -i : i);
+    }
+    EXPECT_THROW((void) original.set(SIZE, 0), std::out_of_range);
+}
+
+TEST(PersistentVectorTest, Transient) {
+    constexpr int SIZE = 3000;
+
+    auto transient = ds::PersistentVector<std::string>{"a"}.transient();
+    for (int i = 1; i < SIZE; i++) {
+        transient.push_back(std::to_string(i));
+    }
+    const auto snapshot = transient.persistent();
+
+    transient.set(0, "changed");
+    transient.push_back("last");
+    const auto built = std::move(transient).persistent();
+
+    ASSERT_EQ(snapshot.size(), SIZE);
+    EXPECT_EQ(snapshot[0], "a") << "Later updates of the transient should not reach its snapshots";
+    EXPECT_EQ(snapshot[SIZE - 1], std::to_string(SIZE - 1));
+    ASSERT_EQ(built.size(), SIZE + 1);
+    EXPECT_EQ(built[0], "changed");
+    EXPECT_EQ(built[SIZE], "last");
+}
+
+TEST(PersistentVectorTest, ConvertsToVector) {
+    constexpr int SIZE = 1234;
+
+    ds::Vector<int> values(SIZE);
+    std::iota(values.begin(), values.end(), 0);
+    const ds::PersistentVector<int> persistent(values);
+    EXPECT_EQ(persistent.to_vector(), values);
+    EXPECT_EQ(ds::PersistentVector<int>(persistent.to_vector()), persistent);
+    EXPECT_EQ(ds::PersistentVector<int>().to_vector().size(), 0);
+}
+
+TEST(PersistentVectorTest, Iterator) {
+    constexpr int SIZE = 100;
+
+    ds::PersistentVector<int> v;
+    for (int i = 0; i < SIZE; i++) {
+        v = std::move(v).push_back(i);
+    }
+
+    EXPECT_EQ(std::distance(v.begin(), v.end()), SIZE);
+    EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0), SIZE * (SIZE - 1) / 2);
+
+    auto it = v.end();
+    for (int i = SIZE - 1; i >= 0; i--) {
+        --it;
+        ASSERT_EQ(*it, i) << "Walking back should cross chunks";
+    }
+    EXPECT_EQ(it, v.begin());
+    EXPECT_EQ(*(v.begin() + 64), 64);
+    EXPECT_EQ(v.begin()[99], 99);
+    static_assert(std::random_access_iterator<ds::PersistentVector<int>::const_iterator>);
+}
+
+TEST(PersistentVectorTest, ReleasesElements) {
+    constexpr int SIZE = 2000;
+
+    auto tracked = std::make_shared<int>(0);
+    {
+        ds::PersistentVector<std::shared_ptr<int>> v;
+        for (int i = 0; i < SIZE; i++) {
+            v = v.push_back(tracked);
+        }
+        const auto other = v.set(0, nullptr);
+        // Only the 32-element chunk that other changed should have been copied
+        EXPECT_EQ(tracked.use_count(), 1 + SIZE + 31) << "Versions should share every chunk but the changed one";
+    }
+    EXPECT_EQ(tracked.use_count(), 1) << "Dropping every version should free all nodes";
+}
+
+TEST(PersistentVectorTest, SnapshotsAcrossThreads) {
+    constexpr int NUM_PUSHS = 20000;
+    constexpr int NUM_READERS = 4;
+
+    ds::PersistentVector<int> published;
+    std::atomic<bool> done = false;
+    std::atomic<int> bad_snapshots = 0;
+    std::mutex mutex;
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < NUM_READERS; r++) {
+        readers.emplace_back([&] {
+            while (not done) {
+                ds::PersistentVector<int> snapshot;
+                {
+                    std::lock_guard lock(mutex);
+                    snapshot = published;
+                }
+                for (types::size_t i = 0; i < snapshot.size(); i++) {
+                    if (snapshot[i] != static_cast<int>(i)) {
+                        bad_snapshots++;
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+    auto transient = published.transient();
+    for (int i = 0; i < NUM_PUSHS; i++) {
+        transient.push_back(i);
+        if (i % 100 == 0) {
+            std::lock_guard lock(mutex);
+            published = transient.persistent();
+        }
+    }
+    done = true;
+    for (auto &reader: readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(bad_snapshots, 0);
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+#include <pool_allocator.hpp>
+#include <vector.hpp>
+
+TEST(PoolAllocatorTest, ReusesFreedChunks) {
+    ds::Pool pool;
+    auto *first = pool.allocate(24);
+    EXPECT_EQ(pool.stats().bytes_used, 32) << "Requests should be rounded up to their size class";
+    EXPECT_EQ(pool.stats().bytes_reserved, ds::Pool::SLAB_SIZE);
+
+    pool.deallocate(first, 24);
+    EXPECT_EQ(pool.stats().bytes_used, 0);
+    EXPECT_EQ(pool.allocate(30), first) << "Chunks of the same class should be recycled";
+    EXPECT_EQ(pool.stats().high_water_mark, 32);
+}
+
+TEST(PoolAllocatorTest, AlignmentAndLargeBlocks) {
+    ds::Pool pool;
+    auto *aligned = pool.allocate(8, 256);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 256, 0);
+
+    auto *large = pool.allocate(1 << 20);
+    EXPECT_EQ(pool.stats().bytes_used, 256 + (1 << 20));
+    pool.deallocate(large, 1 << 20);
+    pool.deallocate(aligned, 8, 256);
+    EXPECT_EQ(pool.stats().bytes_used, 0);
+    EXPECT_EQ(pool.stats().bytes_reserved, ds::Pool::SLAB_SIZE) << "Large blocks should be returned right away";
+}
+
+TEST(PoolAllocatorTest, ResizesInPlaceWithinClass) {
+    EXPECT_TRUE(ds::Pool::try_extend(nullptr, 40, 64));
+    EXPECT_FALSE(ds::Pool::try_extend(nullptr, 64, 65));
+    EXPECT_FALSE(ds::Pool::try_extend(nullptr, 1 << 20, (1 << 20) + 1));
+}
+
+TEST(PoolAllocatorTest, VectorsShareThePool) {
+    constexpr int NUM_VECTORS = 50;
+
+    ds::Pool pool;
+    for (int round = 0; round < 3; round++) {
+        ds::Vector<ds::Vector<std::string, ds::PoolAllocator<std::string>>, ds::PoolAllocator<ds::Vector<std::string, ds::PoolAllocator<std::string>>>> vectors{
+                ds::PoolAllocator<ds::Vector<std::string, ds::PoolAllocator<std::string>>>(pool)};
+        for (int i = 0; i < NUM_VECTORS; i++) {
+            auto &strings = vectors.emplace_back(ds::PoolAllocator<std::string>(pool));
+            for (int j = 0; j < i; j++) {
+                strings.push_back(std::to_string(j));
+            }
+        }
+
+        for (int i = 0; i < NUM_VECTORS; i++) {
+            ASSERT_EQ(vectors[i].size(), i);
+        }
+    }
+
+    EXPECT_EQ(pool.stats().bytes_used, 0);
+    EXPECT_GT(pool.stats().high_water_mark, 0);
+}
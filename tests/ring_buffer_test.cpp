@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ring_buffer.hpp>
+
+TEST(SpscRingTest, FillAndDrain) {
+    ds::SpscRing<std::string, 4> ring;
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.capacity(), 4);
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(ring.try_push(std::to_string(i)));
+    }
+    EXPECT_FALSE(ring.try_push("full")) << "Pushing to a full ring should fail";
+    EXPECT_EQ(ring.size(), 4);
+
+    EXPECT_EQ(ring.try_pop(), "0");
+    EXPECT_TRUE(ring.try_emplace(3, 'x'));
+
+    std::array<std::string, 8> out;
+    EXPECT_EQ(ring.pop(out), 4);
+    EXPECT_EQ(out[0], "1");
+    EXPECT_EQ(out[3], "xxx");
+    EXPECT_EQ(ring.try_pop(), std::nullopt);
+}
+
+TEST(SpscRingTest, BatchesWrapAround) {
+    ds::SpscRing<int, 8> ring;
+    const std::array<int, 6> values = {1, 2, 3, 4, 5, 6};
+    std::array<int, 6> out{};
+    for (int round = 0; round < 10; round++) {
+        EXPECT_EQ(ring.push(values), 6);
+        EXPECT_EQ(ring.push(values), 2) << "Only the prefix that fits should be pushed";
+        EXPECT_EQ(ring.pop(out), 6);
+        EXPECT_EQ(out, values);
+        EXPECT_EQ(ring.pop(std::span(out).first(2)), 2);
+        EXPECT_TRUE(ring.empty());
+    }
+}
+
+TEST(SpscRingTest, DestroysRemainingElements) {
+    auto counter = std::make_shared<int>(0);
+    {
+        ds::SpscRing<std::shared_ptr<int>, 16> ring;
+        for (int i = 0; i < 10; i++) {
+            ring.try_push(counter);
+        }
+        ring.try_pop();
+        EXPECT_EQ(counter.use_count(), 10);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(SpscRingTest, ProducerConsumer) {
+    constexpr long long NUM_MESSAGES = 1'000'000;
+
+    ds::SpscRing<long long, 1024> ring;
+    std::thread producer([&ring] {
+        for (long long i = 0; i < NUM_MESSAGES; i++) {
+            while (not ring.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    long long expected = 0;
+    std::array<long long, 64> batch{};
+    while (expected < NUM_MESSAGES) {
+        const auto count = ring.pop(batch);
+        for (ds::SpscRing<long long, 1024>::size_type i = 0; i < count; i++) {
+            ASSERT_EQ(batch[i], expected++) << "Messages should arrive in order";
+        }
+        if (count == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
+
+TEST(MpmcRingTest, RoundsCapacityUp) {
+    ds::MpmcRing<int> ring(5);
+    EXPECT_EQ(ring.capacity(), 8);
+
+    const std::array<int, 10> values = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    EXPECT_EQ(ring.push(values), 8);
+    EXPECT_FALSE(ring.try_push(42));
+
+    std::array<int, 3> out{};
+    EXPECT_EQ(ring.pop(out), 3);
+    EXPECT_EQ(out[2], 2);
+    EXPECT_TRUE(ring.try_push(8));
+    EXPECT_EQ(ring.try_pop(), 3);
+}
+
+// Contending threads find cells claimed ahead of the position they read, which is no reason to fail
+TEST(MpmcRingTest, NeverFailsBelowCapacity) {
+    constexpr int NUM_THREADS = 8;
+    constexpr int PER_THREAD = 1 << 13;
+
+    ds::MpmcRing<int> ring(NUM_THREADS * PER_THREAD);
+    std::atomic<int> failures = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; t++) {
+        threads.emplace_back([&ring, &failures, t] {
+            for (int i = 0; i < PER_THREAD; i += 2) {
+                failures += ring.try_push(t * PER_THREAD + i) ? 0 : 1;
+                const std::array<int, 1> value{t * PER_THREAD + i + 1};
+                failures += ring.push(value) == 1 ? 0 : 1;
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    threads.clear();
+    EXPECT_EQ(failures.load(), 0) << "try_push failed while the ring had room";
+
+    for (int t = 0; t < NUM_THREADS; t++) {
+        threads.emplace_back([&ring, &failures] {
+            std::array<int, 1> out{};
+            for (int i = 0; i < PER_THREAD; i += 2) {
+                failures += ring.try_pop() ? 0 : 1;
+                failures += ring.pop(out) == 1 ? 0 : 1;
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    EXPECT_EQ(failures.load(), 0) << "try_pop failed while the ring held elements";
+    EXPECT_FALSE(ring.try_pop());
+}
+
+TEST(MpmcRingTest, ManyProducersAndConsumers) {
+    constexpr int NUM_PRODUCERS = 4;
+    constexpr int NUM_CONSUMERS = 4;
+    constexpr int MESSAGES_PER_PRODUCER = 50000;
+
+    ds::MpmcRing<int> ring(256);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < NUM_PRODUCERS; p++) {
+        threads.emplace_back([&ring, p] {
+            for (int i = 0; i < MESSAGES_PER_PRODUCER; i++) {
+                while (not ring.try_push(p * MESSAGES_PER_PRODUCER + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::atomic<int> received = 0;
+    std::vector<std::vector<int>> seen(NUM_CONSUMERS);
+    for (int c = 0; c < NUM_CONSUMERS; c++) {
+        threads.emplace_back([&, c] {
+            std::array<int, 16> batch{};
+            while (received.load() < NUM_PRODUCERS * MESSAGES_PER_PRODUCER) {
+                const auto count = ring.pop(batch);
+                seen[c].insert(seen[c].end(), batch.begin(), batch.begin() + static_cast<long>(count));
+                received += static_cast<int>(count);
+                if (count == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    std::vector<int> all;
+    for (const auto &values: seen) {
+        all.insert(all.end(), values.begin(), values.end());
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_EQ(all.size(), NUM_PRODUCERS * MESSAGES_PER_PRODUCER);
+    for (int i = 0; i < NUM_PRODUCERS * MESSAGES_PER_PRODUCER; i++) {
+        ASSERT_EQ(all[i], i) << "Every message should be received exactly once";
+    }
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <sstream>
+#include <string>
+
+#include <serialization.hpp>
+#include <vector.hpp>
+
+namespace {
+    class SerializationTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            const auto *test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+            path = std::filesystem::temp_directory_path() / (std::string("ds_serialization_") + test_name);
+            fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644); // NOLINT(cppcoreguidelines-pro-type-vararg)
+            ASSERT_GE(fd, 0);
+        }
+
+        void TearDown() override {
+            ::close(fd);
+            std::filesystem::remove(path);
+        }
+
+        void rewind() const {
+            ASSERT_EQ(::lseek(fd, 0, SEEK_SET), 0);
+        }
+
+        std::filesystem::path path;
+        int fd = -1;
+    };
+
+    struct Point {
+        double x;
+        double y;
+
+        auto operator==(const Point &) const -> bool = default;
+    };
+} // namespace
+
+TEST_F(SerializationTest, RoundTripsTriviallyCopyableElements) {
+    ds::Vector<std::uint64_t> large;
+    for (std::uint64_t i = 0; i < 1'000'000; i++) {
+        large.push_back(i * i);
+    }
+    const ds::Vector<Point> points{{1, 2}, {3, 4}};
+    const ds::Vector<int> empty;
+
+    ds::io::write(fd, large);
+    ds::io::write(fd, points);
+    ds::io::write(fd, empty);
+    EXPECT_EQ(std::filesystem::file_size(path), 3 * sizeof(ds::io::SerializedVectorHeader) + large.size() * 8 + 2 * sizeof(Point))
+        << "Raw elements should be stored without per-element overhead";
+
+    rewind();
+    ds::Vector<std::uint64_t> large_read;
+    ds::Vector<Point> points_read;
+    ds::Vector<int> empty_read{1, 2, 3};
+    ds::io::read(fd, large_read);
+    ds::io::read(fd, points_read);
+    ds::io::read(fd, empty_read);
+    EXPECT_EQ(large_read, large);
+    EXPECT_EQ(points_read, points);
+    EXPECT_TRUE(empty_read.empty());
+}
+
+TEST_F(SerializationTest, RoundTripsNestedContainers) {
+    ds::Vector<ds::Vector<int>> nested;
+    for (int i = 0; i < 300; i++) {
+        nested.emplace_back(static_cast<types::size_t>(i), i);
+    }
+    const ds::Vector<std::string> words{"", "flat", std::string(100000, 'x')};
+
+    ds::io::write(fd, nested);
+    ds::io::write(fd, words);
+
+    rewind();
+    ds::Vector<ds::Vector<int>> nested_read;
+    ds::Vector<std::string> words_read;
+    ds::io::read(fd, nested_read);
+    ds::io::read(fd, words_read);
+    EXPECT_EQ(nested_read, nested);
+    EXPECT_EQ(words_read, words);
+}
+
+TEST_F(SerializationTest, ReadsBackToBackFromAPipe) {
+    std::array<int, 2> pipe_fds{};
+    ASSERT_EQ(::pipe(pipe_fds.data()), 0);
+    const ds::Vector<ds::Vector<char>> first{{'a'}, {'b', 'c'}};
+    const ds::Vector<short> second{1, 2, 3};
+    ds::io::write(pipe_fds[1], first);
+    ds::io::write(pipe_fds[1], second);
+    ::close(pipe_fds[1]);
+
+    // Each read must stop at the end of its own vector, as a pipe cannot give bytes back
+    ds::Vector<ds::Vector<char>> first_read;
+    ds::Vector<short> second_read;
+    ds::io::read(pipe_fds[0], first_read);
+    ds::io::read(pipe_fds[0], second_read);
+    EXPECT_EQ(first_read, first);
+    EXPECT_EQ(second_read, second);
+    ::close(pipe_fds[0]);
+}
+
+TEST_F(SerializationTest, RoundTripsThroughStreams) {
+    std::stringstream stream;
+    const ds::Vector<double> values{1.5, -2.5, 3.25};
+    const ds::Vector<std::string> words{"a", "bc"};
+    ds::io::write(stream, values);
+    ds::io::write(stream, words);
+
+    ds::Vector<double> values_read;
+    ds::Vector<std::string> words_read;
+    ds::io::read(stream, values_read);
+    ds::io::read(stream, words_read);
+    EXPECT_EQ(values_read, values);
+    EXPECT_EQ(words_read, words);
+}
+
+TEST_F(SerializationTest, RejectsMalformedInput) {
+    ds::Vector<int> values;
+
+    std::stringstream garbage("definitely not a vector, but long enough for a header");
+    EXPECT_THROW(ds::io::read(garbage, values), std::runtime_error);
+
+    std::stringstream other_type;
+    ds::io::write(other_type, ds::Vector<std::uint64_t>{1, 2});
+    EXPECT_THROW(ds::io::read(other_type, values), std::runtime_error);
+
+    std::stringstream truncated;
+    ds::io::write(truncated, ds::Vector<int>{1, 2, 3});
+    auto bytes = truncated.str();
+    bytes.pop_back();
+    truncated.str(bytes);
+    EXPECT_THROW(ds::io::read(truncated, values), std::runtime_error);
+
+    ds::io::write(fd, ds::Vector<int>{1, 2, 3});
+    ASSERT_EQ(::ftruncate(fd, sizeof(ds::io::SerializedVectorHeader) + 4), 0);
+    rewind();
+    EXPECT_THROW(ds::io::read(fd, values), std::runtime_error);
+}
+
+TEST_F(SerializationTest, RejectsOtherTypesOfTheSameSize) {
+    std::stringstream floats;
+    ds::io::write(floats, ds::Vector<float>{1.5F, 2.5F});
+    ds::Vector<int> ints;
+    EXPECT_THROW(ds::io::read(floats, ints), std::runtime_error);
+
+    std::stringstream unsigned_ints;
+    ds::io::write(unsigned_ints, ds::Vector<unsigned>{1, 2});
+    EXPECT_THROW(ds::io::read(unsigned_ints, ints), std::runtime_error);
+
+    std::stringstream strings;
+    ds::io::write(strings, ds::Vector<std::string>{"one", "two"});
+    ds::Vector<ds::Vector<char>> nested;
+    EXPECT_THROW(ds::io::read(strings, nested), std::runtime_error);
+}
+
+TEST_F(SerializationTest, RejectsOverflowingSize) {
+    std::stringstream stream;
+    ds::io::write(stream, ds::Vector<int>{});
+    auto bytes = stream.str();
+    // Counted in bytes, this size wraps around to zero and would pass as available
+    const std::uint64_t size = 1ULL << 62U;
+    bytes.replace(offsetof(ds::io::SerializedVectorHeader, size), sizeof(size), reinterpret_cast<const char *>(&size), sizeof(size)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    stream.str(bytes);
+
+    ds::Vector<int> values;
+    EXPECT_THROW(ds::io::read(stream, values), std::runtime_error);
+}
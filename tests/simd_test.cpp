@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <simd.hpp>
+#include <vector.hpp>
+
+namespace {
+    // Sizes around every register width, so both vector bodies and scalar tails are exercised
+    constexpr int MAX_SIZE = 300;
+
+    template<typename T>
+    class SimdTest : public ::testing::Test {};
+
+    using SimdTypes = ::testing::Types<std::int8_t, std::uint16_t, int, std::uint64_t, float, double>;
+} // namespace
+
+TYPED_TEST_SUITE(SimdTest, SimdTypes);
+
+TYPED_TEST(SimdTest, Equal) {
+    for (int size = 0; size < MAX_SIZE; size++) {
+        ds::Vector<TypeParam> lhs(size);
+        std::iota(lhs.begin(), lhs.end(), TypeParam{1});
+        auto rhs = lhs;
+        EXPECT_TRUE(ds::simd::equal(lhs, rhs));
+        EXPECT_EQ(lhs, rhs);
+
+        if (size > 0) {
+            rhs[size - 1] = static_cast<TypeParam>(lhs[size - 1] + 1);
+            EXPECT_FALSE(ds::simd::equal(lhs, rhs)) << "Difference in the last element of " << size;
+            EXPECT_NE(lhs, rhs);
+        }
+    }
+}
+
+TYPED_TEST(SimdTest, FillFindCount) {
+    constexpr TypeParam VALUE = 7;
+    constexpr TypeParam NEEDLE = 3;
+
+    for (int size = 0; size < MAX_SIZE; size++) {
+        ds::Vector<TypeParam> v(size);
+        ds::simd::fill(v, VALUE);
+        EXPECT_EQ(ds::simd::count(v, VALUE), size);
+        EXPECT_EQ(ds::simd::find(v, NEEDLE), size) << "Missing values should return the size";
+
+        for (int pos = size - 1; pos >= 0; pos -= 7) {
+            v[pos] = NEEDLE;
+            EXPECT_EQ(ds::simd::find(v, NEEDLE), pos) << "Should find the first occurrence";
+        }
+        EXPECT_EQ(ds::simd::count(v, NEEDLE), std::count(v.begin(), v.end(), NEEDLE));
+    }
+}
+
+TYPED_TEST(SimdTest, MinMaxSum) {
+    for (int size = 1; size < MAX_SIZE; size++) {
+        std::vector<TypeParam> v(size);
+        for (int i = 0; i < size; i++) {
+            v[i] = static_cast<TypeParam>((i * 37) % 101);
+        }
+
+        EXPECT_EQ(ds::simd::min(v), *std::min_element(v.begin(), v.end()));
+        EXPECT_EQ(ds::simd::max(v), *std::max_element(v.begin(), v.end()));
+        EXPECT_EQ(ds::simd::sum(v), std::accumulate(v.begin(), v.end(), TypeParam{}));
+    }
+
+    EXPECT_THROW(ds::simd::min(std::vector<TypeParam>()), std::invalid_argument);
+    EXPECT_THROW(ds::simd::max(std::vector<TypeParam>()), std::invalid_argument);
+}
+
+TEST(SimdTest, CountDoesNotOverflowNarrowLanes) {
+    constexpr int SIZE = 100000;
+
+    ds::Vector<std::int8_t> v(SIZE, 1);
+    EXPECT_EQ(ds::simd::count(v, std::int8_t{1}), SIZE);
+}
+
+TEST(SimdTest, SignedSumsWrapAround) {
+    constexpr int SIZE = 1001;
+
+    const ds::Vector<int> ints(SIZE, std::numeric_limits<int>::max());
+    EXPECT_EQ(ds::simd::sum(ints), static_cast<int>(SIZE * static_cast<unsigned>(std::numeric_limits<int>::max())));
+
+    const ds::Vector<std::int64_t> longs(SIZE, std::numeric_limits<std::int64_t>::min() + 1);
+    EXPECT_EQ(ds::simd::sum(longs), static_cast<std::int64_t>(SIZE * static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::min() + 1)));
+}
+
+TEST(SimdTest, FloatingPointEquality) {
+    ds::Vector<double> with_nan(MAX_SIZE, std::numeric_limits<double>::quiet_NaN());
+    EXPECT_NE(with_nan, with_nan) << "NaN should never compare equal";
+
+    ds::Vector<double> zeros(MAX_SIZE, 0.0);
+    ds::Vector<double> negative_zeros(MAX_SIZE, -0.0);
+    EXPECT_EQ(zeros, negative_zeros) << "0.0 and -0.0 should compare equal";
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <small_vector.hpp>
+
+namespace {
+    template<typename T>
+    struct CountingAllocator {
+        using value_type = T;
+
+        CountingAllocator() = default;
+
+        template<typename U>
+        explicit CountingAllocator(const CountingAllocator<U> &) {}
+
+        T *allocate(std::size_t n) {
+            allocations++;
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T *p, std::size_t n) {
+            deallocations++;
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        bool operator==(const CountingAllocator &) const = default;
+
+        static inline int allocations = 0;
+        static inline int deallocations = 0;
+    };
+} // namespace
+
+TEST(SmallVectorTest, StaysInline) {
+    constexpr int INLINE_CAPACITY = 16;
+
+    ds::SmallVector<int, INLINE_CAPACITY, CountingAllocator<int>> v;
+    EXPECT_EQ(v.capacity(), INLINE_CAPACITY) << "Capacity should start at the inline capacity";
+    EXPECT_TRUE(v.uses_inline_storage());
+
+    for (int i = 0; i < INLINE_CAPACITY; i++) {
+        v.push_back(i);
+    }
+    EXPECT_TRUE(v.uses_inline_storage());
+    EXPECT_EQ(CountingAllocator<int>::allocations, 0) << "Up to the inline capacity nothing should be allocated";
+
+    v.reserve(INLINE_CAPACITY / 2);
+    EXPECT_EQ(v.capacity(), INLINE_CAPACITY) << "Capacity should never drop below the inline capacity";
+}
+
+TEST(SmallVectorTest, SpillsToHeap) {
+    constexpr int INLINE_CAPACITY = 4;
+    constexpr int NUM_PUSHS = 100;
+
+    {
+        ds::SmallVector<int, INLINE_CAPACITY, CountingAllocator<int>> v;
+        for (int i = 0; i < NUM_PUSHS; i++) {
+            v.push_back(i);
+        }
+        EXPECT_FALSE(v.uses_inline_storage());
+        EXPECT_GT(CountingAllocator<int>::allocations, 0);
+        for (int i = 0; i < NUM_PUSHS; i++) {
+            EXPECT_EQ(v[i], i) << "Value should be " << i;
+        }
+
+        v.erase(v.begin() + INLINE_CAPACITY, v.end());
+        v.shrink_to_fit();
+        EXPECT_TRUE(v.uses_inline_storage()) << "Shrinking should bring the elements back inline";
+        EXPECT_EQ(v, (ds::SmallVector<int, INLINE_CAPACITY, CountingAllocator<int>>{0, 1, 2, 3}));
+    }
+
+    EXPECT_EQ(CountingAllocator<int>::allocations, CountingAllocator<int>::deallocations)
+            << "Every allocation should be released";
+}
+
+TEST(SmallVectorTest, CopyAndMove) {
+    constexpr int INLINE_CAPACITY = 4;
+    const std::string LONG_STRING(100, 'a');
+
+    ds::SmallVector<std::string, INLINE_CAPACITY> small = {"a", "b", LONG_STRING};
+    ds::SmallVector<std::string, INLINE_CAPACITY> large = {"a", "b", "c", "d", "e", LONG_STRING};
+
+    auto small_copy = small;
+    EXPECT_EQ(small_copy, small);
+    EXPECT_TRUE(small_copy.uses_inline_storage());
+
+    auto large_copy = large;
+    EXPECT_EQ(large_copy, large);
+
+    auto small_moved = std::move(small_copy);
+    EXPECT_EQ(small_moved, small);
+    EXPECT_TRUE(small_moved.uses_inline_storage()) << "Moving inline elements should keep them inline";
+    EXPECT_TRUE(small_copy.empty()); // NOLINT(bugprone-use-after-move)
+
+    const auto *large_data = large_copy.data();
+    auto large_moved = std::move(large_copy);
+    EXPECT_EQ(large_moved, large);
+    EXPECT_EQ(large_moved.data(), large_data) << "Moving heap storage should steal the buffer";
+
+    large_moved = std::move(small_moved);
+    EXPECT_EQ(large_moved, small);
+    small_moved = large;
+    EXPECT_EQ(small_moved, large);
+}
+
+TEST(SmallVectorTest, SharesVectorApi) {
+    ds::SmallVector<int, 2> v = {1, 2};
+    static_assert(std::is_same_v<decltype(v.begin()), it::ContiguousIterator<int, int &>>);
+
+    v.insert(v.begin() + 1, {5, 6, 7});
+    EXPECT_EQ(v, (ds::SmallVector<int, 2>{1, 5, 6, 7, 2}));
+
+    v.emplace_back(3);
+    v.erase(v.begin());
+    EXPECT_EQ(v, (ds::SmallVector<int, 2>{5, 6, 7, 2, 3}));
+
+    v.assign(2, 9);
+    EXPECT_EQ(v, (ds::SmallVector<int, 2>{9, 9}));
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include <simd.hpp>
+#include <soa_vector.hpp>
+
+namespace {
+    struct ThrowingField {
+        static inline bool should_throw = false;
+
+        ThrowingField() = default;
+
+        ThrowingField(const ThrowingField &) {
+            if (should_throw) {
+                throw std::runtime_error("copy failed");
+            }
+        }
+    };
+} // namespace
+
+TEST(SoAVectorTest, PushAndAccessRows) {
+    constexpr int NUM_PUSHS = 100;
+
+    ds::SoAVector<int, double, std::string> v;
+    for (int i = 0; i < NUM_PUSHS; i++) {
+        v.push_back(i, i * 0.5, std::to_string(i));
+    }
+    v.push_back(std::tuple<int, double, std::string>(NUM_PUSHS, NUM_PUSHS * 0.5, std::to_string(NUM_PUSHS)));
+    EXPECT_EQ(v.size(), NUM_PUSHS + 1);
+
+    for (int i = 0; i <= NUM_PUSHS; i++) {
+        const auto [id, weight, name] = v[i];
+        EXPECT_EQ(id, i);
+        EXPECT_EQ(weight, i * 0.5);
+        EXPECT_EQ(name, std::to_string(i));
+    }
+
+    std::get<2>(v.back()) = "last";
+    EXPECT_EQ(v.column<2>()[NUM_PUSHS], "last") << "Rows should reference the column elements";
+
+    v.pop_back();
+    EXPECT_EQ(v.size(), NUM_PUSHS);
+    EXPECT_THROW(v.at(NUM_PUSHS), std::out_of_range);
+}
+
+TEST(SoAVectorTest, Columns) {
+    constexpr int NUM_PUSHS = 1000;
+
+    ds::SoAVector<int, float> v;
+    v.reserve(NUM_PUSHS);
+    for (int i = 0; i < NUM_PUSHS; i++) {
+        v.emplace_back(i, 1.0F);
+    }
+
+    const auto ids = v.column<0>();
+    EXPECT_EQ(ids.size(), NUM_PUSHS);
+    EXPECT_EQ(std::accumulate(ids.begin(), ids.end(), 0), NUM_PUSHS * (NUM_PUSHS - 1) / 2);
+    EXPECT_EQ(ds::simd::sum(v.column<1>()), static_cast<float>(NUM_PUSHS)) << "Columns should work with SIMD kernels";
+
+    std::fill(v.column_begin<1>(), v.column_end<1>(), 2.0F);
+    EXPECT_EQ(std::get<1>(v[NUM_PUSHS - 1]), 2.0F);
+}
+
+TEST(SoAVectorTest, RowIterator) {
+    ds::SoAVector<int, char> v;
+    v.push_back(2, 'b');
+    v.push_back(0, 'z');
+    v.push_back(1, 'a');
+
+    int rows = 0;
+    for (auto [id, tag]: v) {
+        tag = static_cast<char>('a' + id);
+        rows++;
+    }
+    EXPECT_EQ(rows, 3);
+    EXPECT_EQ(v.end() - v.begin(), 3);
+
+    const auto &const_v = v;
+    EXPECT_TRUE(std::all_of(const_v.begin(), const_v.end(), [](auto row) { return std::get<1>(row) == 'a' + std::get<0>(row); }));
+}
+
+TEST(SoAVectorTest, FailedPushKeepsColumnsAligned) {
+    ds::SoAVector<int, ThrowingField> v;
+    const ThrowingField field;
+    v.push_back(1, field);
+
+    ThrowingField::should_throw = true;
+    EXPECT_THROW(v.push_back(2, field), std::runtime_error);
+    ThrowingField::should_throw = false;
+
+    EXPECT_EQ(v.size(), 1);
+    EXPECT_EQ(v.column<0>().size(), v.column<1>().size());
+    EXPECT_EQ(v.column<0>()[0], 1);
+}
+
+TEST(SoAVectorTest, PushesOwnFieldsAcrossGrowth) {
+    ds::SoAVector<std::string, int> v;
+    v.emplace_back(std::string(100, 'a'), 0);
+    for (int i = 1; i < 64; i += 2) {
+        v.emplace_back(std::get<0>(v.front()), i);
+        v.push_back(std::get<0>(v.back()), std::get<1>(v.back()) + 1);
+    }
+
+    ASSERT_EQ(v.size(), 65);
+    for (int i = 0; i < 65; i++) {
+        ASSERT_EQ(std::get<0>(v[i]), std::string(100, 'a'));
+        ASSERT_EQ(std::get<1>(v[i]), i);
+    }
+}
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+
+#include <sort.hpp>
+#include <vector.hpp>
+
+namespace {
+    // Sizes on both sides of the radix sort threshold
+    constexpr int SIZES[] = {0, 1, 2, 23, 100, 257, 5000, 100'000}; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+    template<typename T>
+    auto random_vector(int size, T min, T max) -> ds::Vector<T> {
+        std::mt19937_64 generator(size); // NOLINT(cert-msc32-c,cert-msc51-cpp)
+        ds::Vector<T> v(size);
+        if constexpr (std::is_floating_point_v<T>) {
+            std::uniform_real_distribution<T> distribution(min, max);
+            std::generate(v.begin(), v.end(), [&] { return distribution(generator); });
+        } else {
+            // Character types are not valid for uniform_int_distribution
+            std::uniform_int_distribution<std::conditional_t<(sizeof(T) < sizeof(short)), int, T>> distribution(min, max);
+            std::generate(v.begin(), v.end(), [&] { return static_cast<T>(distribution(generator)); });
+        }
+        return v;
+    }
+
+    template<typename T, typename Compare = std::less<>>
+    void expect_sorts_like_std(ds::Vector<T> v, Compare comp = {}) {
+        auto expected = v;
+        std::sort(expected.begin(), expected.end(), comp);
+        ds::sort(v, comp);
+        EXPECT_EQ(v, expected) << "Size " << v.size();
+    }
+} // namespace
+
+TEST(SortTest, SignedIntegers) {
+    for (const auto size: SIZES) {
+        expect_sorts_like_std(random_vector<int>(size, -1'000'000, 1'000'000));
+        expect_sorts_like_std(random_vector<std::int64_t>(size, std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max()));
+        expect_sorts_like_std(random_vector<short>(size, -300, 300));
+    }
+}
+
+TEST(SortTest, UnsignedIntegers) {
+    for (const auto size: SIZES) {
+        expect_sorts_like_std(random_vector<std::uint64_t>(size, 0, std::numeric_limits<std::uint64_t>::max()));
+        // The upper bytes are zero in every key, so their passes are skipped
+        expect_sorts_like_std(random_vector<std::uint64_t>(size, 0, 1'000));
+        expect_sorts_like_std(random_vector<unsigned char>(size, 0, 255));
+    }
+}
+
+TEST(SortTest, FloatingPoint) {
+    for (const auto size: SIZES) {
+        expect_sorts_like_std(random_vector<float>(size, -1e6F, 1e6F));
+        expect_sorts_like_std(random_vector<double>(size, -1.0, 1.0));
+    }
+
+    constexpr auto INF = std::numeric_limits<double>::infinity();
+    ds::Vector<double> v(8000);
+    for (int i = 0; i < 8000; i++) {
+        v[i] = std::array{-INF, INF, -1.5, 2.5, 0.0, -0.0, std::numeric_limits<double>::denorm_min(), -1e300}[i % 8];
+    }
+    ds::sort(v);
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+    EXPECT_EQ(v[0], -INF);
+    EXPECT_EQ(v[7999], INF);
+    EXPECT_TRUE(std::signbit(v[3000])) << "-0.0 goes before 0.0";
+    EXPECT_FALSE(std::signbit(v[4000]));
+}
+
+TEST(SortTest, LargerThanCache) {
+    // Split by the highest byte before the LSD passes, which for the narrow range is the second one
+    constexpr int SIZE = 1 << 18;
+    expect_sorts_like_std(random_vector<std::int32_t>(SIZE, std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max()));
+    expect_sorts_like_std(random_vector<std::uint64_t>(SIZE, 0, 1U << 12U));
+    expect_sorts_like_std(random_vector<double>(SIZE, -1e9, 1e9), std::greater<>());
+}
+
+TEST(SortTest, Descending) {
+    for (const auto size: SIZES) {
+        expect_sorts_like_std(random_vector<int>(size, -1'000, 1'000), std::greater<>());
+        expect_sorts_like_std(random_vector<float>(size, -1.0F, 1.0F), std::ranges::greater());
+    }
+}
+
+TEST(SortTest, ReusesBuffer) {
+    ds::SortBuffer buffer;
+    auto v = random_vector<std::uint64_t>(10'000, 0, std::numeric_limits<std::uint64_t>::max());
+    ds::sort(v, buffer);
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+    const auto capacity = buffer.capacity();
+    EXPECT_GE(capacity, 10'000 * sizeof(std::uint64_t));
+
+    auto w = random_vector<std::uint32_t>(20'000, 0, std::numeric_limits<std::uint32_t>::max());
+    ds::sort(w, buffer);
+    EXPECT_TRUE(std::is_sorted(w.begin(), w.end()));
+    EXPECT_EQ(buffer.capacity(), capacity) << "The same bytes fit the second sort";
+
+    buffer.release();
+    EXPECT_EQ(buffer.capacity(), 0);
+}
+
+TEST(SortTest, ComparisonOnly) {
+    for (const auto size: SIZES) {
+        auto keys = random_vector<int>(size, 0, size / 4);
+        ds::Vector<std::string> strings;
+        for (const auto key: keys) {
+            strings.push_back(std::to_string(key));
+        }
+        expect_sorts_like_std(strings);
+        expect_sorts_like_std(keys, [](int lhs, int rhs) { return lhs > rhs; });
+    }
+}
+
+TEST(SortTest, Patterns) {
+    constexpr int SIZE = 10'000;
+    ds::Vector<long> ascending(SIZE);
+    std::iota(ascending.begin(), ascending.end(), 0);
+    auto descending = ascending;
+    std::reverse(descending.begin(), descending.end());
+    ds::Vector<long> organ_pipe(SIZE);
+    for (int i = 0; i < SIZE; i++) {
+        organ_pipe[i] = std::min(i, SIZE - i);
+    }
+    const ds::Vector<long> equal(SIZE, 7);
+
+    // Adversarial inputs for quicksort, sorted through a comparator so that pdqsort runs
+    const auto less = [](long lhs, long rhs) { return lhs < rhs; };
+    for (const auto &v: {ascending, descending, organ_pipe, equal}) {
+        expect_sorts_like_std(v, less);
+    }
+
+    // Already sorted input ends after the partial insertion sorts, with a linear number of comparisons
+    int comparisons = 0;
+    ds::sort(ascending, [&](long lhs, long rhs) {
+        comparisons++;
+        return lhs < rhs;
+    });
+    EXPECT_LT(comparisons, 4 * SIZE);
+}
+
+TEST(SortTest, Iterators) {
+    auto v = random_vector<int>(5000, -100, 100);
+    auto expected = v;
+    std::sort(expected.begin(), expected.end());
+    ds::sort(v.begin(), v.end());
+    EXPECT_EQ(v, expected);
+
+    auto data = random_vector<int>(5000, -100, 100);
+    ds::sort(data.data(), data.data() + 2500);
+    EXPECT_TRUE(std::is_sorted(data.begin(), data.begin() + 2500));
+
+    std::deque<int> deque(v.begin(), v.end());
+    std::reverse(deque.begin(), deque.end());
+    ds::sort(deque.begin(), deque.end());
+    EXPECT_TRUE(std::equal(deque.begin(), deque.end(), expected.begin(), expected.end()));
+}
+
+TEST(SortTest, SortByKey) {
+    for (const auto size: SIZES) {
+        auto keys = random_vector<int>(size, -size / 8, size / 8);
+        ds::Vector<int> values(size);
+        std::iota(values.begin(), values.end(), 0);
+        const auto original = keys;
+
+        ds::sort_by_key(keys, values);
+        EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+        for (int i = 0; i < size; i++) {
+            ASSERT_EQ(keys[i], original[values[i]]) << "Values move along with their keys";
+            if (i > 0 and keys[i - 1] == keys[i]) {
+                ASSERT_LT(values[i - 1], values[i]) << "Equal keys keep their order";
+            }
+        }
+    }
+}
+
+TEST(SortTest, SortByKeyNonTrivialValues) {
+    ds::Vector<double> keys = random_vector<double>(5000, -1.0, 1.0);
+    ds::Vector<std::string> values;
+    for (const auto key: keys) {
+        values.push_back(std::to_string(key));
+    }
+
+    ds::sort_by_key(keys, values, std::greater<>());
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end(), std::greater<>()));
+    for (types::size_t i = 0; i < keys.size(); i++) {
+        ASSERT_EQ(values[i], std::to_string(keys[i]));
+    }
+}
+
+TEST(SortTest, SortByKeyComparisonOnly) {
+    ds::Vector<std::string> keys{"pear", "apple", "fig", "apple", "kiwi", "fig"};
+    ds::Vector<int> values{0, 1, 2, 3, 4, 5};
+    ds::SortBuffer buffer;
+    ds::sort_by_key(keys, values, buffer);
+    EXPECT_EQ(keys, (ds::Vector<std::string>{"apple", "apple", "fig", "fig", "kiwi", "pear"}));
+    EXPECT_EQ(values, (ds::Vector<int>{1, 3, 2, 5, 4, 0}));
+
+    ds::Vector<int> too_few{1, 2};
+    EXPECT_THROW(ds::sort_by_key(keys, too_few), std::invalid_argument);
+}
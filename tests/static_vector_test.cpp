@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <static_vector.hpp>
+
+namespace {
+    constexpr auto primes_below_100() {
+        ds::StaticVector<int, 32> primes;
+        for (int n = 2; n < 100; n++) {
+            if (std::none_of(primes.begin(), primes.end(), [n](int p) { return n % p == 0; })) {
+                primes.push_back(n);
+            }
+        }
+        return primes;
+    }
+
+    // Built at compile time and kept
+    constexpr auto PRIMES = primes_below_100();
+} // namespace
+
+TEST(StaticVectorTest, Constructor) {
+    ds::StaticVector<int, 8> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.capacity(), 8);
+
+    ds::StaticVector<int, 8> zeros(5);
+    EXPECT_EQ(zeros, (ds::StaticVector<int, 8>{0, 0, 0, 0, 0}));
+
+    ds::StaticVector<int, 8> sevens(3, 7);
+    EXPECT_EQ(sevens, (ds::StaticVector<int, 8>{7, 7, 7}));
+
+    const ds::StaticVector<int, 8> list = {0, 1, 2, 3};
+    const ds::StaticVector<int, 8> from_range(list.begin() + 1, list.end());
+    EXPECT_EQ(from_range, (ds::StaticVector<int, 8>{1, 2, 3}));
+
+    EXPECT_THROW((ds::StaticVector<int, 8>(9)), std::length_error);
+    EXPECT_THROW((ds::StaticVector<int, 2>{1, 2, 3}), std::length_error);
+}
+
+TEST(StaticVectorTest, PushPastCapacityThrows) {
+    ds::StaticVector<int, 4> v;
+    for (int i = 0; i < 4; i++) {
+        v.push_back(i);
+    }
+
+    EXPECT_THROW(v.push_back(4), std::length_error);
+    EXPECT_EQ(v.size(), 4) << "A failed push should leave the vector as it was";
+    EXPECT_THROW(v.insert(v.begin(), 2, 0), std::length_error);
+    EXPECT_THROW(v.reserve(5), std::length_error);
+    EXPECT_NO_THROW(v.reserve(4));
+}
+
+TEST(StaticVectorTest, Access) {
+    ds::StaticVector<int, 8> v = {1, 2, 3};
+    v.front() = 10;
+    v.back() = 30;
+    v.at(1) = 20;
+    EXPECT_EQ(v, (ds::StaticVector<int, 8>{10, 20, 30})) << "Accessors should return references";
+    EXPECT_THROW(v.at(3), std::out_of_range);
+    EXPECT_EQ(v.data(), &v[0]);
+}
+
+TEST(StaticVectorTest, InsertAndErase) {
+    ds::StaticVector<std::string, 16> v = {"b", "d"};
+    v.insert(v.begin(), "a");
+    v.insert(v.begin() + 2, "c");
+    v.insert(v.end(), {"e", "f"});
+    v.insert(v.begin(), 2, "_");
+    EXPECT_EQ(v, (ds::StaticVector<std::string, 16>{"_", "_", "a", "b", "c", "d", "e", "f"}));
+
+    auto next = v.erase(v.begin(), v.begin() + 2);
+    EXPECT_EQ(*next, "a");
+    next = v.erase(v.begin() + 1);
+    EXPECT_EQ(*next, "c");
+    EXPECT_EQ(v, (ds::StaticVector<std::string, 16>{"a", "c", "d", "e", "f"}));
+
+    v.emplace(v.begin() + 1, 3, 'b');
+    EXPECT_EQ(v[1], "bbb");
+}
+
+TEST(StaticVectorTest, Resize) {
+    ds::StaticVector<std::string, 8> v = {"a", "b"};
+    v.resize(4, "x");
+    EXPECT_EQ(v, (ds::StaticVector<std::string, 8>{"a", "b", "x", "x"}));
+    v.resize(1);
+    EXPECT_EQ(v, (ds::StaticVector<std::string, 8>{"a"}));
+    v.pop_back();
+    EXPECT_TRUE(v.empty());
+    EXPECT_THROW(v.resize(9), std::length_error);
+}
+
+TEST(StaticVectorTest, CopyAndMove) {
+    ds::StaticVector<std::unique_ptr<int>, 4> owners;
+    owners.push_back(std::make_unique<int>(1));
+    owners.push_back(std::make_unique<int>(2));
+
+    auto moved(std::move(owners));
+    EXPECT_TRUE(owners.empty()); // NOLINT(bugprone-use-after-move)
+    ASSERT_EQ(moved.size(), 2);
+    EXPECT_EQ(*moved[1], 2);
+
+    owners = std::move(moved);
+    EXPECT_EQ(*owners[0], 1);
+
+    ds::StaticVector<std::string, 4> strings = {"a", "b", "c"};
+    ds::StaticVector<std::string, 4> copy(strings);
+    EXPECT_EQ(copy, strings);
+    copy = {"z"};
+    EXPECT_EQ(copy.size(), 1);
+    copy = strings;
+    EXPECT_EQ(copy, strings);
+    copy.assign(2, "q");
+    EXPECT_EQ(copy, (ds::StaticVector<std::string, 4>{"q", "q"}));
+}
+
+TEST(StaticVectorTest, ConstantEvaluation) {
+    static_assert(PRIMES.size() == 25);
+    static_assert(PRIMES.front() == 2 and PRIMES.back() == 97);
+    static_assert(PRIMES[4] == 11);
+
+    constexpr auto edited = [] {
+        ds::StaticVector<int, 8> v = {1, 2, 4};
+        v.insert(v.begin() + 2, 3);
+        v.erase(v.begin());
+        v.resize(5, 9);
+        return v;
+    }();
+    static_assert(edited == ds::StaticVector<int, 8>{2, 3, 4, 9, 9});
+
+    EXPECT_EQ(PRIMES[24], 97);
+}
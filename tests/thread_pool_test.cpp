@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <thread_pool.hpp>
+
+TEST(ThreadPoolTest, RunsSubmittedTasks) {
+    constexpr int NUM_TASKS = 1000;
+
+    std::atomic<int> executed = 0;
+    {
+        ds::ThreadPool pool(4);
+        EXPECT_EQ(pool.size(), 4);
+        for (int i = 0; i < NUM_TASKS; i++) {
+            pool.submit([&executed] { executed++; });
+        }
+    }
+    EXPECT_EQ(executed, NUM_TASKS) << "Destroying the pool should run every queued task";
+}
+
+TEST(ThreadPoolTest, ParallelForCoversEveryIndexOnce) {
+    constexpr int COUNT = 100000;
+
+    ds::ThreadPool pool(4);
+    std::vector<int> visits(COUNT, 0);
+    pool.parallel_for(COUNT, 100, [&visits](ds::ThreadPool::size_type begin, ds::ThreadPool::size_type end) {
+        EXPECT_GE(end - begin, 100) << "Chunks should hold at least grain indices";
+        for (auto i = begin; i < end; i++) {
+            visits[i]++;
+        }
+    });
+
+    for (int i = 0; i < COUNT; i++) {
+        ASSERT_EQ(visits[i], 1);
+    }
+}
+
+TEST(ThreadPoolTest, NestedParallelFor) {
+    constexpr int OUTER = 16;
+    constexpr int INNER = 1000;
+
+    ds::ThreadPool pool(2);
+    std::atomic<int> total = 0;
+    pool.parallel_for(OUTER, 1, [&](ds::ThreadPool::size_type begin, ds::ThreadPool::size_type end) {
+        for (auto i = begin; i < end; i++) {
+            pool.parallel_for(INNER, 10, [&total](ds::ThreadPool::size_type inner_begin, ds::ThreadPool::size_type inner_end) {
+                total += static_cast<int>(inner_end - inner_begin);
+            });
+        }
+    });
+    EXPECT_EQ(total, OUTER * INNER) << "Tasks waiting on nested work should help instead of deadlocking";
+}
+
+TEST(ThreadPoolTest, ParallelForRethrows) {
+    ds::ThreadPool pool(4);
+    std::atomic<int> chunks = 0;
+    EXPECT_THROW(pool.parallel_for(1000, 1, [&chunks](ds::ThreadPool::size_type begin, ds::ThreadPool::size_type) {
+        chunks++;
+        if (begin == 0) {
+            throw std::runtime_error("first chunk failed");
+        }
+    }),
+                 std::runtime_error);
+    EXPECT_GT(chunks, 1) << "The other chunks should still run";
+}
+
+TEST(ThreadPoolTest, WaitingCallerRunsNestedWork) {
+    ds::ThreadPool pool(1);
+    const auto caller = std::this_thread::get_id();
+    std::atomic<bool> started = false;
+    std::mutex mutex;
+    std::vector<std::thread::id> inner_threads;
+    pool.parallel_for(2, 1, [&](ds::ThreadPool::size_type begin, ds::ThreadPool::size_type) {
+        if (begin == 0) {
+            // Leave the second chunk to the worker
+            while (not started) {
+                std::this_thread::yield();
+            }
+            return;
+        }
+
+        started = true;
+        // By now the caller has run out of queued tasks and gone to sleep
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        pool.parallel_for(8, 1, [&](ds::ThreadPool::size_type, ds::ThreadPool::size_type) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            const std::lock_guard lock(mutex);
+            inner_threads.push_back(std::this_thread::get_id());
+        });
+    });
+
+    ASSERT_EQ(inner_threads.size(), 8);
+    EXPECT_NE(std::find(inner_threads.begin(), inner_threads.end(), caller), inner_threads.end())
+            << "The caller should run nested chunks while waiting instead of sleeping";
+}
@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <string>
 
+#include <malloc_allocator.hpp>
 #include <vector.hpp>
 
 TEST(VectorTest, Constructor) {
@@ -342,4 +346,320 @@ TEST(VectorTest, Assign) {
             EXPECT_EQ(init_empty_vector[i], data(list)[i]) << "Value should be " << data(list)[i];
         }
     }
-}
\ No newline at end of file
+}
+
+namespace {
+    struct Tracked {
+        static inline int alive = 0;
+
+        explicit Tracked(int v) : value(v) { alive++; }
+
+        Tracked(const Tracked &other) : value(other.value) { alive++; }
+
+        Tracked &operator=(const Tracked &) = default;
+
+        ~Tracked() { alive--; }
+
+        bool operator==(const Tracked &) const = default;
+
+        int value;
+    };
+
+    template<typename T>
+    struct CountingAllocator {
+        using value_type = T;
+
+        CountingAllocator() = default;
+
+        template<typename U>
+        explicit CountingAllocator(const CountingAllocator<U> &) {}
+
+        T *allocate(std::size_t n) {
+            allocations++;
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T *p, std::size_t n) {
+            deallocations++;
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        bool operator==(const CountingAllocator &) const = default;
+
+        static inline int allocations = 0;
+        static inline int deallocations = 0;
+    };
+
+    template<bool NoexceptMove>
+    struct MoveCounter {
+        static inline int copies = 0;
+        static inline int moves = 0;
+
+        MoveCounter() = default;
+
+        MoveCounter(const MoveCounter &) { copies++; }
+
+        MoveCounter(MoveCounter &&) noexcept(NoexceptMove) { moves++; }
+
+        MoveCounter &operator=(const MoveCounter &) = default;
+
+        MoveCounter &operator=(MoveCounter &&) noexcept = default;
+
+        ~MoveCounter() = default;
+    };
+
+    // Owns heap memory, but relocating it bitwise is safe
+    struct OwningBox {
+        explicit OwningBox(int v) : ptr(new int(v)) {}
+
+        OwningBox(const OwningBox &other) : ptr(new int(*other.ptr)) {}
+
+        OwningBox &operator=(const OwningBox &) = delete;
+
+        ~OwningBox() { delete ptr; }
+
+        int *ptr;
+    };
+} // namespace
+
+template<>
+struct ds::is_trivially_relocatable<OwningBox> : std::true_type {};
+
+TEST(VectorTest, ReserveDoesNotConstruct) {
+    constexpr int CAPACITY = 1000;
+    constexpr int NUM_PUSHS = 10;
+
+    {
+        ds::Vector<Tracked> v;
+        v.reserve(CAPACITY);
+        EXPECT_EQ(Tracked::alive, 0) << "Reserving should not construct any element";
+
+        for (int i = 0; i < NUM_PUSHS; i++) {
+            v.push_back(Tracked(i));
+        }
+        EXPECT_EQ(Tracked::alive, NUM_PUSHS) << "Only pushed elements should be alive";
+
+        v.pop_back();
+        EXPECT_EQ(Tracked::alive, NUM_PUSHS - 1) << "pop_back should destroy the last element";
+
+        v.shrink_to_fit();
+        EXPECT_EQ(Tracked::alive, NUM_PUSHS - 1) << "Reallocation should not leak elements";
+        for (int i = 0; i < NUM_PUSHS - 1; i++) {
+            EXPECT_EQ(v[i].value, i) << "Value should be " << i;
+        }
+
+        v.clear();
+        EXPECT_EQ(Tracked::alive, 0) << "clear should destroy all elements";
+
+        v.assign(NUM_PUSHS, Tracked(1));
+        EXPECT_EQ(Tracked::alive, NUM_PUSHS);
+    }
+
+    EXPECT_EQ(Tracked::alive, 0) << "Destructor should destroy all elements";
+}
+
+TEST(VectorTest, CustomAllocator) {
+    constexpr int NUM_PUSHS = 100;
+
+    {
+        ds::Vector<int, CountingAllocator<int>> v;
+        for (int i = 0; i < NUM_PUSHS; i++) {
+            v.push_back(i);
+        }
+        EXPECT_GT(CountingAllocator<int>::allocations, 0) << "Vector should allocate through its allocator";
+
+        ds::Vector<int, CountingAllocator<int>> copy(v);
+        EXPECT_EQ(copy, v);
+
+        ds::Vector<int, CountingAllocator<int>> moved(std::move(copy));
+        EXPECT_EQ(moved, v);
+    }
+
+    EXPECT_EQ(CountingAllocator<int>::allocations, CountingAllocator<int>::deallocations)
+            << "Every allocation should be released";
+}
+
+TEST(VectorTest, GrowthMovesElements) {
+    constexpr int NUM_PUSHS = 100;
+
+    {
+        ds::Vector<MoveCounter<true>> v(NUM_PUSHS);
+        MoveCounter<true>::copies = 0;
+        v.reserve(v.capacity() * 2);
+        EXPECT_EQ(MoveCounter<true>::copies, 0) << "Growth should not copy when move is noexcept";
+        EXPECT_EQ(MoveCounter<true>::moves, NUM_PUSHS) << "Growth should move every element";
+    }
+
+    {
+        ds::Vector<MoveCounter<false>> v(NUM_PUSHS);
+        MoveCounter<false>::moves = 0;
+        v.reserve(v.capacity() * 2);
+        EXPECT_EQ(MoveCounter<false>::moves, 0) << "Growth should not use a throwing move";
+        EXPECT_EQ(MoveCounter<false>::copies, NUM_PUSHS) << "Growth should fall back to copies";
+    }
+
+    ds::Vector<std::string> strings;
+    for (int i = 0; i < NUM_PUSHS; i++) {
+        strings.push_back(std::string(NUM_PUSHS, 'a') + std::to_string(i));
+    }
+    for (int i = 0; i < NUM_PUSHS; i++) {
+        EXPECT_EQ(strings[i], std::string(NUM_PUSHS, 'a') + std::to_string(i));
+    }
+}
+
+TEST(VectorTest, GrowthRelocatesTriviallyRelocatable) {
+    constexpr int NUM_PUSHS = 100;
+
+    ds::Vector<OwningBox> boxes;
+    for (int i = 0; i < NUM_PUSHS; i++) {
+        boxes.push_back(OwningBox(i));
+    }
+    for (int i = 0; i < NUM_PUSHS; i++) {
+        EXPECT_EQ(*boxes[i].ptr, i) << "Relocated box should keep its value";
+    }
+
+    ds::Vector<int, ds::MallocAllocator<int>> reallocated;
+    for (int i = 0; i < NUM_PUSHS; i++) {
+        reallocated.push_back(i);
+    }
+    reallocated.shrink_to_fit();
+    EXPECT_EQ(reallocated.capacity(), NUM_PUSHS);
+    for (int i = 0; i < NUM_PUSHS; i++) {
+        EXPECT_EQ(reallocated[i], i) << "realloc should preserve values";
+    }
+}
+
+TEST(VectorTest, EmplaceBack) {
+    constexpr int NUM_PUSHS = 100;
+
+    ds::Vector<std::pair<int, std::string>> v;
+    for (int i = 0; i < NUM_PUSHS; i++) {
+        auto &inserted = v.emplace_back(i, std::to_string(i));
+        EXPECT_EQ(inserted.first, i) << "emplace_back should return the new element";
+    }
+    EXPECT_EQ(v.size(), NUM_PUSHS) << "Expected size " << NUM_PUSHS;
+
+    ds::Vector<std::string> strings;
+    std::string moved_from(NUM_PUSHS, 'a');
+    strings.push_back(std::move(moved_from));
+    EXPECT_EQ(strings[0], std::string(NUM_PUSHS, 'a'));
+
+    // Growing while pushing an element of the same vector must not read freed memory
+    ds::Vector<std::string> self_referencing = {"a"};
+    for (int i = 0; i < NUM_PUSHS; i++) {
+        self_referencing.push_back(self_referencing[0]);
+    }
+    for (const auto &s: self_referencing) {
+        EXPECT_EQ(s, "a");
+    }
+}
+
+TEST(VectorTest, Insert) {
+    {
+        ds::Vector<int> v = {0, 1, 4, 5};
+        const auto it = v.insert(v.begin() + 2, {2, 3});
+        EXPECT_EQ(*it, 2) << "insert should return an iterator to the first inserted element";
+        EXPECT_EQ(v, ds::Vector<int>({0, 1, 2, 3, 4, 5}));
+
+        v.insert(v.begin(), -1);
+        v.insert(v.end(), 6);
+        EXPECT_EQ(v, ds::Vector<int>({-1, 0, 1, 2, 3, 4, 5, 6}));
+
+        v.insert(v.begin() + 1, 3, 7);
+        EXPECT_EQ(v, ds::Vector<int>({-1, 7, 7, 7, 0, 1, 2, 3, 4, 5, 6}));
+
+        v.insert(v.begin(), v[3]);
+        EXPECT_EQ(v.front(), 7) << "Inserting an element of the same vector should copy it first";
+    }
+
+    {
+        ds::Vector<std::string> v = {"a", "d"};
+        const ds::Vector<std::string> middle = {"b", "c"};
+        v.insert(v.begin() + 1, middle.cbegin(), middle.cend());
+        EXPECT_EQ(v, ds::Vector<std::string>({"a", "b", "c", "d"}));
+
+        v.emplace(v.begin() + 2, 3, 'x');
+        EXPECT_EQ(v, ds::Vector<std::string>({"a", "b", "xxx", "c", "d"}));
+
+        std::istringstream stream("y z");
+        v.insert(v.begin(), std::istream_iterator<std::string>(stream), std::istream_iterator<std::string>());
+        EXPECT_EQ(v, ds::Vector<std::string>({"y", "z", "a", "b", "xxx", "c", "d"}));
+    }
+}
+
+TEST(VectorTest, Erase) {
+    {
+        ds::Vector<int> v = {0, 1, 2, 3, 4, 5};
+        auto it = v.erase(v.begin() + 1);
+        EXPECT_EQ(*it, 2) << "erase should return an iterator following the removed element";
+        EXPECT_EQ(v, ds::Vector<int>({0, 2, 3, 4, 5}));
+
+        it = v.erase(v.begin() + 1, v.begin() + 3);
+        EXPECT_EQ(*it, 4);
+        EXPECT_EQ(v, ds::Vector<int>({0, 4, 5}));
+
+        it = v.erase(v.begin(), v.end());
+        EXPECT_EQ(it, v.end());
+        EXPECT_TRUE(v.empty());
+    }
+
+    {
+        ds::Vector<Tracked> v;
+        for (int i = 0; i < 4; i++) {
+            v.emplace_back(i);
+        }
+        v.erase(v.begin(), v.begin() + 2);
+        EXPECT_EQ(Tracked::alive, 2) << "erase should destroy removed elements";
+        EXPECT_EQ(v[0].value, 2);
+        EXPECT_EQ(v[1].value, 3);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(VectorTest, Resize) {
+    ds::Vector<int> v = {0, 1, 2};
+
+    v.resize(5);
+    EXPECT_EQ(v, (ds::Vector<int>{0, 1, 2, 0, 0})) << "New elements should be value-initialized";
+
+    v.resize(2);
+    EXPECT_EQ(v, (ds::Vector<int>{0, 1}));
+
+    v.resize(4, 7);
+    EXPECT_EQ(v, (ds::Vector<int>{0, 1, 7, 7}));
+
+    ds::Vector<std::string> strings = {"a"};
+    strings.resize(100, strings[0]);
+    EXPECT_EQ(strings.size(), 100);
+    EXPECT_TRUE(std::all_of(strings.begin(), strings.end(), [](const auto &s) { return s == "a"; }))
+            << "Growing should copy the value before the element it refers to moves";
+}
+
+namespace {
+    constexpr auto squares_sum(int n) {
+        ds::Vector<int> v;
+        for (int i = 0; i < n; i++) {
+            v.push_back(i * i);
+        }
+        v.resize(v.size() + 1, 1000);
+
+        int sum = 0;
+        for (auto value: v) {
+            sum += value;
+        }
+        return sum;
+    }
+
+    constexpr auto edited_equals_literal() {
+        ds::Vector<int> v(3, 1);
+        v.insert(v.begin() + 1, 5);
+        v.erase(v.begin());
+        ds::Vector<int> copy(v);
+        return copy == ds::Vector<int>{5, 1, 1};
+    }
+} // namespace
+
+TEST(VectorTest, ConstantEvaluation) {
+    static_assert(squares_sum(100) == 328350 + 1000);
+    static_assert(edited_equals_literal());
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <list>
+#include <ranges>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <vector.hpp>
+#include <views.hpp>
+
+namespace {
+    template<typename T>
+    struct CountingAllocator {
+        using value_type = T;
+
+        CountingAllocator() = default;
+
+        template<typename U>
+        explicit CountingAllocator(const CountingAllocator<U> &) {}
+
+        T *allocate(std::size_t n) {
+            allocations++;
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T *p, std::size_t n) {
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        bool operator==(const CountingAllocator &) const = default;
+
+        static inline int allocations = 0;
+    };
+
+    auto iota_vector(int size) {
+        ds::Vector<int> values;
+        for (int i = 0; i < size; i++) {
+            values.push_back(i);
+        }
+        return values;
+    }
+} // namespace
+
+TEST(ViewsTest, Pipeline) {
+    const auto values = iota_vector(10);
+
+    const auto result = values | ds::views::filter([](int v) { return v % 2 == 0; }) |
+                        ds::views::map([](int v) { return v * v; }) | ds::views::drop(1) | ds::views::take(3) |
+                        ds::views::collect();
+    EXPECT_EQ(result, (ds::Vector<int>{4, 16, 36}));
+
+    const auto strings = values | ds::views::map([](int v) { return std::to_string(v); }) | ds::views::take(2) |
+                         ds::views::collect<std::vector<std::string>>();
+    EXPECT_EQ(strings, (std::vector<std::string>{"0", "1"}));
+}
+
+TEST(ViewsTest, CollectReservesOnce) {
+    using Counted = ds::Vector<int, CountingAllocator<int>>;
+    const auto values = iota_vector(1000);
+
+    CountingAllocator<int>::allocations = 0;
+    const auto doubled = values | ds::views::map([](int v) { return 2 * v; }) | ds::views::collect<Counted>();
+    EXPECT_EQ(doubled.size(), 1000);
+    EXPECT_EQ(doubled[999], 1998);
+    EXPECT_EQ(CountingAllocator<int>::allocations, 1) << "A sized pipeline should allocate its result once";
+}
+
+TEST(ViewsTest, Zip) {
+    ds::Vector<int> ids = {1, 2, 3, 4};
+    const ds::Vector<std::string> names = {"a", "b", "c"};
+
+    auto zipped = ds::views::zip(ids, names);
+    static_assert(std::ranges::random_access_range<decltype(zipped)>);
+    static_assert(std::ranges::common_range<decltype(zipped)>);
+    EXPECT_EQ(zipped.size(), 3) << "Zip should stop at the shortest range";
+
+    for (auto [id, name]: zipped) {
+        id *= 10;
+    }
+    EXPECT_EQ(ids, (ds::Vector<int>{10, 20, 30, 4})) << "Elements should be references into the ranges";
+
+    const auto pairs = zipped | ds::views::collect();
+    ASSERT_EQ(pairs.size(), 3);
+    EXPECT_EQ(pairs[2], std::make_tuple(30, std::string("c")));
+    EXPECT_EQ(std::get<1>(*(zipped.end() - 1)), "c");
+
+    std::list<int> list = {7, 8};
+    auto mixed = ds::views::zip(list, ids);
+    static_assert(std::ranges::bidirectional_range<decltype(mixed)>);
+    EXPECT_EQ(std::ranges::distance(mixed), 2);
+}
+
+TEST(ViewsTest, Enumerate) {
+    const ds::Vector<std::string> names = {"a", "b", "c"};
+
+    types::size_t expected = 0;
+    for (const auto &[index, name]: names | ds::views::enumerate) {
+        EXPECT_EQ(index, expected);
+        EXPECT_EQ(name, names[expected]);
+        expected++;
+    }
+    EXPECT_EQ(expected, names.size());
+
+    auto reversed = ds::views::enumerate(names) | std::views::reverse;
+    EXPECT_EQ(std::get<0>(*reversed.begin()), 2) << "Enumerate should compose with std::views";
+
+    const auto values = iota_vector(10);
+    auto odd = values | ds::views::filter([](int v) { return v % 2 == 1; }) | ds::views::enumerate;
+    const auto positions = odd | ds::views::map([](auto pair) { return std::get<0>(pair) * 100 + std::get<1>(pair); }) | ds::views::collect();
+    EXPECT_EQ(positions, (ds::Vector<types::size_t>{1, 103, 205, 307, 409}));
+}
+
+TEST(ViewsTest, Chunk) {
+    const auto values = iota_vector(10);
+
+    auto chunks = values | ds::views::chunk(4);
+    EXPECT_EQ(chunks.size(), 3);
+
+    ds::Vector<int> sums;
+    for (auto chunk: chunks) {
+        int sum = 0;
+        for (int v: chunk) {
+            sum += v;
+        }
+        sums.push_back(sum);
+    }
+    EXPECT_EQ(sums, (ds::Vector<int>{6, 22, 17}));
+
+    const auto sizes = chunks | ds::views::map([](auto chunk) { return chunk.size(); }) | ds::views::collect();
+    EXPECT_EQ(sizes, (ds::Vector<std::size_t>{4, 4, 2}));
+    EXPECT_THROW(values | ds::views::chunk(0), std::invalid_argument);
+}